@@ -12,6 +12,8 @@
 #include "emuopts.h"
 #include "audit.h"
 #include "harddisk.h"
+#include "unzip.h"
+#include "un7z.h"
 #include "sound/samples.h"
 
 
@@ -25,6 +27,27 @@
 
 media_auditor::media_auditor(const driver_enumerator &enumerator)
 	: m_enumerator(enumerator),
+		m_driver(NULL),
+		m_configs(NULL),
+		m_validation(AUDIT_VALIDATE_FULL),
+		m_searchpath(NULL)
+{
+}
+
+
+//-------------------------------------------------
+//  media_auditor - constructor for an auditor
+//  bound to a single driver whose configuration
+//  and those of its parents have already been
+//  built; such an auditor never touches the
+//  enumerator's config cache, so it can be used
+//  from a worker thread
+//-------------------------------------------------
+
+media_auditor::media_auditor(const driver_enumerator &enumerator, const game_driver &driver, machine_config * const *configs)
+	: m_enumerator(enumerator),
+		m_driver(&driver),
+		m_configs(configs),
 		m_validation(AUDIT_VALIDATE_FULL),
 		m_searchpath(NULL)
 {
@@ -46,7 +69,7 @@ media_auditor::summary media_auditor::audit_media(const char *validation)
 
 // temporary hack until romload is update: get the driver path and support it for
 // all searches
-const char *driverpath = m_enumerator.config().root_device().searchpath();
+const char *driverpath = config().root_device().searchpath();
 
 	int found = 0;
 	int required = 0;
@@ -54,7 +77,7 @@ const char *driverpath = m_enumerator.config().root_device().searchpath();
 	int shared_required = 0;
 
 	// iterate over devices and regions
-	device_iterator deviter(m_enumerator.config().root_device());
+	device_iterator deviter(config().root_device());
 	for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
 	{
 		// determine the search path for this source and iterate through the regions
@@ -116,7 +139,7 @@ m_searchpath = combinedpath;
 	}
 
 	// return a summary
-	return summarize(m_enumerator.driver().name);
+	return summarize(driver().name);
 }
 
 
@@ -263,11 +286,11 @@ media_auditor::summary media_auditor::audit_samples()
 	int found = 0;
 
 	// iterate over sample entries
-	samples_device_iterator iter(m_enumerator.config().root_device());
+	samples_device_iterator iter(config().root_device());
 	for (samples_device *device = iter.first(); device != NULL; device = iter.next())
 	{
 		// by default we just search using the driver name
-		astring searchpath(m_enumerator.driver().name);
+		astring searchpath(driver().name);
 
 		// add the alternate path if present
 		samples_iterator iter(*device);
@@ -311,7 +334,7 @@ media_auditor::summary media_auditor::audit_samples()
 	}
 
 	// return a summary
-	return summarize(m_enumerator.driver().name);
+	return summarize(driver().name);
 }
 
 
@@ -456,7 +479,7 @@ audit_record *media_auditor::audit_one_disk(const rom_entry *rom, const char *lo
 
 	// open the disk
 	chd_file source;
-	chd_error err = chd_error(open_disk_image(m_enumerator.options(), &m_enumerator.driver(), rom, source, locationtag));
+	chd_error err = chd_error(open_disk_image(m_enumerator.options(), &driver(), rom, source, locationtag));
 
 	// if we succeeded, get the hashes
 	if (err == CHDERR_NONE)
@@ -550,10 +573,17 @@ device_t *media_auditor::find_shared_device(device_t &device, const char *name,
 	}
 	else
 	{
-		// iterate up the parent chain
-		for (int drvindex = m_enumerator.find(m_enumerator.driver().parent); drvindex != -1; drvindex = m_enumerator.find(m_enumerator.driver(drvindex).parent))
+		// iterate up the parent chain, using our own configs if we are bound to a driver
+		int level = 1;
+		for (int drvindex = m_enumerator.find(driver().parent); drvindex != -1; drvindex = m_enumerator.find(m_enumerator.driver(drvindex).parent), level++)
 		{
-			device_iterator deviter(m_enumerator.config(drvindex).root_device());
+			machine_config *parentconfig;
+			if (m_driver == NULL)
+				parentconfig = &m_enumerator.config(drvindex);
+			else if ((parentconfig = m_configs[level]) == NULL)
+				break;
+
+			device_iterator deviter(parentconfig->root_device());
 			for (device_t *scandevice = deviter.first(); scandevice != NULL; scandevice = deviter.next())
 				for (const rom_entry *region = rom_first_region(*scandevice); region; region = rom_next_region(region))
 					for (const rom_entry *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
@@ -570,6 +600,217 @@ device_t *media_auditor::find_shared_device(device_t &device, const char *name,
 }
 
 
+
+//**************************************************************************
+//  AUDIT QUEUE
+//**************************************************************************
+
+//-------------------------------------------------
+//  media_audit_queue - constructor
+//-------------------------------------------------
+
+media_audit_queue::media_audit_queue(const driver_enumerator &enumerator, const char *validation)
+	: m_enumerator(enumerator),
+		m_validation(validation),
+		m_work_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO | WORK_QUEUE_FLAG_MULTI)),
+		m_first(0),
+		m_count(0)
+{
+	for (int itemnum = 0; itemnum < ARRAY_LENGTH(m_items); itemnum++)
+	{
+		m_items[itemnum].m_queue = this;
+		m_items[itemnum].m_osd = NULL;
+	}
+
+	// the workers share opened archives
+	zip_file_cache_share();
+	_7z_file_cache_share();
+}
+
+
+//-------------------------------------------------
+//  ~media_audit_queue - destructor
+//-------------------------------------------------
+
+media_audit_queue::~media_audit_queue()
+{
+	// drain anything still in flight
+	astring summary_string;
+	int drvindex;
+	while (!empty())
+		wait(summary_string, drvindex);
+
+	if (m_work_queue != NULL)
+		osd_work_queue_free(m_work_queue);
+
+	zip_file_cache_unshare();
+	_7z_file_cache_unshare();
+}
+
+
+//-------------------------------------------------
+//  queue_media - queue an audit of the ROMs and
+//  disks of the given driver
+//-------------------------------------------------
+
+void media_audit_queue::queue_media(int drvindex)
+{
+	audit_item &item = queue_item(AUDIT_MEDIA, drvindex);
+
+	// build the configs of the driver and its parents up front, since the
+	// enumerator's config cache can't be touched from the workers
+	const game_driver *driver = &driver_list::driver(drvindex);
+	item.m_configs.append(global_alloc(machine_config(*driver, m_enumerator.options())));
+	for (int parent = driver_list::find(driver->parent); parent != -1; parent = driver_list::find(driver->parent))
+	{
+		driver = &driver_list::driver(parent);
+		item.m_configs.append(global_alloc(machine_config(*driver, m_enumerator.options())));
+	}
+	item.m_configs.append(NULL);
+
+	item.m_osd = osd_work_item_queue(m_work_queue, audit_item_static, &item, 0);
+}
+
+
+//-------------------------------------------------
+//  queue_samples - queue an audit of the samples
+//  of the given driver
+//-------------------------------------------------
+
+void media_audit_queue::queue_samples(int drvindex)
+{
+	audit_item &item = queue_item(AUDIT_SAMPLES, drvindex);
+	item.m_configs.append(global_alloc(machine_config(driver_list::driver(drvindex), m_enumerator.options())));
+	item.m_configs.append(NULL);
+	item.m_osd = osd_work_item_queue(m_work_queue, audit_item_static, &item, 0);
+}
+
+
+//-------------------------------------------------
+//  queue_software - queue an audit of a software
+//  list entry on behalf of the given driver
+//-------------------------------------------------
+
+void media_audit_queue::queue_software(int drvindex, const char *listname, software_info *swinfo)
+{
+	audit_item &item = queue_item(AUDIT_SOFTWARE, drvindex);
+	item.m_listname = listname;
+	item.m_swinfo = swinfo;
+	item.m_configs.append(NULL);
+	item.m_osd = osd_work_item_queue(m_work_queue, audit_item_static, &item, 0);
+}
+
+
+//-------------------------------------------------
+//  wait - wait for the oldest audit to complete
+//  and return its results
+//-------------------------------------------------
+
+media_auditor::summary media_audit_queue::wait(astring &summary_string, int &drvindex)
+{
+	audit_item &item = wait_item();
+	summary_string.cpy(item.m_string);
+	drvindex = item.m_drvindex;
+	return item.m_summary;
+}
+
+media_auditor::summary media_audit_queue::wait(astring &summary_string, const char *&listname, software_info *&swinfo)
+{
+	audit_item &item = wait_item();
+	summary_string.cpy(item.m_string);
+	listname = item.m_listname;
+	swinfo = item.m_swinfo;
+	return item.m_summary;
+}
+
+
+//-------------------------------------------------
+//  queue_item - claim the next free slot in the
+//  ring of in-flight audits
+//-------------------------------------------------
+
+media_audit_queue::audit_item &media_audit_queue::queue_item(audit_type type, int drvindex)
+{
+	assert(!full());
+	audit_item &item = m_items[(m_first + m_count++) % ARRAY_LENGTH(m_items)];
+	item.m_type = type;
+	item.m_drvindex = drvindex;
+	item.m_configs.resize(0);
+	item.m_listname = NULL;
+	item.m_swinfo = NULL;
+	item.m_summary = media_auditor::NOTFOUND;
+	item.m_string.reset();
+	return item;
+}
+
+
+//-------------------------------------------------
+//  wait_item - retire the oldest in-flight audit,
+//  waiting for it to complete if necessary
+//-------------------------------------------------
+
+media_audit_queue::audit_item &media_audit_queue::wait_item()
+{
+	assert(!empty());
+	audit_item &item = m_items[m_first];
+	m_first = (m_first + 1) % ARRAY_LENGTH(m_items);
+	m_count--;
+
+	// if the OSD couldn't queue the work, do it ourselves
+	if (item.m_osd != NULL)
+	{
+		osd_work_item_wait(item.m_osd, 100 * osd_ticks_per_second());
+		osd_work_item_release(item.m_osd);
+		item.m_osd = NULL;
+	}
+	else
+		audit_item_static(&item, 0);
+
+	// free the configs now that nobody is looking at them
+	for (int level = 0; item.m_configs[level] != NULL; level++)
+		global_free(item.m_configs[level]);
+	item.m_configs.resize(0);
+	return item;
+}
+
+
+//-------------------------------------------------
+//  audit_item_static - perform a single audit;
+//  runs on a worker thread
+//-------------------------------------------------
+
+void *media_audit_queue::audit_item_static(void *param, int threadid)
+{
+	audit_item &item = *reinterpret_cast<audit_item *>(param);
+	media_audit_queue &queue = *item.m_queue;
+	const game_driver &driver = driver_list::driver(item.m_drvindex);
+	media_auditor auditor(queue.m_enumerator, driver, item.m_configs);
+
+	switch (item.m_type)
+	{
+		case AUDIT_MEDIA:
+			item.m_summary = auditor.audit_media(queue.m_validation);
+			if (item.m_summary != media_auditor::NOTFOUND)
+				auditor.summarize(driver.name, &item.m_string);
+			break;
+
+		case AUDIT_SAMPLES:
+			item.m_summary = auditor.audit_samples();
+			if (item.m_summary != media_auditor::NOTFOUND)
+				auditor.summarize(driver.name, &item.m_string);
+			break;
+
+		case AUDIT_SOFTWARE:
+			item.m_summary = auditor.audit_software(item.m_listname, item.m_swinfo, queue.m_validation);
+			if (item.m_summary != media_auditor::NOTFOUND && item.m_summary != media_auditor::NONE_NEEDED)
+				auditor.summarize(item.m_swinfo->shortname, &item.m_string);
+			break;
+	}
+	return NULL;
+}
+
+
+
 //-------------------------------------------------
 //  audit_record - constructor
 //-------------------------------------------------
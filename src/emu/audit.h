@@ -139,6 +139,7 @@ public:
 
 	// construction/destruction
 	media_auditor(const driver_enumerator &enumerator);
+	media_auditor(const driver_enumerator &enumerator, const game_driver &driver, machine_config * const *configs);
 
 	// getters
 	audit_record *first() const { return m_record_list.first(); }
@@ -153,6 +154,8 @@ public:
 
 private:
 	// internal helpers
+	const game_driver &driver() const { return (m_driver != NULL) ? *m_driver : m_enumerator.driver(); }
+	machine_config &config() const { return (m_driver != NULL) ? *m_configs[0] : m_enumerator.config(); }
 	audit_record *audit_one_rom(const rom_entry *rom);
 	audit_record *audit_one_disk(const rom_entry *rom, const char *locationtag = NULL);
 	void compute_status(audit_record &record, const rom_entry *rom, bool found);
@@ -161,9 +164,73 @@ private:
 	// internal state
 	simple_list<audit_record>   m_record_list;
 	const driver_enumerator &   m_enumerator;
+	const game_driver *         m_driver;       // fixed driver, or NULL to follow the enumerator
+	machine_config * const *    m_configs;      // NULL-terminated configs of m_driver and its parents
 	const char *                m_validation;
 	const char *                m_searchpath;
 };
 
 
+// ======================> media_audit_queue
+
+// audits whole sets on a work queue, handing results back in the order they were queued
+class media_audit_queue
+{
+	DISABLE_COPYING(media_audit_queue);
+
+public:
+	// construction/destruction
+	media_audit_queue(const driver_enumerator &enumerator, const char *validation = AUDIT_VALIDATE_FULL);
+	~media_audit_queue();
+
+	// getters
+	bool empty() const { return m_count == 0; }
+	bool full() const { return m_count == ARRAY_LENGTH(m_items); }
+
+	// queue an audit; the queue must not be full
+	void queue_media(int drvindex);
+	void queue_samples(int drvindex);
+	void queue_software(int drvindex, const char *listname, software_info *swinfo);
+
+	// wait for the oldest audit and return its results
+	media_auditor::summary wait(astring &summary_string, int &drvindex);
+	media_auditor::summary wait(astring &summary_string, const char *&listname, software_info *&swinfo);
+
+private:
+	// an in-flight audit
+	enum audit_type
+	{
+		AUDIT_MEDIA,
+		AUDIT_SAMPLES,
+		AUDIT_SOFTWARE
+	};
+
+	struct audit_item
+	{
+		media_audit_queue *     m_queue;        // owning queue
+		osd_work_item *         m_osd;          // work item, or NULL if unused
+		audit_type              m_type;         // type of audit
+		int                     m_drvindex;     // index of the driver being audited
+		dynamic_array<machine_config *> m_configs; // NULL-terminated configs of the driver and its parents
+		const char *            m_listname;     // software list name, for software audits
+		software_info *         m_swinfo;       // software entry, for software audits
+		media_auditor::summary  m_summary;      // resulting summary
+		astring                 m_string;       // resulting summary text
+	};
+
+	// internal helpers
+	audit_item &queue_item(audit_type type, int drvindex);
+	audit_item &wait_item();
+	static void *audit_item_static(void *param, int threadid);
+
+	// internal state
+	const driver_enumerator &   m_enumerator;
+	const char *                m_validation;
+	osd_work_queue *            m_work_queue;
+	audit_item                  m_items[32];    // ring of in-flight audits
+	int                         m_first;        // index of the oldest in-flight audit
+	int                         m_count;        // number of in-flight audits
+};
+
+
 #endif  /* __AUDIT_H__ */
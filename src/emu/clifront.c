@@ -771,14 +771,24 @@ void cli_frontend::verifyroms(const char *gamename)
 	int notfound = 0;
 	int matched = 0;
 
-	// iterate over drivers
+	// iterate over drivers, auditing several at once but reporting in order
 	media_auditor auditor(drivlist);
-	while (drivlist.next())
+	media_audit_queue queue(drivlist, AUDIT_VALIDATE_FAST);
+	bool more = true;
+	while (true)
 	{
-		matched++;
+		// keep the queue topped up
+		while (more && !queue.full())
+			if ((more = drivlist.next()))
+				queue.queue_media(drivlist.current());
+		if (queue.empty())
+			break;
 
 		// audit the ROMs in this set
-		media_auditor::summary summary = auditor.audit_media(AUDIT_VALIDATE_FAST);
+		astring summary_string;
+		int drvindex;
+		media_auditor::summary summary = queue.wait(summary_string, drvindex);
+		matched++;
 
 		// if not found, count that and leave it at that
 		if (summary == media_auditor::NOTFOUND)
@@ -788,13 +798,11 @@ void cli_frontend::verifyroms(const char *gamename)
 		else
 		{
 			// output the summary of the audit
-			astring summary_string;
-			auditor.summarize(drivlist.driver().name,&summary_string);
 			mame_printf_info("%s", summary_string.cstr());
 
 			// output the name of the driver and its clone
-			mame_printf_info("romset %s ", drivlist.driver().name);
-			int clone_of = drivlist.clone();
+			mame_printf_info("romset %s ", drivlist.driver(drvindex).name);
+			int clone_of = drivlist.clone(drvindex);
 			if (clone_of != -1)
 				mame_printf_info("[%s] ", drivlist.driver(clone_of).name);
 
@@ -995,14 +1003,23 @@ void cli_frontend::verifysamples(const char *gamename)
 	int notfound = 0;
 	int matched = 0;
 
-	// iterate over drivers
-	media_auditor auditor(drivlist);
-	while (drivlist.next())
+	// iterate over drivers, auditing several at once but reporting in order
+	media_audit_queue queue(drivlist);
+	bool more = true;
+	while (true)
 	{
-		matched++;
+		// keep the queue topped up
+		while (more && !queue.full())
+			if ((more = drivlist.next()))
+				queue.queue_samples(drivlist.current());
+		if (queue.empty())
+			break;
 
 		// audit the samples in this set
-		media_auditor::summary summary = auditor.audit_samples();
+		astring summary_string;
+		int drvindex;
+		media_auditor::summary summary = queue.wait(summary_string, drvindex);
+		matched++;
 
 		// if not found, count that and leave it at that
 		if (summary == media_auditor::NOTFOUND)
@@ -1012,13 +1029,11 @@ void cli_frontend::verifysamples(const char *gamename)
 		else if (summary != media_auditor::NONE_NEEDED)
 		{
 			// output the summary of the audit
-			astring summary_string;
-			auditor.summarize(drivlist.driver().name,&summary_string);
 			mame_printf_info("%s", summary_string.cstr());
 
 			// output the name of the driver and its clone
-			mame_printf_info("sampleset %s ", drivlist.driver().name);
-			int clone_of = drivlist.clone();
+			mame_printf_info("sampleset %s ", drivlist.driver(drvindex).name);
+			int clone_of = drivlist.clone(drvindex);
 			if (clone_of != -1)
 				mame_printf_info("[%s] ", drivlist.driver(clone_of).name);
 
@@ -1309,6 +1324,56 @@ void cli_frontend::listsoftware(const char *gamename)
 }
 
 
+/*-------------------------------------------------
+    report_software_audit - display the result of
+    the oldest software audit in the queue
+-------------------------------------------------*/
+
+static void report_software_audit(media_audit_queue &queue, int &correct, int &incorrect, int &notfound)
+{
+	astring summary_string;
+	const char *listname;
+	software_info *swinfo;
+	media_auditor::summary summary = queue.wait(summary_string, listname, swinfo);
+
+	// if not found, count that and leave it at that
+	if (summary == media_auditor::NOTFOUND)
+	{
+		notfound++;
+	}
+	// else display information about what we discovered
+	else if(summary != media_auditor::NONE_NEEDED)
+	{
+		// output the summary of the audit
+		mame_printf_info("%s", summary_string.cstr());
+
+		// display information about what we discovered
+		mame_printf_info("romset %s:%s ", listname, swinfo->shortname);
+
+		// switch off of the result
+		switch (summary)
+		{
+			case media_auditor::INCORRECT:
+				mame_printf_info("is bad\n");
+				incorrect++;
+				break;
+
+			case media_auditor::CORRECT:
+				mame_printf_info("is good\n");
+				correct++;
+				break;
+
+			case media_auditor::BEST_AVAILABLE:
+				mame_printf_info("is best available\n");
+				correct++;
+				break;
+
+			default:
+				break;
+		}
+	}
+}
+
 /*-------------------------------------------------
     verifysoftware - verify roms from the software
     list of the specified driver(s)
@@ -1330,7 +1395,6 @@ void cli_frontend::verifysoftware(const char *gamename)
 		throw emu_fatalerror(MAMERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 	}
 
-	media_auditor auditor(drivlist);
 	while (drivlist.next())
 	{
 		matched++;
@@ -1352,49 +1416,16 @@ void cli_frontend::verifysoftware(const char *gamename)
 						// Get the actual software list contents
 						software_list_parse( list, NULL, NULL );
 
+						// audit several entries at once, but report them in order
+						media_audit_queue queue(drivlist, AUDIT_VALIDATE_FAST);
 						for ( software_info *swinfo = software_list_find( list, "*", NULL ); swinfo != NULL; swinfo = software_list_find( list, "*", swinfo ) )
 						{
-							media_auditor::summary summary = auditor.audit_software(swlist->list_name(), swinfo, AUDIT_VALIDATE_FAST);
-
-							// if not found, count that and leave it at that
-							if (summary == media_auditor::NOTFOUND)
-							{
-								notfound++;
-							}
-							// else display information about what we discovered
-							else if(summary != media_auditor::NONE_NEEDED)
-							{
-								// output the summary of the audit
-								astring summary_string;
-								auditor.summarize(swinfo->shortname,&summary_string);
-								mame_printf_info("%s", summary_string.cstr());
-
-								// display information about what we discovered
-								mame_printf_info("romset %s:%s ", swlist->list_name(), swinfo->shortname);
-
-								// switch off of the result
-								switch (summary)
-								{
-									case media_auditor::INCORRECT:
-										mame_printf_info("is bad\n");
-										incorrect++;
-										break;
-
-									case media_auditor::CORRECT:
-										mame_printf_info("is good\n");
-										correct++;
-										break;
-
-									case media_auditor::BEST_AVAILABLE:
-										mame_printf_info("is best available\n");
-										correct++;
-										break;
-
-									default:
-										break;
-								}
-							}
+							if (queue.full())
+								report_software_audit(queue, correct, incorrect, notfound);
+							queue.queue_software(drivlist.current(), swlist->list_name(), swinfo);
 						}
+						while (!queue.empty())
+							report_software_audit(queue, correct, incorrect, notfound);
 					}
 
 					software_list_close( list );
@@ -1473,7 +1504,6 @@ void cli_frontend::verifysoftlist(const char *gamename)
 	int matched = 0;
 
 	driver_enumerator drivlist(m_options);
-	media_auditor auditor(drivlist);
 
 	while (drivlist.next())
 	{
@@ -1490,49 +1520,16 @@ void cli_frontend::verifysoftlist(const char *gamename)
 					// Get the actual software list contents
 					software_list_parse( list, NULL, NULL );
 
+					// audit several entries at once, but report them in order
+					media_audit_queue queue(drivlist, AUDIT_VALIDATE_FAST);
 					for ( software_info *swinfo = software_list_find( list, "*", NULL ); swinfo != NULL; swinfo = software_list_find( list, "*", swinfo ) )
 					{
-						media_auditor::summary summary = auditor.audit_software(swlist->list_name(), swinfo, AUDIT_VALIDATE_FAST);
-
-						// if not found, count that and leave it at that
-						if (summary == media_auditor::NOTFOUND)
-						{
-							notfound++;
-						}
-						// else display information about what we discovered
-						else if(summary != media_auditor::NONE_NEEDED)
-						{
-							// output the summary of the audit
-							astring summary_string;
-							auditor.summarize(swinfo->shortname,&summary_string);
-							mame_printf_info("%s", summary_string.cstr());
-
-							// display information about what we discovered
-							mame_printf_info("romset %s:%s ", swlist->list_name(), swinfo->shortname);
-
-							// switch off of the result
-							switch (summary)
-							{
-								case media_auditor::INCORRECT:
-									mame_printf_info("is bad\n");
-									incorrect++;
-									break;
-
-								case media_auditor::CORRECT:
-									mame_printf_info("is good\n");
-									correct++;
-									break;
-
-								case media_auditor::BEST_AVAILABLE:
-									mame_printf_info("is best available\n");
-									correct++;
-									break;
-
-								default:
-									break;
-							}
-						}
+						if (queue.full())
+							report_software_audit(queue, correct, incorrect, notfound);
+						queue.queue_software(drivlist.current(), swlist->list_name(), swinfo);
 					}
+					while (!queue.empty())
+						report_software_audit(queue, correct, incorrect, notfound);
 				}
 				software_list_close( list );
 			}
@@ -1718,6 +1715,395 @@ void cli_frontend::display_suggestions(const char *gamename)
 }
 
 
+//**************************************************************************
+//  MEDIA HASH INDEX
+//**************************************************************************
+
+const char media_hash_index::CACHE_MAGIC[8] = { 'M', 'A', 'M', 'E', 'H', 'I', 'X', '2' };
+const char media_hash_index::CACHE_NAME[] = "romident.idx";
+
+// sort key used while building the lookup tables
+struct hash_index_sort
+{
+	UINT8       m_key[20];
+	UINT32      m_index;
+};
+
+
+//-------------------------------------------------
+//  hash_index_sort_compare - compare two sort
+//  keys; ties are broken by entry index so that
+//  results come out in driver order
+//-------------------------------------------------
+
+static int CLIB_DECL hash_index_sort_compare(const void *item1, const void *item2)
+{
+	const hash_index_sort *key1 = reinterpret_cast<const hash_index_sort *>(item1);
+	const hash_index_sort *key2 = reinterpret_cast<const hash_index_sort *>(item2);
+	int result = memcmp(key1->m_key, key2->m_key, sizeof(key1->m_key));
+	if (result == 0)
+		result = (key1->m_index < key2->m_index) ? -1 : (key1->m_index > key2->m_index) ? 1 : 0;
+	return result;
+}
+
+
+//-------------------------------------------------
+//  hash_index_int_compare - compare two entry
+//  indexes
+//-------------------------------------------------
+
+static int CLIB_DECL hash_index_int_compare(const void *item1, const void *item2)
+{
+	return *reinterpret_cast<const int *>(item1) - *reinterpret_cast<const int *>(item2);
+}
+
+
+//-------------------------------------------------
+//  media_hash_index - constructor
+//-------------------------------------------------
+
+media_hash_index::media_hash_index(driver_enumerator &drivlist)
+	: m_drivlist(drivlist),
+		m_valid(false)
+{
+}
+
+
+//-------------------------------------------------
+//  find - look up all the ROMs matching the
+//  given hashes, returning their indexes in
+//  driver order
+//-------------------------------------------------
+
+int media_hash_index::find(const hash_collection &hashes, dynamic_array<int> &results)
+{
+	// load the index from disk, or build it from scratch if it is missing or stale
+	if (!m_valid)
+	{
+		if (!load())
+		{
+			build();
+			save();
+		}
+		m_valid = true;
+	}
+	results.reset();
+
+	// gather everything with a matching CRC
+	UINT32 crc;
+	if (hashes.crc(crc))
+	{
+		const UINT32 *table = crc_table();
+		UINT32 lo = 0, hi = header().m_crcs;
+		while (lo < hi)
+		{
+			UINT32 mid = (lo + hi) / 2;
+			if (entry(table[mid]).m_crc < crc)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		for ( ; lo < header().m_crcs && entry(table[lo]).m_crc == crc; lo++)
+			results.append(table[lo]);
+	}
+
+	// gather everything with a matching SHA1
+	sha1_t sha1;
+	if (hashes.sha1(sha1))
+	{
+		const UINT32 *table = sha1_table();
+		UINT32 lo = 0, hi = header().m_sha1s;
+		while (lo < hi)
+		{
+			UINT32 mid = (lo + hi) / 2;
+			if (memcmp(entry(table[mid]).m_sha1, sha1.m_raw, sizeof(sha1.m_raw)) < 0)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		for ( ; lo < header().m_sha1s && memcmp(entry(table[lo]).m_sha1, sha1.m_raw, sizeof(sha1.m_raw)) == 0; lo++)
+			results.append(table[lo]);
+	}
+
+	// put the candidates back in driver order, drop duplicates, and keep
+	// only those where every hash we both have agrees
+	qsort(results, results.count(), sizeof(int), hash_index_int_compare);
+	int count = 0;
+	for (int resnum = 0; resnum < results.count(); resnum++)
+		if (resnum == 0 || results[resnum] != results[resnum - 1])
+		{
+			const index_entry &cur = entry(results[resnum]);
+			hash_collection romhashes;
+			if (cur.m_flags & FLAG_CRC)
+				romhashes.add_crc(cur.m_crc);
+			if (cur.m_flags & FLAG_SHA1)
+			{
+				memcpy(sha1.m_raw, cur.m_sha1, sizeof(sha1.m_raw));
+				romhashes.add_sha1(sha1);
+			}
+			if (hashes == romhashes)
+				results[count++] = results[resnum];
+		}
+	results.resize(count, true);
+	return count;
+}
+
+
+//-------------------------------------------------
+//  build_key - build the string that ties a
+//  cached index to the build, hash path and
+//  software list files it was generated from
+//-------------------------------------------------
+
+void media_hash_index::build_key(astring &key, const char *lists)
+{
+	key.printf("%s;%d;%s", build_version, driver_list::total(), m_drivlist.options().hash_path());
+
+	// the OSD layer doesn't give us timestamps, so add the size and CRC of each
+	// list; a list that is missing now may turn up later, so note those too
+	astring name;
+	for (const char *scan = lists; *scan != 0; )
+	{
+		const char *end = strchr(scan, ' ');
+		if (end == NULL)
+			end = scan + strlen(scan);
+		name.cpy(scan, end - scan);
+		scan = (*end != 0) ? end + 1 : end;
+
+		emu_file file(m_drivlist.options().hash_path(), OPEN_FLAG_READ);
+		UINT32 crc;
+		if (file.open(name, ".xml") == FILERR_NONE && file.hashes(hash_collection::HASH_TYPES_CRC).crc(crc))
+			key.catprintf(";%s=%s:%08X", name.cstr(), core_i64_format(file.size(), 0, false), crc);
+		else
+			key.catprintf(";%s=missing", name.cstr());
+	}
+}
+
+
+//-------------------------------------------------
+//  load - try to load a cached index, returning
+//  false if it is missing, damaged or stale
+//-------------------------------------------------
+
+bool media_hash_index::load()
+{
+	emu_file file(m_drivlist.options().cfg_directory(), OPEN_FLAG_READ);
+	if (file.open(CACHE_NAME) != FILERR_NONE)
+		return false;
+
+	// read the whole thing; lookups work directly on the image
+	UINT64 size = file.size();
+	if (size < sizeof(index_header) || size > 0x7fffffff)
+		return false;
+	m_data.resize(size);
+	if (file.read(m_data, size) != size)
+		return false;
+
+	// validate the header against the file size
+	const index_header &hdr = header();
+	if (memcmp(hdr.m_magic, CACHE_MAGIC, sizeof(hdr.m_magic)) != 0)
+		return false;
+	UINT64 expected = sizeof(index_header) + UINT64(hdr.m_entries) * sizeof(index_entry) + (UINT64(hdr.m_crcs) + hdr.m_sha1s) * sizeof(UINT32) + hdr.m_strings;
+	if (expected != size || hdr.m_strings == 0 || m_data[size - 1] != 0 || hdr.m_key >= hdr.m_strings || hdr.m_lists >= hdr.m_strings)
+		return false;
+
+	// validate everything that gets used as an offset or index
+	for (UINT32 entnum = 0; entnum < hdr.m_entries; entnum++)
+	{
+		const index_entry &cur = entry(entnum);
+		if (cur.m_name >= hdr.m_strings || cur.m_owner >= hdr.m_strings || cur.m_description >= hdr.m_strings)
+			return false;
+	}
+	for (UINT32 tabnum = 0; tabnum < hdr.m_crcs + hdr.m_sha1s; tabnum++)
+		if (crc_table()[tabnum] >= hdr.m_entries)
+			return false;
+
+	// finally, make sure it was built by us from the same hash files
+	astring key;
+	build_key(key, string(hdr.m_lists));
+	return (strcmp(string(hdr.m_key), key) == 0);
+}
+
+
+//-------------------------------------------------
+//  build - walk every driver and software list
+//  and build a fresh index
+//-------------------------------------------------
+
+void media_hash_index::build()
+{
+	m_build_entries.reset();
+	m_build_strings.reset();
+	m_build_strings.append(0);
+
+	// iterate over drivers
+	tagmap_t<int> seenlists;
+	astring lists;
+	m_drivlist.reset();
+	while (m_drivlist.next())
+	{
+		// iterate over devices, regions and files within the region
+		UINT32 owner = add_string(m_drivlist.driver().name);
+		UINT32 description = add_string(m_drivlist.driver().description);
+		device_iterator deviter(m_drivlist.config().root_device());
+		for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
+			for (const rom_entry *region = rom_first_region(*device); region != NULL; region = rom_next_region(region))
+				for (const rom_entry *rom = rom_first_file(region); rom != NULL; rom = rom_next_file(rom))
+				{
+					hash_collection romhashes(ROM_GETHASHDATA(rom));
+					if (!romhashes.flag(hash_collection::FLAG_NO_DUMP))
+						add_rom(rom, 0, owner, description);
+				}
+
+		// next iterate over softlists; these are shared between drivers, so only add each once
+		software_list_device_iterator iter(m_drivlist.config().root_device());
+		for (const software_list_device *swlist = iter.first(); swlist != NULL; swlist = iter.next())
+		{
+			if (seenlists.add(swlist->list_name(), 1) == TMERR_DUPLICATE)
+				continue;
+			if (lists)
+				lists.cat(" ");
+			lists.cat(swlist->list_name());
+			software_list *list = software_list_open(m_drivlist.options(), swlist->list_name(), FALSE, NULL);
+
+			for (software_info *swinfo = software_list_find(list, "*", NULL); swinfo != NULL; swinfo = software_list_find(list, "*", swinfo))
+			{
+				astring swname(swlist->list_name(), ":", swinfo->shortname);
+				owner = add_string(swname);
+				description = add_string(swinfo->longname);
+				for (software_part *part = software_find_part(swinfo, NULL, NULL); part != NULL; part = software_part_next(part))
+					for (const rom_entry *region = part->romdata; region != NULL; region = rom_next_region(region))
+						for (const rom_entry *rom = rom_first_file(region); rom != NULL; rom = rom_next_file(rom))
+							add_rom(rom, FLAG_SOFTWARE, owner, description);
+			}
+			software_list_close(list);
+		}
+	}
+
+	// key it on the lists we just read
+	astring key;
+	build_key(key, lists);
+	UINT32 keyoffs = add_string(key);
+	UINT32 listsoffs = add_string(lists);
+
+	// sort the entries by CRC and by SHA1
+	int entries = m_build_entries.count();
+	dynamic_array<hash_index_sort> crcsort;
+	dynamic_array<hash_index_sort> sha1sort;
+	for (int entnum = 0; entnum < entries; entnum++)
+	{
+		const index_entry &cur = m_build_entries[entnum];
+		hash_index_sort item;
+		memset(&item, 0, sizeof(item));
+		item.m_index = entnum;
+		if (cur.m_flags & FLAG_CRC)
+		{
+			// store big-endian so that memcmp sorts numerically
+			item.m_key[0] = cur.m_crc >> 24;
+			item.m_key[1] = cur.m_crc >> 16;
+			item.m_key[2] = cur.m_crc >> 8;
+			item.m_key[3] = cur.m_crc >> 0;
+			crcsort.append(item);
+		}
+		if (cur.m_flags & FLAG_SHA1)
+		{
+			memcpy(item.m_key, cur.m_sha1, sizeof(item.m_key));
+			sha1sort.append(item);
+		}
+	}
+	qsort(crcsort, crcsort.count(), sizeof(hash_index_sort), hash_index_sort_compare);
+	qsort(sha1sort, sha1sort.count(), sizeof(hash_index_sort), hash_index_sort_compare);
+
+	// lay out the final image: header, entries, CRC table, SHA1 table, strings
+	UINT32 size = sizeof(index_header) + entries * sizeof(index_entry) + (crcsort.count() + sha1sort.count()) * sizeof(UINT32) + m_build_strings.count();
+	m_data.resize(size);
+	index_header &hdr = *reinterpret_cast<index_header *>(&m_data[0]);
+	memcpy(hdr.m_magic, CACHE_MAGIC, sizeof(hdr.m_magic));
+	hdr.m_key = keyoffs;
+	hdr.m_lists = listsoffs;
+	hdr.m_entries = entries;
+	hdr.m_crcs = crcsort.count();
+	hdr.m_sha1s = sha1sort.count();
+	hdr.m_strings = m_build_strings.count();
+
+	UINT8 *dest = &m_data[sizeof(index_header)];
+	if (entries != 0)
+		memcpy(dest, &m_build_entries[0], entries * sizeof(index_entry));
+	UINT32 *table = reinterpret_cast<UINT32 *>(dest + entries * sizeof(index_entry));
+	for (int itemnum = 0; itemnum < crcsort.count(); itemnum++)
+		*table++ = crcsort[itemnum].m_index;
+	for (int itemnum = 0; itemnum < sha1sort.count(); itemnum++)
+		*table++ = sha1sort[itemnum].m_index;
+	memcpy(table, &m_build_strings[0], m_build_strings.count());
+
+	// free the build-time data
+	m_build_entries.reset();
+	m_build_strings.reset();
+}
+
+
+//-------------------------------------------------
+//  save - write the index to the cache file;
+//  failure is not fatal, it just gets rebuilt
+//  next time
+//-------------------------------------------------
+
+void media_hash_index::save()
+{
+	emu_file file(m_drivlist.options().cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(CACHE_NAME) == FILERR_NONE)
+		file.write(m_data, m_data.count());
+}
+
+
+//-------------------------------------------------
+//  add_rom - add a ROM to the index being built
+//-------------------------------------------------
+
+void media_hash_index::add_rom(const rom_entry *rom, UINT32 flags, UINT32 owner, UINT32 description)
+{
+	hash_collection romhashes(ROM_GETHASHDATA(rom));
+	index_entry newentry;
+	memset(&newentry, 0, sizeof(newentry));
+	newentry.m_flags = flags;
+	if (romhashes.crc(newentry.m_crc))
+		newentry.m_flags |= FLAG_CRC;
+	sha1_t sha1;
+	if (romhashes.sha1(sha1))
+	{
+		memcpy(newentry.m_sha1, sha1.m_raw, sizeof(newentry.m_sha1));
+		newentry.m_flags |= FLAG_SHA1;
+	}
+	if (romhashes.flag(hash_collection::FLAG_BAD_DUMP))
+		newentry.m_flags |= FLAG_BAD_DUMP;
+
+	// without any hashes it can never be matched
+	if ((newentry.m_flags & (FLAG_CRC | FLAG_SHA1)) == 0)
+		return;
+
+	newentry.m_name = add_string(ROM_GETNAME(rom));
+	newentry.m_owner = owner;
+	newentry.m_description = description;
+	m_build_entries.append(newentry);
+}
+
+
+//-------------------------------------------------
+//  add_string - append a string to the string
+//  data being built and return its offset
+//-------------------------------------------------
+
+UINT32 media_hash_index::add_string(const char *string)
+{
+	UINT32 offset = m_build_strings.count();
+	do
+		m_build_strings.append(*string);
+	while (*string++ != 0);
+	return offset;
+}
+
+
+
 //**************************************************************************
 //  MEDIA IDENTIFIER
 //**************************************************************************
@@ -1728,6 +2114,7 @@ void cli_frontend::display_suggestions(const char *gamename)
 
 media_identifier::media_identifier(cli_options &options)
 	: m_drivlist(options),
+		m_index(m_drivlist),
 		m_total(0),
 		m_matches(0),
 		m_nonroms(0)
@@ -1966,56 +2353,20 @@ void media_identifier::identify_data(const char *name, const UINT8 *data, int le
 
 int media_identifier::find_by_hash(const hash_collection &hashes, int length)
 {
-	int found = 0;
+	// look up the hashes in the index
+	dynamic_array<int> results;
+	int found = m_index.find(hashes, results);
 
-	// iterate over drivers
-	m_drivlist.reset();
-	while (m_drivlist.next())
+	// output information about the matches
+	for (int resnum = 0; resnum < found; resnum++)
 	{
-		// iterate over devices, regions and files within the region */
-		device_iterator deviter(m_drivlist.config().root_device());
-		for (device_t *device = deviter.first(); device != NULL; device = deviter.next())
-			for (const rom_entry *region = rom_first_region(*device); region != NULL; region = rom_next_region(region))
-				for (const rom_entry *rom = rom_first_file(region); rom != NULL; rom = rom_next_file(rom))
-				{
-					hash_collection romhashes(ROM_GETHASHDATA(rom));
-					if (!romhashes.flag(hash_collection::FLAG_NO_DUMP) && hashes == romhashes)
-					{
-						bool baddump = romhashes.flag(hash_collection::FLAG_BAD_DUMP);
-
-						// output information about the match
-						if (found)
-							mame_printf_info("                    ");
-						mame_printf_info("= %s%-20s  %-10s %s\n", baddump ? "(BAD) " : "", ROM_GETNAME(rom), m_drivlist.driver().name, m_drivlist.driver().description);
-						found++;
-					}
-				}
-
-		// next iterate over softlists
-		software_list_device_iterator iter(m_drivlist.config().root_device());
-		for (const software_list_device *swlist = iter.first(); swlist != NULL; swlist = iter.next())
-		{
-			software_list *list = software_list_open(m_drivlist.options(), swlist->list_name(), FALSE, NULL);
-
-			for (software_info *swinfo = software_list_find(list, "*", NULL); swinfo != NULL; swinfo = software_list_find(list, "*", swinfo))
-				for (software_part *part = software_find_part(swinfo, NULL, NULL); part != NULL; part = software_part_next(part))
-					for (const rom_entry *region = part->romdata; region != NULL; region = rom_next_region(region))
-						for (const rom_entry *rom = rom_first_file(region); rom != NULL; rom = rom_next_file(rom))
-						{
-							hash_collection romhashes(ROM_GETHASHDATA(rom));
-							if (hashes == romhashes)
-							{
-								bool baddump = romhashes.flag(hash_collection::FLAG_BAD_DUMP);
-
-								// output information about the match
-								if (found)
-									mame_printf_info("                    ");
-								mame_printf_info("= %s%-20s  %s:%s %s\n", baddump ? "(BAD) " : "", ROM_GETNAME(rom), swlist->list_name(), swinfo->shortname, swinfo->longname);
-								found++;
-							}
-						}
-			software_list_close(list);
-		}
+		int index = results[resnum];
+		if (resnum != 0)
+			mame_printf_info("                    ");
+		if (m_index.software(index))
+			mame_printf_info("= %s%-20s  %s %s\n", m_index.baddump(index) ? "(BAD) " : "", m_index.name(index), m_index.owner(index), m_index.description(index));
+		else
+			mame_printf_info("= %s%-20s  %-10s %s\n", m_index.baddump(index) ? "(BAD) " : "", m_index.name(index), m_index.owner(index), m_index.description(index));
 	}
 
 	return found;
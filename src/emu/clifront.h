@@ -116,6 +116,80 @@ private:
 };
 
 
+// media_hash_index maps ROM hashes to the drivers and software list entries
+// that use them; it is built on first use and cached in the cfg directory
+class media_hash_index
+{
+	// an entry in the index
+	struct index_entry
+	{
+		UINT32              m_crc;              // CRC32, if FLAG_CRC
+		UINT8               m_sha1[20];         // SHA1, if FLAG_SHA1
+		UINT32              m_flags;            // FLAG_* below
+		UINT32              m_name;             // string offset of the ROM name
+		UINT32              m_owner;            // string offset of the driver or list:software name
+		UINT32              m_description;      // string offset of the driver or software description
+	};
+
+	// header of the cache file
+	struct index_header
+	{
+		char                m_magic[8];         // CACHE_MAGIC
+		UINT32              m_key;              // string offset of the build/hashpath/software list key
+		UINT32              m_lists;            // string offset of the software list names, space separated
+		UINT32              m_entries;          // number of index_entry records
+		UINT32              m_crcs;             // number of CRC lookup records
+		UINT32              m_sha1s;            // number of SHA1 lookup records
+		UINT32              m_strings;          // bytes of string data
+	};
+
+	static const UINT32 FLAG_CRC = 0x01;
+	static const UINT32 FLAG_SHA1 = 0x02;
+	static const UINT32 FLAG_BAD_DUMP = 0x04;
+	static const UINT32 FLAG_SOFTWARE = 0x08;
+
+public:
+	// construction/destruction
+	media_hash_index(driver_enumerator &drivlist);
+
+	// getters
+	const char *name(int index) const { return string(entry(index).m_name); }
+	const char *owner(int index) const { return string(entry(index).m_owner); }
+	const char *description(int index) const { return string(entry(index).m_description); }
+	bool baddump(int index) const { return ((entry(index).m_flags & FLAG_BAD_DUMP) != 0); }
+	bool software(int index) const { return ((entry(index).m_flags & FLAG_SOFTWARE) != 0); }
+
+	// operations
+	int find(const hash_collection &hashes, dynamic_array<int> &results);
+
+private:
+	// internal helpers
+	const index_header &header() const { return *reinterpret_cast<const index_header *>(&m_data[0]); }
+	const index_entry &entry(int index) const { return reinterpret_cast<const index_entry *>(&m_data[sizeof(index_header)])[index]; }
+	const UINT32 *crc_table() const { return reinterpret_cast<const UINT32 *>(&entry(header().m_entries)); }
+	const UINT32 *sha1_table() const { return crc_table() + header().m_crcs; }
+	const char *string(UINT32 offset) const { return reinterpret_cast<const char *>(sha1_table() + header().m_sha1s) + offset; }
+	void build_key(astring &key, const char *lists);
+	bool load();
+	void build();
+	void save();
+	void add_rom(const rom_entry *rom, UINT32 flags, UINT32 owner, UINT32 description);
+	UINT32 add_string(const char *string);
+
+	// internal state
+	driver_enumerator &     m_drivlist;
+	bool                    m_valid;
+	dynamic_array<UINT8>    m_data;             // the complete index, exactly as stored on disk
+
+	// build-time state
+	dynamic_array<index_entry> m_build_entries;
+	dynamic_array<char>     m_build_strings;
+
+	static const char       CACHE_MAGIC[8];
+	static const char       CACHE_NAME[];
+};
+
+
 // media_identifier class identifies media by hash via a search in
 // the driver database
 class media_identifier
@@ -139,6 +213,7 @@ public:
 private:
 	// internal state
 	driver_enumerator   m_drivlist;
+	media_hash_index    m_index;
 	int                 m_total;
 	int                 m_matches;
 	int                 m_nonroms;
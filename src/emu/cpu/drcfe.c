@@ -17,6 +17,7 @@
 
 #include "emu.h"
 #include "drcfe.h"
+#include "drcuml.h"
 
 
 //**************************************************************************
@@ -155,6 +156,79 @@ const opcode_desc *drc_frontend::describe_code(offs_t startpc)
 }
 
 
+//-------------------------------------------------
+//  checksum - compute a checksum of everything
+//  about a described block that code generation
+//  depends on, including delay slots
+//-------------------------------------------------
+
+UINT32 drc_frontend::checksum(const opcode_desc *desclist)
+{
+	crc32_creator crc;
+	for (const opcode_desc *desc = desclist; desc != NULL; desc = desc->next())
+	{
+		crc.append(&desc->pc, sizeof(desc->pc));
+		crc.append(&desc->physpc, sizeof(desc->physpc));
+		crc.append(&desc->targetpc, sizeof(desc->targetpc));
+		crc.append(&desc->opptr, sizeof(desc->opptr));
+		crc.append(&desc->length, sizeof(desc->length));
+		crc.append(&desc->delayslots, sizeof(desc->delayslots));
+		crc.append(&desc->skipslots, sizeof(desc->skipslots));
+		crc.append(&desc->flags, sizeof(desc->flags));
+		crc.append(&desc->cycles, sizeof(desc->cycles));
+		crc.append(desc->regin, sizeof(desc->regin));
+		crc.append(desc->regout, sizeof(desc->regout));
+		crc.append(desc->regreq, sizeof(desc->regreq));
+
+		UINT32 delaycrc = checksum(desc->delay.first());
+		crc.append(&delaycrc, sizeof(delaycrc));
+	}
+	return crc.finish().m_raw;
+}
+
+
+//-------------------------------------------------
+//  archive_checksum - extend the checksum of a
+//  described block with the per-sequence choices
+//  the frontends make from live state: whether
+//  each sequence gets a hash entry or redispatches
+//  to an existing one, and whether it validates
+//  its code because it sits in writable memory
+//-------------------------------------------------
+
+UINT32 drc_frontend::archive_checksum(const opcode_desc *desclist, drcuml_state &drcuml, address_space &space, UINT32 mode)
+{
+	crc32_creator crc;
+	UINT32 codecrc = checksum(desclist);
+	crc.append(&codecrc, sizeof(codecrc));
+
+	// this mirrors the sequence loop in the MIPS3, PPC and SH2 code_compile_block
+	bool override = false;
+	const opcode_desc *seqlast;
+	for (const opcode_desc *seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+	{
+		for (seqlast = seqhead; seqlast->next() != NULL; seqlast = seqlast->next())
+			if (seqlast->flags & OPFLAG_END_SEQUENCE)
+				break;
+
+		UINT8 choice;
+		if (override || !drcuml.hash_exists(mode, seqhead->pc))
+			choice = 'H';
+		else if (seqhead == desclist)
+		{
+			override = true;
+			choice = 'O';
+		}
+		else
+			choice = 'J';
+		if (choice != 'J' && space.get_write_ptr(seqhead->physpc) != NULL)
+			choice |= 0x80;
+		crc.append(&choice, sizeof(choice));
+	}
+	return crc.finish().m_raw;
+}
+
+
 //-------------------------------------------------
 //  describe_one - describe a single instruction,
 //  recursively describing opcodes in delay
@@ -84,6 +84,10 @@ const UINT32 OPFLAG_WRITES_MEMORY           = 0x00200000;       // instruction w
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+// forward declarations
+class drcuml_state;
+
+
 // description of a given opcode
 struct opcode_desc
 {
@@ -133,6 +137,10 @@ public:
 	// describe a block
 	const opcode_desc *describe_code(offs_t startpc);
 
+	// compute a checksum of a described block
+	static UINT32 checksum(const opcode_desc *desclist);
+	static UINT32 archive_checksum(const opcode_desc *desclist, drcuml_state &drcuml, address_space &space, UINT32 mode);
+
 protected:
 	// required overrides
 	virtual bool describe(opcode_desc &desc, const opcode_desc *prev) = 0;
@@ -10,9 +10,6 @@
 
     Future improvements/changes:
 
-    * UML optimizer:
-        - constant folding
-
     * Write a back-end validator:
         - checks all combinations of memory/register/immediate on all params
         - checks behavior of all opcodes
@@ -53,6 +50,26 @@ using namespace uml;
 
 
 
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// persistent archive parameters
+const char ARCHIVE_MAGIC[8] = { 'M', 'A', 'M', 'E', 'D', 'R', 'C', '1' };
+const UINT32 ARCHIVE_MAX_BYTES = 64 * 1024 * 1024;
+
+// how archived parameters are relocated when they are loaded
+enum
+{
+	RELOC_NONE = 0,                     // value is stored as-is
+	RELOC_NEAR,                         // value is an offset into the near cache
+	RELOC_SYMBOL,                       // value is an offset from the start of symbol 'index'
+	RELOC_REGION,                       // value is an offset from the start of memory region 'index'
+	RELOC_HANDLE                        // handle number 'index', value is the CRC of its name
+};
+
+
+
 //**************************************************************************
 //  TYPE DEFINITIONS
 //**************************************************************************
@@ -68,6 +85,163 @@ struct bevalidate_test
 };
 
 
+// header at the start of an archive file, followed by the key string
+struct archive_header
+{
+	char                    magic[8];           // ARCHIVE_MAGIC
+	UINT32                  keylength;          // length of the key string
+	UINT32                  entries;            // number of archived blocks
+};
+
+
+// header for each archived block, followed by its instructions
+struct archive_block_header
+{
+	UINT32                  mode;               // mode of the block
+	UINT32                  pc;                 // starting PC of the block
+	UINT32                  checksum;           // checksum of the source code
+	UINT32                  numinst;            // number of instructions
+};
+
+
+// a single archived instruction
+struct archive_instruction
+{
+	UINT8                   opcode;             // opcode
+	UINT8                   condition;          // condition
+	UINT8                   flags;              // flags
+	UINT8                   size;               // operation size
+	UINT8                   numparams;          // number of parameters
+	UINT8                   type[instruction::MAX_PARAMS];  // parameter types
+	UINT8                   reloc[instruction::MAX_PARAMS]; // how each parameter is relocated
+	UINT32                  index[instruction::MAX_PARAMS]; // relocation index
+	UINT64                  value[instruction::MAX_PARAMS]; // parameter values
+};
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  size_mask - return a mask covering an operand
+//  of the given number of bytes
+//-------------------------------------------------
+
+inline UINT64 size_mask(UINT8 size)
+{
+	return (size >= 8) ? U64(0xffffffffffffffff) : ((U64(1) << (8 * size)) - 1);
+}
+
+
+//-------------------------------------------------
+//  ranges_overlap - return true if two pieces of
+//  memory overlap
+//-------------------------------------------------
+
+inline bool ranges_overlap(const void *base1, UINT32 size1, const void *base2, UINT32 size2)
+{
+	return (drccodeptr(base1) < drccodeptr(base2) + size2 && drccodeptr(base2) < drccodeptr(base1) + size1);
+}
+
+
+//-------------------------------------------------
+//  is_control_flow - return true if an opcode
+//  is an entry point, or may leave the block or
+//  run other code
+//-------------------------------------------------
+
+inline bool is_control_flow(opcode_t opcode)
+{
+	switch (opcode)
+	{
+		case OP_HANDLE:     case OP_HASH:       case OP_LABEL:      case OP_DEBUG:
+		case OP_EXIT:       case OP_HASHJMP:    case OP_JMP:        case OP_EXH:
+		case OP_CALLH:      case OP_RET:        case OP_CALLC:      case OP_SAVE:
+		case OP_RESTORE:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  accesses_memory - return true if an opcode
+//  touches memory other than its parameters
+//-------------------------------------------------
+
+inline bool accesses_memory(opcode_t opcode)
+{
+	switch (opcode)
+	{
+		case OP_LOAD:       case OP_LOADS:      case OP_STORE:      case OP_READ:
+		case OP_READM:      case OP_WRITE:      case OP_WRITEM:     case OP_FLOAD:
+		case OP_FSTORE:     case OP_FREAD:      case OP_FWRITE:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  propagate_constants - replace register inputs
+//  whose values are known with immediates; unless
+//  'anywhere' is set, only do so for operands
+//  that the front-ends commonly pass immediates
+//  for
+//-------------------------------------------------
+
+static UINT32 propagate_constants(instruction &inst, const UINT64 *constval, const UINT8 *constsize, bool anywhere)
+{
+	UINT32 count = 0;
+	for (int pnum = 0; pnum < inst.numparams(); pnum++)
+	{
+		const parameter &param = inst.param(pnum);
+		if (!param.is_int_register() || !inst.param_is_input(pnum) || inst.param_is_output(pnum) || !inst.param_accepts(pnum, parameter::PTYPE_IMMEDIATE))
+			continue;
+		UINT8 size = inst.param_size(pnum);
+		int regnum = param.ireg() - REG_I0;
+		if (constsize[regnum] < size)
+			continue;
+
+		// the last source of most operations
+		if (!anywhere)
+			switch (inst.opcode())
+			{
+				case OP_MOV:    case OP_CMP:    case OP_TEST:
+					if (pnum != 1)
+						continue;
+					break;
+
+				case OP_ADD:    case OP_ADDC:   case OP_SUB:    case OP_SUBB:
+				case OP_AND:    case OP_OR:     case OP_XOR:    case OP_SHL:
+				case OP_SHR:    case OP_SAR:    case OP_ROL:    case OP_ROLC:
+				case OP_ROR:    case OP_RORC:   case OP_LOAD:   case OP_LOADS:
+					if (pnum != 2)
+						continue;
+					break;
+
+				case OP_STORE:
+					if (pnum != 1 && pnum != 2)
+						continue;
+					break;
+
+				default:
+					continue;
+			}
+
+		inst.set_param(pnum, constval[regnum] & size_mask(size));
+		count++;
+	}
+	return count;
+}
+
+
 
 //**************************************************************************
 //  DRC BACKEND INTERFACE
@@ -126,8 +300,15 @@ drcuml_state::drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int
 			*static_cast<drcbe_interface *>(auto_alloc(device.machine(), drcbe_native(*this, device, cache, flags, modes, addrbits, ignorebits)))),
 		m_umllog(NULL),
 		m_blocklist(device.machine().respool()),
-		m_symlist(device.machine().respool())
+		m_symlist(device.machine().respool()),
+		m_archive_enabled(false),
+		m_archive_loaded(false),
+		m_archive_options(0),
+		m_archive_bytes(0),
+		m_archive(device.machine().respool())
 {
+	memset(&m_optstats, 0, sizeof(m_optstats));
+
 	// if we're to log, create the logfile
 	if (flags & DRCUML_OPTION_LOG_UML)
 		m_umllog = fopen("drcuml.asm", "w");
@@ -143,9 +324,15 @@ drcuml_state::~drcuml_state()
 	// free the back-end
 	auto_free(m_device.machine(), &m_beintf);
 
-	// close any files
+	// close any files, summarizing what the optimizer did first
 	if (m_umllog != NULL)
+	{
+		if (m_optstats.blocks != 0)
+			log_printf("Optimizer totals: %d blocks, %d -> %d instructions; %d flags trimmed, %d constants, %d loads, %d stores, %d writes removed\n",
+				m_optstats.blocks, m_optstats.instructions_in, m_optstats.instructions_out, m_optstats.flags,
+				m_optstats.constants, m_optstats.loads, m_optstats.stores, m_optstats.writes);
 		fclose(m_umllog);
+	}
 }
 
 
@@ -280,6 +467,407 @@ void drcuml_state::log_printf(const char *format, ...)
 }
 
 
+//-------------------------------------------------
+//  archive_open - start keeping a persistent
+//  archive of generated blocks; blocks saved by
+//  a previous run are loaded on first use, once
+//  the CPU core has been fully configured; the
+//  generator string identifies the build of the
+//  frontend producing the UML
+//-------------------------------------------------
+
+void drcuml_state::archive_open(const char *generator)
+{
+	// only once, and only if enabled
+	running_machine &machine = m_device.machine();
+	if (m_archive_enabled || !machine.options().drc_cache())
+		return;
+	m_archive_enabled = true;
+	m_archive_generator.cpy(generator);
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(drcuml_state::archive_save), this));
+}
+
+
+//-------------------------------------------------
+//  archive_set_options - note the CPU core's DRC
+//  options, which change the generated code
+//-------------------------------------------------
+
+void drcuml_state::archive_set_options(UINT32 options)
+{
+	// anything archived under different options is stale
+	if (options != m_archive_options && m_archive_loaded)
+		archive_reset();
+	m_archive_options = options;
+}
+
+
+//-------------------------------------------------
+//  archive_load - load the blocks saved by a
+//  previous run
+//-------------------------------------------------
+
+void drcuml_state::archive_load()
+{
+	m_archive_loaded = true;
+
+	// if there's no file, we just start empty
+	running_machine &machine = m_device.machine();
+	astring filename;
+	emu_file file(machine.options().cfg_directory(), OPEN_FLAG_READ);
+	if (file.open(archive_filename(filename), ".drc") != FILERR_NONE)
+		return;
+
+	// validate the header and key; anything stale is simply ignored
+	archive_header header;
+	if (file.read(&header, sizeof(header)) != sizeof(header) || memcmp(header.magic, ARCHIVE_MAGIC, sizeof(header.magic)) != 0)
+		return;
+	astring key;
+	archive_key(key);
+	dynamic_buffer filekey(header.keylength + 1);
+	if (header.keylength != key.len() || file.read(filekey, header.keylength) != header.keylength || memcmp(filekey, key.cstr(), header.keylength) != 0)
+		return;
+
+	// read the blocks
+	for (UINT32 entrynum = 0; entrynum < header.entries; entrynum++)
+	{
+		archive_block_header blockheader;
+		if (file.read(&blockheader, sizeof(blockheader)) != sizeof(blockheader))
+			break;
+		UINT32 bytes = blockheader.numinst * sizeof(archive_instruction);
+		if (blockheader.numinst == 0 || m_archive_bytes + bytes > ARCHIVE_MAX_BYTES)
+			break;
+
+		archive_entry &entry = m_archive.append(*auto_alloc(machine, archive_entry(blockheader.mode, blockheader.pc, blockheader.checksum)));
+		entry.m_data.resize(bytes);
+		if (file.read(entry.m_data, bytes) != bytes)
+		{
+			m_archive.remove(entry);
+			break;
+		}
+		astring tag;
+		m_archive_map.add(tag.format("%X:%X", entry.m_mode, entry.m_pc), &entry, true);
+		m_archive_bytes += bytes;
+	}
+}
+
+
+//-------------------------------------------------
+//  archive_reset - discard all archived blocks
+//-------------------------------------------------
+
+void drcuml_state::archive_reset()
+{
+	m_archive_map.reset();
+	m_archive.reset();
+	m_archive_bytes = 0;
+}
+
+
+//-------------------------------------------------
+//  archive_save - write out the archive when the
+//  machine exits
+//-------------------------------------------------
+
+void drcuml_state::archive_save()
+{
+	if (m_archive.count() == 0)
+		return;
+
+	astring filename;
+	emu_file file(m_device.machine().options().cfg_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(archive_filename(filename), ".drc") != FILERR_NONE)
+		return;
+
+	// write the header and key
+	astring key;
+	archive_key(key);
+	archive_header header;
+	memcpy(header.magic, ARCHIVE_MAGIC, sizeof(header.magic));
+	header.keylength = key.len();
+	header.entries = m_archive.count();
+	file.write(&header, sizeof(header));
+	file.write(key.cstr(), key.len());
+
+	// write each block
+	for (archive_entry *entry = m_archive.first(); entry != NULL; entry = entry->next())
+	{
+		archive_block_header blockheader;
+		blockheader.mode = entry->m_mode;
+		blockheader.pc = entry->m_pc;
+		blockheader.checksum = entry->m_checksum;
+		blockheader.numinst = entry->m_data.count() / sizeof(archive_instruction);
+		file.write(&blockheader, sizeof(blockheader));
+		file.write(entry->m_data, entry->m_data.count());
+	}
+}
+
+
+//-------------------------------------------------
+//  archive_key - build the string that ties an
+//  archive to the build, CPU and configuration
+//  that produced it
+//-------------------------------------------------
+
+void drcuml_state::archive_key(astring &key)
+{
+	running_machine &machine = m_device.machine();
+	// build_version only carries the date, so also name the builds of the optimizer
+	// here and of the frontend, either of which can change the UML for the same code
+	key.format("%s;%s;%s;%s;%d;%d;%d;%X", build_version, __DATE__ " " __TIME__, m_archive_generator.cstr(), m_device.shortname(),
+			int(sizeof(archive_instruction)), machine.options().drc_use_c(), (machine.debug_flags & DEBUG_FLAG_ENABLED) != 0, m_archive_options);
+}
+
+
+//-------------------------------------------------
+//  archive_filename - return the name of the
+//  archive file for this CPU
+//-------------------------------------------------
+
+astring &drcuml_state::archive_filename(astring &filename)
+{
+	astring tag(m_device.tag());
+	tag.del(0, 1).replacechr(':', '_');
+	return filename.cpy(m_device.machine().basename()).cat(PATH_SEPARATOR).cat(tag);
+}
+
+
+//-------------------------------------------------
+//  archive_find - find the archived block for
+//  the given mode and PC
+//-------------------------------------------------
+
+drcuml_state::archive_entry *drcuml_state::archive_find(UINT32 mode, offs_t pc)
+{
+	astring tag;
+	return m_archive_map.find(tag.format("%X:%X", mode, pc));
+}
+
+
+//-------------------------------------------------
+//  archive_store - add a freshly generated block
+//  to the archive, replacing any older version
+//-------------------------------------------------
+
+void drcuml_state::archive_store(UINT32 mode, offs_t pc, UINT32 checksum, const instruction *inst, UINT32 numinst)
+{
+	// toss any previous version; it is stale now
+	archive_entry *entry = archive_find(mode, pc);
+	if (entry != NULL)
+	{
+		m_archive_bytes -= entry->m_data.count();
+		m_archive_map.remove(entry);
+		m_archive.remove(*entry);
+	}
+
+	// encode the instructions, dropping comments; if anything can't be
+	// relocated in a future run, the block isn't archived
+	dynamic_array<archive_instruction> records(numinst);
+	UINT32 count = 0;
+	for (UINT32 instnum = 0; instnum < numinst; instnum++)
+	{
+		const instruction &src = inst[instnum];
+		if (src.opcode() == OP_COMMENT)
+			continue;
+
+		archive_instruction &record = records[count++];
+		memset(&record, 0, sizeof(record));
+		record.opcode = src.m_opcode;
+		record.condition = src.m_condition;
+		record.flags = src.m_flags;
+		record.size = src.m_size;
+		record.numparams = src.m_numparams;
+		for (int pnum = 0; pnum < src.m_numparams; pnum++)
+		{
+			record.type[pnum] = src.m_param[pnum].m_type;
+			if (!archive_encode(src.m_param[pnum], record.reloc[pnum], record.index[pnum], record.value[pnum]))
+				return;
+		}
+	}
+
+	// add it if we have room
+	UINT32 bytes = count * sizeof(archive_instruction);
+	if (count == 0 || m_archive_bytes + bytes > ARCHIVE_MAX_BYTES)
+		return;
+	entry = &m_archive.append(*auto_alloc(m_device.machine(), archive_entry(mode, pc, checksum)));
+	entry->m_replayed = true;
+	entry->m_data.resize(bytes);
+	memcpy(entry->m_data, records, bytes);
+	astring tag;
+	m_archive_map.add(tag.format("%X:%X", mode, pc), entry, true);
+	m_archive_bytes += bytes;
+}
+
+
+//-------------------------------------------------
+//  archive_replay - decode an archived block into
+//  the given instruction list, returning the
+//  number of instructions or 0 if there is no
+//  usable match
+//-------------------------------------------------
+
+UINT32 drcuml_state::archive_replay(UINT32 mode, offs_t pc, UINT32 checksum, instruction *inst, UINT32 maxinst)
+{
+	// load the archive the first time it is needed
+	if (!m_archive_loaded)
+		archive_load();
+
+	// each archived block is only used once per run; if it gets recompiled
+	// later, something it depended on has changed and it is regenerated
+	archive_entry *entry = archive_find(mode, pc);
+	if (entry == NULL || entry->m_replayed || entry->m_checksum != checksum)
+		return 0;
+	entry->m_replayed = true;
+
+	UINT32 numinst = entry->m_data.count() / sizeof(archive_instruction);
+	if (numinst > maxinst)
+		return 0;
+
+	const archive_instruction *record = reinterpret_cast<const archive_instruction *>(&entry->m_data[0]);
+	for (UINT32 instnum = 0; instnum < numinst; instnum++, record++)
+	{
+		if (record->opcode >= OP_MAX || record->numparams > instruction::MAX_PARAMS)
+			return 0;
+
+		instruction &dest = inst[instnum];
+		dest.m_opcode = opcode_t(record->opcode);
+		dest.m_condition = condition_t(record->condition);
+		dest.m_flags = record->flags;
+		dest.m_size = record->size;
+		dest.m_numparams = record->numparams;
+		for (int pnum = 0; pnum < record->numparams; pnum++)
+			if (!archive_decode(record->type[pnum], record->reloc[pnum], record->index[pnum], record->value[pnum], dest.m_param[pnum]))
+				return 0;
+	}
+	return numinst;
+}
+
+
+//-------------------------------------------------
+//  archive_encode - convert a parameter into a
+//  form that can be relocated in a future run
+//-------------------------------------------------
+
+bool drcuml_state::archive_encode(const parameter &param, UINT8 &reloc, UINT32 &index, UINT64 &value)
+{
+	reloc = RELOC_NONE;
+	index = 0;
+	value = param.m_value;
+
+	switch (param.type())
+	{
+		// memory must be in the near cache, a symbol, or a memory region
+		case parameter::PTYPE_MEMORY:
+		{
+			drccodeptr ptr = drccodeptr(param.memory());
+			if (m_cache.contains_near_pointer(ptr))
+			{
+				reloc = RELOC_NEAR;
+				value = ptr - m_cache.near();
+				return true;
+			}
+			for (symbol *cursym = m_symlist.first(); cursym != NULL; cursym = cursym->next(), index++)
+				if (ptr >= cursym->m_base && ptr < cursym->m_base + cursym->m_length)
+				{
+					reloc = RELOC_SYMBOL;
+					value = ptr - cursym->m_base;
+					return true;
+				}
+			index = 0;
+			for (memory_region *region = m_device.machine().memory().first_region(); region != NULL; region = region->next(), index++)
+				if (ptr >= region->base() && ptr < region->base() + region->bytes())
+				{
+					reloc = RELOC_REGION;
+					value = ptr - region->base();
+					return true;
+				}
+			return false;
+		}
+
+		// handles are stored by number, with a checksum of their name
+		case parameter::PTYPE_CODE_HANDLE:
+			for (code_handle *handle = m_handlelist.first(); handle != NULL; handle = handle->next(), index++)
+				if (handle == &param.handle())
+				{
+					reloc = RELOC_HANDLE;
+					value = crc32_creator::simple(handle->string(), strlen(handle->string())).m_raw;
+					return true;
+				}
+			return false;
+
+		// C function addresses can't be tied to a build reliably, and strings
+		// point to transient memory
+		case parameter::PTYPE_C_FUNCTION:
+		case parameter::PTYPE_STRING:
+			return false;
+
+		// everything else is a plain value
+		default:
+			return true;
+	}
+}
+
+
+//-------------------------------------------------
+//  archive_decode - convert an archived
+//  parameter back to a live one
+//-------------------------------------------------
+
+bool drcuml_state::archive_decode(UINT8 type, UINT8 reloc, UINT32 index, UINT64 value, parameter &param)
+{
+	if (type == parameter::PTYPE_NONE || type >= parameter::PTYPE_MAX || type == parameter::PTYPE_STRING || type == parameter::PTYPE_C_FUNCTION)
+		return false;
+	param.m_type = parameter::parameter_type(type);
+	param.m_value = value;
+
+	switch (reloc)
+	{
+		case RELOC_NONE:
+			return true;
+
+		case RELOC_NEAR:
+			if (!m_cache.contains_near_pointer(m_cache.near() + value))
+				return false;
+			param.m_value = parameter::parameter_value(m_cache.near() + value);
+			return true;
+
+		case RELOC_SYMBOL:
+			for (symbol *cursym = m_symlist.first(); cursym != NULL; cursym = cursym->next())
+				if (index-- == 0)
+				{
+					if (value >= cursym->m_length)
+						return false;
+					param.m_value = parameter::parameter_value(cursym->m_base + value);
+					return true;
+				}
+			return false;
+
+		case RELOC_REGION:
+			for (memory_region *region = m_device.machine().memory().first_region(); region != NULL; region = region->next())
+				if (index-- == 0)
+				{
+					if (value >= region->bytes())
+						return false;
+					param.m_value = parameter::parameter_value(region->base() + value);
+					return true;
+				}
+			return false;
+
+		case RELOC_HANDLE:
+			for (code_handle *handle = m_handlelist.first(); handle != NULL; handle = handle->next())
+				if (index-- == 0)
+				{
+					if (crc32_creator::simple(handle->string(), strlen(handle->string())).m_raw != value)
+						return false;
+					param.m_value = parameter::parameter_value(handle);
+					return true;
+				}
+			return false;
+	}
+	return false;
+}
+
+
 
 //**************************************************************************
 //  DRCUML BLOCK
@@ -295,7 +883,12 @@ drcuml_block::drcuml_block(drcuml_state &drcuml, UINT32 maxinst)
 		m_nextinst(0),
 		m_maxinst(maxinst * 3/2),
 		m_inst(auto_alloc_array(drcuml.device().machine(), instruction, m_maxinst)),
-		m_inuse(false)
+		m_inuse(false),
+		m_archive(false),
+		m_replayed(false),
+		m_archive_mode(0),
+		m_archive_pc(0),
+		m_archive_checksum(0)
 {
 }
 
@@ -320,6 +913,36 @@ void drcuml_block::begin()
 	// set up the block information and return it
 	m_inuse = true;
 	m_nextinst = 0;
+	m_archive = false;
+	m_replayed = false;
+}
+
+
+//-------------------------------------------------
+//  replay - mark this block as compiled from code
+//  with the given checksum at the given mode and
+//  PC; if a matching block was archived by a
+//  previous run, fill in its instructions and
+//  return true
+//-------------------------------------------------
+
+bool drcuml_block::replay(UINT32 mode, offs_t pc, UINT32 checksum)
+{
+	assert(m_inuse);
+	assert(m_nextinst == 0);
+
+	// nothing to do if there is no archive
+	if (!m_drcuml.m_archive_enabled)
+		return false;
+	m_archive = true;
+	m_archive_mode = mode;
+	m_archive_pc = pc;
+	m_archive_checksum = checksum;
+
+	// see if we can use an archived copy
+	m_nextinst = m_drcuml.archive_replay(mode, pc, checksum, m_inst, m_maxinst);
+	m_replayed = (m_nextinst != 0);
+	return m_replayed;
 }
 
 
@@ -332,8 +955,14 @@ void drcuml_block::end()
 {
 	assert(m_inuse);
 
-	// optimize the resulting code first
-	optimize();
+	// optimize the resulting code first; archived code already is, so just
+	// archive anything that is new
+	if (!m_replayed)
+	{
+		optimize();
+		if (m_archive)
+			m_drcuml.archive_store(m_archive_mode, m_archive_pc, m_archive_checksum, m_inst, m_nextinst);
+	}
 
 	// if we have a logfile, generate a disassembly of the block
 	if (m_drcuml.logging())
@@ -410,43 +1039,23 @@ void drcuml_block::append_comment(const char *format, ...)
 
 void drcuml_block::optimize()
 {
-	UINT32 mapvar[MAPVAR_COUNT] = { 0 };
-
-	// iterate over instructions
-	for (int instnum = 0; instnum < m_nextinst; instnum++)
-	{
-		instruction &inst = m_inst[instnum];
-
-		// first compute what flags we need
-		UINT8 accumflags = 0;
-		UINT8 remainingflags = inst.output_flags();
-
-		// scan ahead until we run out of possible remaining flags
-		for (int scannum = instnum + 1; remainingflags != 0 && scannum < m_nextinst; scannum++)
-		{
-			// any input flags are required
-			const instruction &scan = m_inst[scannum];
-			accumflags |= scan.input_flags();
-
-			// if the scanahead instruction is unconditional, assume his flags are modified
-			if (scan.condition() == COND_ALWAYS)
-				remainingflags &= ~scan.modified_flags();
-		}
-		inst.set_flags(accumflags);
-
-		// track mapvars
-		if (inst.opcode() == OP_MAPVAR)
-			mapvar[inst.param(0).mapvar() - MAPVAR_M0] = inst.param(1).immediate();
-
-		// convert all mapvar parameters to immediates
-		else if (inst.opcode() != OP_RECOVER)
-			for (int pnum = 0; pnum < inst.numparams(); pnum++)
-				if (inst.param(pnum).is_mapvar())
-					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - MAPVAR_M0]);
-
-		// now that flags are correct, simplify the instruction
-		inst.simplify();
-	}
+	drcuml_optimizer optimizer(m_inst, m_nextinst);
+	m_nextinst = optimizer.optimize();
+
+	// accumulate and log the statistics
+	const drcuml_optimizer_stats &stats = optimizer.stats();
+	drcuml_optimizer_stats &totals = m_drcuml.m_optstats;
+	totals.blocks++;
+	totals.instructions_in += stats.instructions_in;
+	totals.instructions_out += stats.instructions_out;
+	totals.flags += stats.flags;
+	totals.constants += stats.constants;
+	totals.loads += stats.loads;
+	totals.stores += stats.stores;
+	totals.writes += stats.writes;
+	if (m_drcuml.logging())
+		m_drcuml.log_printf("Optimized %d -> %d instructions; %d flags trimmed, %d constants, %d loads, %d stores, %d writes removed\n",
+			stats.instructions_in, stats.instructions_out, stats.flags, stats.constants, stats.loads, stats.stores, stats.writes);
 }
 
 
@@ -535,6 +1144,342 @@ const char *drcuml_block::get_comment_text(const instruction &inst, astring &com
 }
 
 
+//**************************************************************************
+//  DRCUML OPTIMIZER
+//**************************************************************************
+
+//-------------------------------------------------
+//  drcuml_optimizer - constructor
+//-------------------------------------------------
+
+drcuml_optimizer::drcuml_optimizer(instruction *inst, UINT32 numinst)
+	: m_inst(inst),
+		m_numinst(numinst)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+	m_stats.blocks = 1;
+	m_stats.instructions_in = numinst;
+}
+
+
+//-------------------------------------------------
+//  optimize - apply all the optimizations to the
+//  instructions
+//-------------------------------------------------
+
+UINT32 drcuml_optimizer::optimize()
+{
+	// work out which flags are needed, then fold constants and cached state
+	// into the instructions that use them
+	optimize_flags();
+	optimize_propagate();
+
+	// drop stores and register writes that nothing reads
+	optimize_dead_stores();
+	optimize_dead_writes();
+
+	// removed code may have needed flags, so trim them again and squeeze
+	// out the NOPs we've left behind
+	optimize_flags();
+	UINT32 outnum = 0;
+	for (int instnum = 0; instnum < m_numinst; instnum++)
+	{
+		instruction &inst = m_inst[instnum];
+		inst.simplify();
+		if (inst.opcode() == OP_NOP)
+			continue;
+		if ((inst.output_flags() & ~inst.flags()) != 0)
+			m_stats.flags++;
+		m_inst[outnum++] = inst;
+	}
+	m_numinst = m_stats.instructions_out = outnum;
+	return m_numinst;
+}
+
+
+//-------------------------------------------------
+//  optimize_flags - compute the flags each
+//  instruction actually needs to produce
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize_flags()
+{
+	// iterate over instructions
+	for (int instnum = 0; instnum < m_numinst; instnum++)
+	{
+		instruction &inst = m_inst[instnum];
+
+		// first compute what flags we need
+		UINT8 accumflags = 0;
+		UINT8 remainingflags = inst.output_flags();
+
+		// scan ahead until we run out of possible remaining flags
+		for (int scannum = instnum + 1; remainingflags != 0 && scannum < m_numinst; scannum++)
+		{
+			// any input flags are required
+			const instruction &scan = m_inst[scannum];
+			accumflags |= scan.input_flags();
+
+			// if the scanahead instruction is unconditional, assume his flags are modified
+			if (scan.condition() == COND_ALWAYS)
+				remainingflags &= ~scan.modified_flags();
+		}
+		inst.set_flags(accumflags);
+	}
+}
+
+
+//-------------------------------------------------
+//  optimize_propagate - resolve mapvars, replace
+//  registers holding known constants with
+//  immediates, and replace reads of CPU state
+//  with a register already holding the value
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize_propagate()
+{
+	UINT32 mapvar[MAPVAR_COUNT] = { 0 };
+
+	// what we know about each integer register: its value, and a piece of
+	// memory it is a copy of; a size of 0 means we know nothing
+	UINT64 constval[REG_I_COUNT];
+	UINT8 constsize[REG_I_COUNT] = { 0 };
+	void *memptr[REG_I_COUNT];
+	UINT8 memsize[REG_I_COUNT] = { 0 };
+
+	// iterate over instructions
+	for (int instnum = 0; instnum < m_numinst; instnum++)
+	{
+		instruction &inst = m_inst[instnum];
+
+		// track mapvars
+		if (inst.opcode() == OP_MAPVAR)
+			mapvar[inst.param(0).mapvar() - MAPVAR_M0] = inst.param(1).immediate();
+
+		// convert all mapvar parameters to immediates
+		else if (inst.opcode() != OP_RECOVER)
+			for (int pnum = 0; pnum < inst.numparams(); pnum++)
+				if (inst.param(pnum).is_mapvar())
+					inst.set_mapvar(pnum, mapvar[inst.param(pnum).mapvar() - MAPVAR_M0]);
+
+		// anything can jump to an entry point, so forget everything
+		if (inst.opcode() == OP_HANDLE || inst.opcode() == OP_HASH || inst.opcode() == OP_LABEL)
+		{
+			memset(constsize, 0, sizeof(constsize));
+			memset(memsize, 0, sizeof(memsize));
+		}
+
+		// replace memory inputs that a register already holds
+		const instruction orig = inst;
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			if (inst.param(pnum).is_memory() && inst.param_is_input(pnum) && !inst.param_is_output(pnum) && inst.param_accepts(pnum, parameter::PTYPE_INT_REGISTER))
+				for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+					if (memsize[regnum] == inst.param_size(pnum) && memptr[regnum] == inst.param(pnum).memory())
+					{
+						inst.set_param(pnum, parameter::make_ireg(REG_I0 + regnum));
+						m_stats.loads++;
+						break;
+					}
+
+		// replace registers whose value we know; if that doesn't fold the
+		// whole instruction away, stick to operands the back-ends are used
+		// to seeing as immediates
+		instruction folded = inst;
+		UINT32 constants = propagate_constants(folded, constval, constsize, true);
+		folded.simplify();
+		if (constants != 0 && (folded.opcode() == OP_NOP || (folded.opcode() == OP_MOV && folded.param(1).is_immediate())))
+			inst = folded;
+		else
+			constants = propagate_constants(inst, constval, constsize, false);
+		m_stats.constants += constants;
+
+		// now that flags and inputs are correct, simplify the instruction
+		inst.simplify();
+
+		// if it simplified away, nothing has changed
+		if (inst.opcode() == OP_NOP)
+			continue;
+
+		// account for anything written behind our back
+		switch (orig.opcode())
+		{
+			// handles and C functions can change anything
+			case OP_DEBUG:
+			case OP_EXH:
+			case OP_CALLH:
+			case OP_CALLC:
+			case OP_RESTORE:
+				memset(constsize, 0, sizeof(constsize));
+				memset(memsize, 0, sizeof(memsize));
+				break;
+
+			// memory handlers can change CPU state; indexed stores can hit anything
+			case OP_READ:
+			case OP_READM:
+			case OP_WRITE:
+			case OP_WRITEM:
+			case OP_FREAD:
+			case OP_FWRITE:
+			case OP_STORE:
+			case OP_FSTORE:
+			case OP_SAVE:
+				memset(memsize, 0, sizeof(memsize));
+				break;
+
+			default:
+				break;
+		}
+
+		// forget about anything the instruction writes
+		for (int pnum = 0; pnum < orig.numparams(); pnum++)
+			if (orig.param_is_output(pnum))
+			{
+				const parameter &param = orig.param(pnum);
+				if (param.is_int_register())
+					constsize[param.ireg() - REG_I0] = memsize[param.ireg() - REG_I0] = 0;
+				else if (param.is_memory())
+					for (int regnum = 0; regnum < REG_I_COUNT; regnum++)
+						if (memsize[regnum] != 0 && ranges_overlap(memptr[regnum], memsize[regnum], param.memory(), orig.param_size(pnum)))
+							memsize[regnum] = 0;
+			}
+
+		// unconditional moves between registers and memory leave a copy behind
+		if (orig.opcode() == OP_MOV && orig.condition() == COND_ALWAYS)
+		{
+			const parameter &dst = orig.param(0);
+			const parameter &src = orig.param(1);
+			if (dst.is_int_register() && src.is_memory())
+			{
+				memptr[dst.ireg() - REG_I0] = src.memory();
+				memsize[dst.ireg() - REG_I0] = orig.size();
+			}
+			else if (dst.is_memory() && src.is_int_register())
+			{
+				memptr[src.ireg() - REG_I0] = dst.memory();
+				memsize[src.ireg() - REG_I0] = orig.size();
+			}
+		}
+
+		// and unconditional moves of immediates leave a known value
+		if (inst.opcode() == OP_MOV && inst.condition() == COND_ALWAYS && inst.param(0).is_int_register() && inst.param(1).is_immediate())
+		{
+			constval[inst.param(0).ireg() - REG_I0] = inst.param(1).immediate() & size_mask(inst.size());
+			constsize[inst.param(0).ireg() - REG_I0] = inst.size();
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  optimize_dead_stores - remove moves to memory
+//  that are overwritten before anything could
+//  have read them
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize_dead_stores()
+{
+	for (int instnum = 0; instnum < m_numinst; instnum++)
+	{
+		instruction &inst = m_inst[instnum];
+		if (inst.opcode() != OP_MOV || inst.condition() != COND_ALWAYS || !inst.param(0).is_memory())
+			continue;
+		void *base = inst.param(0).memory();
+		UINT8 size = inst.size();
+
+		// scan ahead until something might look at the memory
+		for (int scannum = instnum + 1; scannum < m_numinst; scannum++)
+		{
+			const instruction &scan = m_inst[scannum];
+			if (is_control_flow(scan.opcode()) || accesses_memory(scan.opcode()))
+				break;
+
+			// see if it reads or completely replaces our value
+			bool read = false;
+			bool overwritten = false;
+			for (int pnum = 0; pnum < scan.numparams(); pnum++)
+				if (scan.param(pnum).is_memory())
+				{
+					const parameter &param = scan.param(pnum);
+					UINT8 scansize = scan.param_size(pnum);
+					if (scan.param_is_input(pnum) && ranges_overlap(base, size, param.memory(), scansize))
+						read = true;
+					else if (scan.param_is_output(pnum) && scan.condition() == COND_ALWAYS &&
+							drccodeptr(param.memory()) <= drccodeptr(base) && drccodeptr(param.memory()) + scansize >= drccodeptr(base) + size)
+						overwritten = true;
+				}
+			if (read)
+				break;
+			if (overwritten)
+			{
+				inst.nop();
+				m_stats.stores++;
+				break;
+			}
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  optimize_dead_writes - remove instructions
+//  whose only effect is to write a register that
+//  is overwritten before it is read
+//-------------------------------------------------
+
+void drcuml_optimizer::optimize_dead_writes()
+{
+	// live parts of each integer register: bit 0 is the low 32 bits, bit 1 the
+	// high 32 bits; everything is live when we leave the block
+	UINT8 live[REG_I_COUNT];
+	memset(live, 3, sizeof(live));
+
+	// walk backwards
+	for (int instnum = m_numinst - 1; instnum >= 0; instnum--)
+	{
+		instruction &inst = m_inst[instnum];
+
+		// anything that leaves this straight-line code may read any register
+		if (is_control_flow(inst.opcode()))
+		{
+			memset(live, 3, sizeof(live));
+			continue;
+		}
+
+		// remove simple operations that only produce a dead register
+		if (inst.condition() == COND_ALWAYS && inst.flags() == 0 && inst.numparams() > 0 &&
+			inst.param(0).is_int_register() && inst.param_is_output(0) && !inst.param_is_input(0) &&
+			live[inst.param(0).ireg() - REG_I0] == 0)
+		{
+			switch (inst.opcode())
+			{
+				case OP_LOAD:   case OP_LOADS:  case OP_MOV:    case OP_SEXT:
+				case OP_ROLAND: case OP_ADD:    case OP_SUB:    case OP_AND:
+				case OP_OR:     case OP_XOR:    case OP_LZCNT:  case OP_BSWAP:
+				case OP_SHL:    case OP_SHR:    case OP_SAR:    case OP_ROL:
+				case OP_ROR:
+					inst.nop();
+					m_stats.writes++;
+					continue;
+
+				default:
+					break;
+			}
+		}
+
+		// unconditional writes end the life of what they replace
+		if (inst.condition() == COND_ALWAYS)
+			for (int pnum = 0; pnum < inst.numparams(); pnum++)
+				if (inst.param(pnum).is_int_register() && inst.param_is_output(pnum) && !inst.param_is_input(pnum))
+					live[inst.param(pnum).ireg() - REG_I0] &= (inst.param_size(pnum) > 4) ? 0 : ~1;
+
+		// and reads start it
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			if (inst.param(pnum).is_int_register() && inst.param_is_input(pnum))
+				live[inst.param(pnum).ireg() - REG_I0] |= (inst.param_size(pnum) > 4) ? 3 : 1;
+	}
+}
+
+
 
 #if 0
 
@@ -88,6 +88,47 @@ struct drcbe_info
 };
 
 
+// statistics gathered by the block optimizer
+struct drcuml_optimizer_stats
+{
+	UINT32              blocks;             // number of blocks optimized
+	UINT32              instructions_in;    // instructions before optimization
+	UINT32              instructions_out;   // instructions after optimization
+	UINT32              flags;              // instructions that no longer produce some of their flags
+	UINT32              constants;          // register inputs replaced with known constants
+	UINT32              loads;              // memory inputs replaced with a register holding the same value
+	UINT32              stores;             // stores removed because the value was overwritten unread
+	UINT32              writes;             // register writes removed because the value was never read
+};
+
+
+// the block optimizer's passes, which need nothing but the instructions
+class drcuml_optimizer
+{
+public:
+	// construction/destruction
+	drcuml_optimizer(uml::instruction *inst, UINT32 numinst);
+
+	// getters
+	const drcuml_optimizer_stats &stats() const { return m_stats; }
+
+	// run every pass, returning the number of instructions left
+	UINT32 optimize();
+
+private:
+	// internal helpers
+	void optimize_flags();
+	void optimize_propagate();
+	void optimize_dead_stores();
+	void optimize_dead_writes();
+
+	// internal state
+	uml::instruction *      m_inst;             // pointer to the instruction list
+	UINT32                  m_numinst;          // number of instructions
+	drcuml_optimizer_stats  m_stats;            // what the passes did
+};
+
+
 // a drcuml_block describes a basic block of instructions
 class drcuml_block
 {
@@ -105,6 +146,7 @@ public:
 
 	// code generation
 	void begin();
+	bool replay(UINT32 mode, offs_t pc, UINT32 checksum);
 	void end();
 	void abort();
 
@@ -132,6 +174,11 @@ private:
 	UINT32                  m_maxinst;          // maximum number of instructions
 	uml::instruction *      m_inst;             // pointer to the instruction list
 	bool                    m_inuse;            // this block is in use
+	bool                    m_archive;          // archive this block when it ends
+	bool                    m_replayed;         // block was filled from the archive
+	UINT32                  m_archive_mode;     // mode the block was compiled for
+	offs_t                  m_archive_pc;       // PC the block was compiled for
+	UINT32                  m_archive_checksum; // checksum of the code the block was compiled from
 };
 
 
@@ -164,6 +211,8 @@ protected:
 // structure describing UML generation state
 class drcuml_state
 {
+	friend class drcuml_block;
+
 public:
 	// construction/destruction
 	drcuml_state(device_t &device, drc_cache &cache, UINT32 flags, int modes, int addrbits, int ignorebits);
@@ -192,6 +241,10 @@ public:
 	void symbol_add(void *base, UINT32 length, const char *name);
 	const char *symbol_find(void *base, UINT32 *offset = NULL);
 
+	// persistent block archive
+	void archive_open(const char *generator);
+	void archive_set_options(UINT32 options);
+
 	// logging
 	bool logging() const { return (m_umllog != NULL); }
 	void log_printf(const char *format, ...);
@@ -223,6 +276,46 @@ private:
 		astring                 m_name;             // name of the symbol
 	};
 
+	// archived block class
+	class archive_entry
+	{
+		friend class drcuml_state;
+		friend class simple_list<archive_entry>;
+
+		// construction/destruction
+		archive_entry(UINT32 mode, offs_t pc, UINT32 checksum)
+			: m_next(NULL),
+				m_mode(mode),
+				m_pc(pc),
+				m_checksum(checksum),
+				m_replayed(false) { }
+
+	public:
+		// getters
+		archive_entry *next() const { return m_next; }
+
+	private:
+		// internal state
+		archive_entry *         m_next;             // link to the next entry
+		UINT32                  m_mode;             // mode of the block
+		offs_t                  m_pc;               // starting PC of the block
+		UINT32                  m_checksum;         // checksum of the source code
+		bool                    m_replayed;         // already used during this run
+		dynamic_buffer          m_data;             // encoded instructions
+	};
+
+	// archive helpers
+	void archive_load();
+	void archive_reset();
+	void archive_save();
+	void archive_key(astring &key);
+	astring &archive_filename(astring &filename);
+	archive_entry *archive_find(UINT32 mode, offs_t pc);
+	void archive_store(UINT32 mode, offs_t pc, UINT32 checksum, const uml::instruction *inst, UINT32 numinst);
+	UINT32 archive_replay(UINT32 mode, offs_t pc, UINT32 checksum, uml::instruction *inst, UINT32 maxinst);
+	bool archive_encode(const uml::parameter &param, UINT8 &reloc, UINT32 &index, UINT64 &value);
+	bool archive_decode(UINT8 type, UINT8 reloc, UINT32 index, UINT64 value, uml::parameter &param);
+
 	// internal state
 	device_t &                  m_device;           // CPU device we are associated with
 	drc_cache &                 m_cache;            // pointer to the codegen cache
@@ -231,6 +324,14 @@ private:
 	simple_list<drcuml_block>   m_blocklist;        // list of active blocks
 	simple_list<uml::code_handle> m_handlelist;     // list of active handles
 	simple_list<symbol>         m_symlist;          // list of symbols
+	bool                        m_archive_enabled;  // persistent archive is in use
+	bool                        m_archive_loaded;   // archive file has been read
+	astring                     m_archive_generator; // build stamp of the frontend generating the UML
+	UINT32                      m_archive_options;  // CPU core options the archive was built with
+	UINT32                      m_archive_bytes;    // bytes held in the archive
+	simple_list<archive_entry>  m_archive;          // list of archived blocks
+	tagmap_t<archive_entry *>   m_archive_map;      // map for archive lookups
+	drcuml_optimizer_stats      m_optstats;         // totals from the block optimizer
 };
 
 
@@ -426,6 +426,9 @@ static void mips3_init(mips3_flavor flavor, int bigendian, legacy_cpu_device *de
 	mips3->impstate->drcuml->symbol_add(&mips3->impstate->numcycles, sizeof(mips3->impstate->numcycles), "numcycles");
 	mips3->impstate->drcuml->symbol_add(&mips3->impstate->fpmode, sizeof(mips3->impstate->fpmode), "fpmode");
 
+	/* keep generated code between runs */
+	mips3->impstate->drcuml->archive_open(__DATE__ " " __TIME__);
+
 	/* initialize the front-end helper */
 	mips3->impstate->drcfe = auto_alloc(device->machine(), mips3_frontend(*mips3, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
 
@@ -608,6 +611,7 @@ void mips3drc_set_options(device_t *device, UINT32 options)
 	if (!device->machine().options().drc()) return;
 	mips3_state *mips3 = get_safe_token(device);
 	mips3->impstate->drcoptions = options;
+	mips3->impstate->drcuml->archive_set_options(options);
 }
 
 
@@ -627,6 +631,9 @@ void mips3drc_add_fastram(device_t *device, offs_t start, offs_t end, UINT8 read
 		mips3->impstate->fastram[mips3->impstate->fastram_select].readonly = readonly;
 		mips3->impstate->fastram[mips3->impstate->fastram_select].base = base;
 		mips3->impstate->fastram_select++;
+
+		/* name it so that archived code referencing it can be relocated */
+		mips3->impstate->drcuml->symbol_add(base, end + 1 - start, "fastram");
 	}
 }
 
@@ -745,8 +752,11 @@ static void code_compile_block(mips3_state *mips3, UINT8 mode, offs_t pc)
 			/* start the block */
 			block = drcuml->begin_block(4096);
 
+			/* reuse the UML archived by an earlier run if the code is unchanged */
+			const opcode_desc *firstseq = block->replay(mode, pc, drc_frontend::archive_checksum(desclist, *drcuml, *mips3->program, mode)) ? NULL : desclist;
+
 			/* loop until we get through all instruction sequences */
-			for (seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+			for (seqhead = firstseq; seqhead != NULL; seqhead = seqlast->next())
 			{
 				const opcode_desc *curdesc;
 				UINT32 nextpc;
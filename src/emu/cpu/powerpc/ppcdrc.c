@@ -615,6 +615,9 @@ static void ppcdrc_init(powerpc_flavor flavor, UINT32 cap, int tb_divisor, legac
 	ppc->impstate->drcuml->symbol_add(&ppc->impstate->cmpl_cr_table, sizeof(ppc->impstate->cmpl_cr_table), "cmpl_cr_table");
 	ppc->impstate->drcuml->symbol_add(&ppc->impstate->fcmp_cr_table, sizeof(ppc->impstate->fcmp_cr_table), "fcmp_cr_table");
 
+	/* keep generated code between runs */
+	ppc->impstate->drcuml->archive_open(__DATE__ " " __TIME__);
+
 	/* initialize the front-end helper */
 	ppc->impstate->drcfe = auto_alloc(device->machine(), ppc_frontend(*ppc, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
 
@@ -791,6 +794,7 @@ void ppcdrc_set_options(device_t *device, UINT32 options)
 {
 	powerpc_state *ppc = get_safe_token(device);
 	ppc->impstate->drcoptions = options;
+	ppc->impstate->drcuml->archive_set_options(options);
 }
 
 
@@ -809,6 +813,9 @@ void ppcdrc_add_fastram(device_t *device, offs_t start, offs_t end, UINT8 readon
 		ppc->impstate->fastram[ppc->impstate->fastram_select].readonly = readonly;
 		ppc->impstate->fastram[ppc->impstate->fastram_select].base = base;
 		ppc->impstate->fastram_select++;
+
+		/* name it so that archived code referencing it can be relocated */
+		ppc->impstate->drcuml->symbol_add(base, end + 1 - start, "fastram");
 	}
 }
 
@@ -938,8 +945,11 @@ static void code_compile_block(powerpc_state *ppc, UINT8 mode, offs_t pc)
 			/* start the block */
 			block = drcuml->begin_block(4096);
 
+			/* reuse the UML archived by an earlier run if the code is unchanged */
+			const opcode_desc *firstseq = block->replay(mode, pc, drc_frontend::archive_checksum(desclist, *drcuml, *ppc->program, mode)) ? NULL : desclist;
+
 			/* loop until we get through all instruction sequences */
-			for (seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+			for (seqhead = firstseq; seqhead != NULL; seqhead = seqlast->next())
 			{
 				const opcode_desc *curdesc;
 				UINT32 nextpc;
@@ -694,6 +694,9 @@ static CPU_INIT( sh2 )
 	sh2->drcuml->symbol_add(&sh2->macl, sizeof(sh2->macl), "macl");
 	sh2->drcuml->symbol_add(&sh2->mach, sizeof(sh2->macl), "mach");
 
+	/* keep generated code between runs */
+	sh2->drcuml->archive_open(__DATE__ " " __TIME__);
+
 	/* initialize the front-end helper */
 	sh2->drcfe = auto_alloc(device->machine(), sh2_frontend(*sh2, COMPILE_BACKWARDS_BYTES, COMPILE_FORWARDS_BYTES, SINGLE_INSTRUCTION_MODE ? 1 : COMPILE_MAX_SEQUENCE));
 
@@ -916,8 +919,11 @@ static void code_compile_block(sh2_state *sh2, UINT8 mode, offs_t pc)
 			/* start the block */
 			block = drcuml->begin_block(4096);
 
+			/* reuse the UML archived by an earlier run if the code is unchanged */
+			const opcode_desc *firstseq = block->replay(mode, pc, drc_frontend::archive_checksum(desclist, *drcuml, *sh2->program, mode)) ? NULL : desclist;
+
 			/* loop until we get through all instruction sequences */
-			for (seqhead = desclist; seqhead != NULL; seqhead = seqlast->next())
+			for (seqhead = firstseq; seqhead != NULL; seqhead = seqlast->next())
 			{
 				const opcode_desc *curdesc;
 				UINT32 nextpc;
@@ -3178,6 +3184,7 @@ void sh2drc_set_options(device_t *device, UINT32 options)
 	if (!device->machine().options().drc()) return;
 	sh2_state *sh2 = get_safe_token(device);
 	sh2->drcoptions = options;
+	sh2->drcuml->archive_set_options(options);
 }
 
 
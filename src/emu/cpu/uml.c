@@ -230,7 +230,7 @@ const opcode_info instruction::s_opcode_info_table[OP_MAX] =
 inline UINT32 rol32(UINT32 source, UINT8 count)
 {
 	count &= 31;
-	return (source << count) | (source >> (32 - count));
+	return (source << count) | (source >> ((32 - count) & 31));
 }
 
 
@@ -241,7 +241,7 @@ inline UINT32 rol32(UINT32 source, UINT8 count)
 inline UINT64 rol64(UINT64 source, UINT8 count)
 {
 	count &= 63;
-	return (source << count) | (source >> (64 - count));
+	return (source << count) | (source >> ((64 - count) & 63));
 }
 
 
@@ -491,16 +491,16 @@ void uml::instruction::simplify()
 					m_opcode = OP_ROL;
 					m_numparams = 3;
 				}
-				else if (m_param[2].is_immediate() && m_param[3].is_immediate_value((U64(0xffffffffffffffff) << m_param[2].immediate()) & instsizemask[m_size]))
+				else if (m_param[2].is_immediate() && m_param[3].is_immediate_value((U64(0xffffffffffffffff) << (m_param[2].immediate() & (8 * m_size - 1))) & instsizemask[m_size]))
 				{
 					m_opcode = OP_SHL;
 					m_numparams = 3;
 				}
-				else if (m_param[2].is_immediate() && m_param[3].is_immediate_value(instsizemask[m_size] >> (8 * m_size - m_param[2].immediate())))
+				else if (m_param[2].is_immediate() && (m_param[2].immediate() & (8 * m_size - 1)) != 0 && m_param[3].is_immediate_value(instsizemask[m_size] >> (8 * m_size - (m_param[2].immediate() & (8 * m_size - 1)))))
 				{
 					m_opcode = OP_SHR;
 					m_numparams = 3;
-					m_param[2] = 8 * m_size - m_param[2].immediate();
+					m_param[2] = 8 * m_size - (m_param[2].immediate() & (8 * m_size - 1));
 				}
 				break;
 
@@ -545,9 +545,9 @@ void uml::instruction::simplify()
 					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
 					{
 						if (m_size == 4)
-							convert_to_mov_immediate((UINT32)((UINT32)m_param[1].immediate() * (UINT32)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT32)((UINT32)m_param[2].immediate() * (UINT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((UINT64)((UINT64)m_param[1].immediate() * (UINT64)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT64)((UINT64)m_param[2].immediate() * (UINT64)m_param[3].immediate()));
 					}
 				}
 				break;
@@ -561,9 +561,9 @@ void uml::instruction::simplify()
 					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
 					{
 						if (m_size == 4)
-							convert_to_mov_immediate((INT32)((INT32)m_param[1].immediate() * (INT32)m_param[2].immediate()));
+							convert_to_mov_immediate((INT32)((INT32)m_param[2].immediate() * (INT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((INT64)((INT64)m_param[1].immediate() * (INT64)m_param[2].immediate()));
+							convert_to_mov_immediate((INT64)((INT64)m_param[2].immediate() * (INT64)m_param[3].immediate()));
 					}
 				}
 				break;
@@ -577,9 +577,9 @@ void uml::instruction::simplify()
 					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
 					{
 						if (m_size == 4)
-							convert_to_mov_immediate((UINT32)((UINT32)m_param[1].immediate() / (UINT32)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT32)((UINT32)m_param[2].immediate() / (UINT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((UINT64)((UINT64)m_param[1].immediate() / (UINT64)m_param[2].immediate()));
+							convert_to_mov_immediate((UINT64)((UINT64)m_param[2].immediate() / (UINT64)m_param[3].immediate()));
 					}
 				}
 				break;
@@ -593,9 +593,9 @@ void uml::instruction::simplify()
 					else if (m_param[2].is_immediate() && m_param[3].is_immediate())
 					{
 						if (m_size == 4)
-							convert_to_mov_immediate((INT32)((INT32)m_param[1].immediate() / (INT32)m_param[2].immediate()));
+							convert_to_mov_immediate((INT32)((INT32)m_param[2].immediate() / (INT32)m_param[3].immediate()));
 						else if (m_size == 8)
-							convert_to_mov_immediate((INT64)((INT64)m_param[1].immediate() / (INT64)m_param[2].immediate()));
+							convert_to_mov_immediate((INT64)((INT64)m_param[2].immediate() / (INT64)m_param[3].immediate()));
 					}
 				}
 				break;
@@ -670,7 +670,12 @@ void uml::instruction::simplify()
 			// SHL: convert to MOV if immediate or shifting by 0
 			case OP_SHL:
 				if (m_param[1].is_immediate() && m_param[2].is_immediate())
-					convert_to_mov_immediate(m_param[1].immediate() << m_param[2].immediate());
+				{
+					if (m_size == 4)
+						convert_to_mov_immediate((UINT32)m_param[1].immediate() << (m_param[2].immediate() & 31));
+					else if (m_size == 8)
+						convert_to_mov_immediate((UINT64)m_param[1].immediate() << (m_param[2].immediate() & 63));
+				}
 				else if (m_param[2].is_immediate_value(0))
 					convert_to_mov_param(1);
 				break;
@@ -680,9 +685,9 @@ void uml::instruction::simplify()
 				if (m_param[1].is_immediate() && m_param[2].is_immediate())
 				{
 					if (m_size == 4)
-						convert_to_mov_immediate((UINT32)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((UINT32)m_param[1].immediate() >> (m_param[2].immediate() & 31));
 					else if (m_size == 8)
-						convert_to_mov_immediate((UINT64)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((UINT64)m_param[1].immediate() >> (m_param[2].immediate() & 63));
 				}
 				else if (m_param[2].is_immediate_value(0))
 					convert_to_mov_param(1);
@@ -693,9 +698,9 @@ void uml::instruction::simplify()
 				if (m_param[1].is_immediate() && m_param[2].is_immediate())
 				{
 					if (m_size == 4)
-						convert_to_mov_immediate((INT32)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((INT32)m_param[1].immediate() >> (m_param[2].immediate() & 31));
 					else if (m_size == 8)
-						convert_to_mov_immediate((INT64)m_param[1].immediate() >> m_param[2].immediate());
+						convert_to_mov_immediate((INT64)m_param[1].immediate() >> (m_param[2].immediate() & 63));
 				}
 				else if (m_param[2].is_immediate_value(0))
 					convert_to_mov_param(1);
@@ -850,6 +855,60 @@ UINT8 uml::instruction::modified_flags() const
 }
 
 
+//-------------------------------------------------
+//  param_is_input - return true if the given
+//  parameter is read by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_input(int index) const
+{
+	assert(index < m_numparams);
+	return ((s_opcode_info_table[m_opcode].param[index].output & PIO_IN) != 0);
+}
+
+
+//-------------------------------------------------
+//  param_is_output - return true if the given
+//  parameter is written by the instruction
+//-------------------------------------------------
+
+bool uml::instruction::param_is_output(int index) const
+{
+	assert(index < m_numparams);
+	return ((s_opcode_info_table[m_opcode].param[index].output & PIO_OUT) != 0);
+}
+
+
+//-------------------------------------------------
+//  param_size - return the number of bytes of
+//  the given parameter that the instruction
+//  reads or writes
+//-------------------------------------------------
+
+UINT8 uml::instruction::param_size(int index) const
+{
+	assert(index < m_numparams);
+	UINT8 size = s_opcode_info_table[m_opcode].param[index].size;
+	if (size == PSIZE_OP)
+		return m_size;
+	if (size & 0x80)
+		return 1 << m_param[size - PSIZE_P1].size();
+	return 1 << size;
+}
+
+
+//-------------------------------------------------
+//  param_accepts - return true if the given
+//  parameter may be of the given type
+//-------------------------------------------------
+
+bool uml::instruction::param_accepts(int index, parameter::parameter_type type) const
+{
+	assert(index < m_numparams);
+	return (((s_opcode_info_table[m_opcode].param[index].typemask >> type) & 1) != 0);
+}
+
+
 //-------------------------------------------------
 //  disasm - disassemble an instruction to the
 //  given buffer
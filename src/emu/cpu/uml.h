@@ -274,6 +274,8 @@ namespace uml
 	// a parameter for a UML instructon is encoded like this
 	class parameter
 	{
+		friend class ::drcuml_state;
+
 	public:
 		// opcode parameter types
 		enum parameter_type
@@ -392,6 +394,8 @@ namespace uml
 	// a single UML instructon is encoded like this
 	class instruction
 	{
+		friend class ::drcuml_state;
+
 	public:
 		// construction/destruction
 		instruction();
@@ -404,9 +408,16 @@ namespace uml
 		UINT8 numparams() const { return m_numparams; }
 		const parameter &param(int index) const { assert(index < m_numparams); return m_param[index]; }
 
+		// parameter queries
+		bool param_is_input(int index) const;
+		bool param_is_output(int index) const;
+		UINT8 param_size(int index) const;
+		bool param_accepts(int index, parameter::parameter_type type) const;
+
 		// setters
 		void set_flags(UINT8 flags) { m_flags = flags; }
 		void set_mapvar(int paramnum, UINT32 value) { assert(paramnum < m_numparams); assert(m_param[paramnum].is_mapvar()); m_param[paramnum] = value; }
+		void set_param(int paramnum, const parameter &param) { assert(paramnum < m_numparams); assert(param_accepts(paramnum, param.type())); m_param[paramnum] = param; }
 
 		// misc
 		const char *disasm(astring &string, drcuml_state *drcuml = NULL) const;
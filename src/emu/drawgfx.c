@@ -504,7 +504,7 @@ void drawgfx_transpen(bitmap_ind16 &dest, const rectangle &cliprect, gfx_element
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_SKIP(UINT16, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY, BLOCK_SKIP_TRANSPEN);
 }
 
 void drawgfx_transpen(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element *gfx,
@@ -532,7 +532,7 @@ void drawgfx_transpen(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_SKIP(UINT32, PIXEL_OP_REMAP_TRANSPEN, NO_PRIORITY, BLOCK_SKIP_TRANSPEN);
 }
 
 
@@ -553,7 +553,7 @@ void drawgfx_transpen_raw(bitmap_ind16 &dest, const rectangle &cliprect, gfx_ele
 
 	// render
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_SKIP(UINT16, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY, BLOCK_SKIP_TRANSPEN);
 }
 
 void drawgfx_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element *gfx,
@@ -567,7 +567,7 @@ void drawgfx_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_ele
 
 	// render
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY);
+	DRAWGFX_CORE_SKIP(UINT32, PIXEL_OP_REBASE_TRANSPEN, NO_PRIORITY, BLOCK_SKIP_TRANSPEN);
 }
 
 
@@ -602,7 +602,7 @@ void drawgfx_transmask(bitmap_ind16 &dest, const rectangle &cliprect, gfx_elemen
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY);
+	DRAWGFX_CORE_SKIP(UINT16, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY, BLOCK_SKIP_TRANSMASK);
 }
 
 void drawgfx_transmask(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element *gfx,
@@ -630,7 +630,7 @@ void drawgfx_transmask(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_elemen
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY);
+	DRAWGFX_CORE_SKIP(UINT32, PIXEL_OP_REMAP_TRANSMASK, NO_PRIORITY, BLOCK_SKIP_TRANSMASK);
 }
 
 
@@ -650,7 +650,7 @@ void drawgfx_transtable(bitmap_ind16 &dest, const rectangle &cliprect, gfx_eleme
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
 	code %= gfx->elements();
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REMAP_TRANSTABLE16, NO_PRIORITY);
+	DRAWGFX_CORE_SKIP(UINT16, PIXEL_OP_REMAP_TRANSTABLE16, NO_PRIORITY, BLOCK_SKIP_TRANSTABLE);
 }
 
 void drawgfx_transtable(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element *gfx,
@@ -663,7 +663,7 @@ void drawgfx_transtable(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_eleme
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
 	code %= gfx->elements();
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSTABLE32, NO_PRIORITY);
+	DRAWGFX_CORE_SKIP(UINT32, PIXEL_OP_REMAP_TRANSTABLE32, NO_PRIORITY, BLOCK_SKIP_TRANSTABLE);
 }
 
 
@@ -689,7 +689,7 @@ void drawgfx_alpha(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element *g
 	// get final code and color, and grab lookup tables
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
 	DECLARE_NO_PRIORITY;
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY);
+	DRAWGFX_CORE_SKIP(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32, NO_PRIORITY, BLOCK_SKIP_TRANSPEN);
 }
 
 
@@ -1060,7 +1060,7 @@ void pdrawgfx_transpen(bitmap_ind16 &dest, const rectangle &cliprect, gfx_elemen
 
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_CORE_SKIP(UINT16, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8, BLOCK_SKIP_TRANSPEN);
 }
 
 void pdrawgfx_transpen(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element *gfx,
@@ -1090,7 +1090,7 @@ void pdrawgfx_transpen(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_elemen
 
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_CORE_SKIP(UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY, UINT8, BLOCK_SKIP_TRANSPEN);
 }
 
 
@@ -1113,7 +1113,7 @@ void pdrawgfx_transpen_raw(bitmap_ind16 &dest, const rectangle &cliprect, gfx_el
 	pmask |= 1 << 31;
 
 	// render
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_CORE_SKIP(UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8, BLOCK_SKIP_TRANSPEN);
 }
 
 void pdrawgfx_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element *gfx,
@@ -1129,7 +1129,7 @@ void pdrawgfx_transpen_raw(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_el
 	pmask |= 1 << 31;
 
 	// render
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8);
+	DRAWGFX_CORE_SKIP(UINT32, PIXEL_OP_REBASE_TRANSPEN_PRIORITY, UINT8, BLOCK_SKIP_TRANSPEN);
 }
 
 
@@ -1166,7 +1166,7 @@ void pdrawgfx_transmask(bitmap_ind16 &dest, const rectangle &cliprect, gfx_eleme
 
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, UINT8);
+	DRAWGFX_CORE_SKIP(UINT16, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, UINT8, BLOCK_SKIP_TRANSMASK);
 }
 
 void pdrawgfx_transmask(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element *gfx,
@@ -1196,7 +1196,7 @@ void pdrawgfx_transmask(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_eleme
 
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, UINT8);
+	DRAWGFX_CORE_SKIP(UINT32, PIXEL_OP_REMAP_TRANSMASK_PRIORITY, UINT8, BLOCK_SKIP_TRANSMASK);
 }
 
 
@@ -1219,7 +1219,7 @@ void pdrawgfx_transtable(bitmap_ind16 &dest, const rectangle &cliprect, gfx_elem
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
 	code %= gfx->elements();
-	DRAWGFX_CORE(UINT16, PIXEL_OP_REMAP_TRANSTABLE16_PRIORITY, UINT8);
+	DRAWGFX_CORE_SKIP(UINT16, PIXEL_OP_REMAP_TRANSTABLE16_PRIORITY, UINT8, BLOCK_SKIP_TRANSTABLE);
 }
 
 void pdrawgfx_transtable(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element *gfx,
@@ -1234,7 +1234,7 @@ void pdrawgfx_transtable(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_elem
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
 	code %= gfx->elements();
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSTABLE32_PRIORITY, UINT8);
+	DRAWGFX_CORE_SKIP(UINT32, PIXEL_OP_REMAP_TRANSTABLE32_PRIORITY, UINT8, BLOCK_SKIP_TRANSTABLE);
 }
 
 
@@ -1263,7 +1263,7 @@ void pdrawgfx_alpha(bitmap_rgb32 &dest, const rectangle &cliprect, gfx_element *
 
 	// render
 	const pen_t *paldata = &gfx->machine().pens[gfx->colorbase() + gfx->granularity() * (color % gfx->colors())];
-	DRAWGFX_CORE(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY, UINT8);
+	DRAWGFX_CORE_SKIP(UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY, UINT8, BLOCK_SKIP_TRANSPEN);
 }
 
 
@@ -313,6 +313,34 @@ do
 while (0)
 
 
+/***************************************************************************
+    BLOCK SKIP TESTS
+***************************************************************************/
+
+/*-------------------------------------------------
+    BLOCK_SKIP_* - given a pointer to 4 source
+    pixels, return true if the matching pixel op
+    would leave all of them untouched, so the
+    core can step over the whole block; these
+    are order-independent, so they work for
+    flipped blocks as well
+-------------------------------------------------*/
+
+#define BLOCK_SKIP_NONE(SOURCE)                                                     \
+	(false)
+
+#define BLOCK_SKIP_TRANSPEN(SOURCE)                                                 \
+	((((SOURCE)[0] ^ transpen) | ((SOURCE)[1] ^ transpen) | ((SOURCE)[2] ^ transpen) | ((SOURCE)[3] ^ transpen)) == 0)
+
+#define BLOCK_SKIP_TRANSMASK(SOURCE)                                                \
+	((((transmask >> (SOURCE)[0]) & (transmask >> (SOURCE)[1]) & (transmask >> (SOURCE)[2]) & (transmask >> (SOURCE)[3])) & 1) != 0)
+
+#define BLOCK_SKIP_TRANSTABLE(SOURCE)                                               \
+	(pentable[(SOURCE)[0]] == DRAWMODE_NONE && pentable[(SOURCE)[1]] == DRAWMODE_NONE && \
+		pentable[(SOURCE)[2]] == DRAWMODE_NONE && pentable[(SOURCE)[3]] == DRAWMODE_NONE)
+
+
+
 /***************************************************************************
     BASIC DRAWGFX CORE
 ***************************************************************************/
@@ -333,7 +361,7 @@ while (0)
 */
 
 
-#define DRAWGFX_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE)                               \
+#define DRAWGFX_CORE_SKIP(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, BLOCK_SKIP)              \
 do {                                                                                    \
 	g_profiler.start(PROFILER_DRAWGFX);                                                 \
 	do {                                                                                \
@@ -423,6 +451,14 @@ do {
 				/* iterate over unrolled blocks of 4 */                             \
 				for (curx = 0; curx < numblocks; curx++)                            \
 				{                                                                   \
+					/* skip blocks the operation would leave untouched */           \
+					if (BLOCK_SKIP(srcptr))                                         \
+					{                                                               \
+						srcptr += 4;                                                \
+						destptr += 4;                                               \
+						PRIORITY_ADVANCE(PRIORITY_TYPE, priptr, 4);                 \
+						continue;                                                   \
+					}                                                               \
 					PIXEL_OP(destptr[0], priptr[0], srcptr[0]);                     \
 					PIXEL_OP(destptr[1], priptr[1], srcptr[1]);                     \
 					PIXEL_OP(destptr[2], priptr[2], srcptr[2]);                     \
@@ -458,6 +494,14 @@ do {
 				/* iterate over unrolled blocks of 4 */                             \
 				for (curx = 0; curx < numblocks; curx++)                            \
 				{                                                                   \
+					/* skip blocks the operation would leave untouched */           \
+					if (BLOCK_SKIP(srcptr - 3))                                     \
+					{                                                               \
+						srcptr -= 4;                                                \
+						destptr += 4;                                               \
+						PRIORITY_ADVANCE(PRIORITY_TYPE, priptr, 4);                 \
+						continue;                                                   \
+					}                                                               \
 					PIXEL_OP(destptr[0], priptr[0], srcptr[ 0]);                    \
 					PIXEL_OP(destptr[1], priptr[1], srcptr[-1]);                    \
 					PIXEL_OP(destptr[2], priptr[2], srcptr[-2]);                    \
@@ -482,6 +526,9 @@ do {
 	g_profiler.stop();                                                                  \
 } while (0)
 
+#define DRAWGFX_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE) \
+	DRAWGFX_CORE_SKIP(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, BLOCK_SKIP_NONE)
+
 
 
 /***************************************************************************
@@ -44,6 +44,7 @@
 
 // machine-wide utilities
 #include "romload.h"
+#include "snapring.h"
 #include "save.h"
 
 // define machine_config_constructor here due to circular dependency
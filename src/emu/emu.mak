@@ -132,8 +132,10 @@ EMUOBJS = \
 	$(EMUOBJ)/rendutil.o \
 	$(EMUOBJ)/romload.o \
 	$(EMUOBJ)/save.o \
+	$(EMUOBJ)/savechunk.o \
 	$(EMUOBJ)/schedule.o \
 	$(EMUOBJ)/screen.o \
+	$(EMUOBJ)/snapring.o \
 	$(EMUOBJ)/softlist.o \
 	$(EMUOBJ)/sound.o \
 	$(EMUOBJ)/speaker.o \
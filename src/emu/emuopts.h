@@ -70,6 +70,8 @@ enum
 // core state/playback options
 #define OPTION_STATE                "state"
 #define OPTION_AUTOSAVE             "autosave"
+#define OPTION_REWIND               "rewind"
+#define OPTION_REWIND_CAPACITY      "rewind_capacity"
 #define OPTION_PLAYBACK             "playback"
 #define OPTION_RECORD               "record"
 #define OPTION_MNGWRITE             "mngwrite"
@@ -78,6 +80,7 @@ enum
 #define OPTION_SNAPNAME             "snapname"
 #define OPTION_SNAPSIZE             "snapsize"
 #define OPTION_SNAPVIEW             "snapview"
+#define OPTION_MOVIEDROP            "moviedrop"
 #define OPTION_STATENAME            "statename"
 #define OPTION_BURNIN               "burnin"
 
@@ -123,6 +126,7 @@ enum
 #define OPTION_SOUND                "sound"
 #define OPTION_SAMPLERATE           "samplerate"
 #define OPTION_SAMPLES              "samples"
+#define OPTION_SINC_RESAMPLE        "sinc_resample"
 #define OPTION_VOLUME               "volume"
 
 // core input options
@@ -164,6 +168,7 @@ enum
 // core misc options
 #define OPTION_DRC                  "drc"
 #define OPTION_DRC_USE_C            "drc_use_c"
+#define OPTION_DRC_CACHE            "drc_cache"
 #define OPTION_BIOS                 "bios"
 #define OPTION_CHEAT                "cheat"
 #define OPTION_SKIP_GAMEINFO        "skip_gameinfo"
@@ -236,6 +241,8 @@ public:
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
 	bool autosave() const { return bool_value(OPTION_AUTOSAVE); }
+	bool rewind() const { return bool_value(OPTION_REWIND); }
+	int rewind_capacity() const { return int_value(OPTION_REWIND_CAPACITY); }
 	const char *playback() const { return value(OPTION_PLAYBACK); }
 	const char *record() const { return value(OPTION_RECORD); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
@@ -244,6 +251,7 @@ public:
 	const char *snap_name() const { return value(OPTION_SNAPNAME); }
 	const char *snap_size() const { return value(OPTION_SNAPSIZE); }
 	const char *snap_view() const { return value(OPTION_SNAPVIEW); }
+	bool movie_drop() const { return bool_value(OPTION_MOVIEDROP); }
 	const char *state_name() const { return value(OPTION_STATENAME); }
 	bool burnin() const { return bool_value(OPTION_BURNIN); }
 
@@ -289,6 +297,7 @@ public:
 	bool sound() const { return bool_value(OPTION_SOUND); }
 	int sample_rate() const { return int_value(OPTION_SAMPLERATE); }
 	bool samples() const { return bool_value(OPTION_SAMPLES); }
+	bool sinc_resample() const { return bool_value(OPTION_SINC_RESAMPLE); }
 	int volume() const { return int_value(OPTION_VOLUME); }
 
 	// core input options
@@ -328,6 +337,7 @@ public:
 	// core misc options
 	bool drc() const { return bool_value(OPTION_DRC); }
 	bool drc_use_c() const { return bool_value(OPTION_DRC_USE_C); }
+	bool drc_cache() const { return bool_value(OPTION_DRC_CACHE); }
 	const char *bios() const { return value(OPTION_BIOS); }
 	bool cheat() const { return bool_value(OPTION_CHEAT); }
 	bool skip_gameinfo() const { return bool_value(OPTION_SKIP_GAMEINFO); }
@@ -164,6 +164,8 @@ running_machine::running_machine(const machine_config &_config, osd_interface &o
 		m_saveload_schedule(SLS_NONE),
 		m_saveload_schedule_time(attotime::zero),
 		m_saveload_searchpath(NULL),
+		m_rewind_enabled(false),
+		m_rewind_frame(~UINT64(0)),
 		m_logerror_list(m_respool),
 
 		m_save(*this),
@@ -336,6 +338,11 @@ void running_machine::start()
 
 	// disallow save state registrations starting here
 	m_save.allow_registration(false);
+
+	// now that the state is complete, set aside room for rewinding it
+	m_rewind_enabled = options().rewind();
+	if (m_rewind_enabled)
+		m_save.snapshot_allocate(UINT32(options().rewind_capacity()) * 1024 * 1024);
 }
 
 
@@ -420,6 +427,10 @@ int running_machine::run(bool firstrun)
 			if (m_saveload_schedule != SLS_NONE)
 				handle_saveload();
 
+			// otherwise keep the rewind snapshots up to date
+			else if (m_rewind_enabled && !m_paused)
+				rewind_capture();
+
 			g_profiler.stop();
 		}
 
@@ -720,6 +731,28 @@ void running_machine::schedule_load(const char *filename)
 }
 
 
+//-------------------------------------------------
+//  schedule_rewind - schedule a step back to the
+//  previous rewind snapshot
+//-------------------------------------------------
+
+void running_machine::schedule_rewind()
+{
+	if (!m_rewind_enabled)
+	{
+		popmessage("Rewind is disabled; enable it with -%s.", OPTION_REWIND);
+		return;
+	}
+
+	// note the start time and set a timer for the next timeslice to actually schedule it
+	m_saveload_schedule = SLS_REWIND;
+	m_saveload_schedule_time = this->time();
+
+	// we can't be paused since we need to clear out anonymous timers
+	resume();
+}
+
+
 //-------------------------------------------------
 //  immediate_load - load state.
 //-------------------------------------------------
@@ -897,6 +930,13 @@ void running_machine::call_notifiers(machine_notification which)
 
 void running_machine::handle_saveload()
 {
+	// rewinding works from memory instead of a file
+	if (m_saveload_schedule == SLS_REWIND)
+	{
+		handle_rewind();
+		return;
+	}
+
 	UINT32 openflags = (m_saveload_schedule == SLS_LOAD) ? OPEN_FLAG_READ : (OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
 	const char *opnamed = (m_saveload_schedule == SLS_LOAD) ? "loaded" : "saved";
 	const char *opname = (m_saveload_schedule == SLS_LOAD) ? "load" : "save";
@@ -946,6 +986,10 @@ void running_machine::handle_saveload()
 				popmessage("Error: Unable to %s state due to a write error. Verify there is enough disk space.", opname);
 				break;
 
+			case STATERR_TOO_LARGE:
+				popmessage("Error: Unable to %s state because it is too large. See error.log for details.", opname);
+				break;
+
 			case STATERR_NONE:
 				if (!(m_system.flags & GAME_SUPPORTS_SAVE))
 					popmessage("State successfully %s.\nWarning: Save states are not officially supported for this game.", opnamed);
@@ -973,6 +1017,70 @@ cancel:
 }
 
 
+//-------------------------------------------------
+//  handle_rewind - attempt to step back to the
+//  previous rewind snapshot
+//-------------------------------------------------
+
+void running_machine::handle_rewind()
+{
+	// as with loads, anonymous timers might overwrite the data we restore
+	if (!m_scheduler.can_save())
+	{
+		if ((this->time() - m_saveload_schedule_time) > attotime::from_seconds(1))
+		{
+			popmessage("Unable to rewind due to pending anonymous timers. See error.log for details.");
+			m_saveload_schedule = SLS_NONE;
+		}
+		return;
+	}
+
+	// the newest snapshot is the current frame, so go back one from there
+	switch (m_save.snapshot_load(1))
+	{
+		case STATERR_NONE:
+			break;
+
+		case STATERR_ILLEGAL_REGISTRATIONS:
+			popmessage("Error: Unable to rewind due to illegal registrations. See error.log for details.");
+			break;
+
+		default:
+			popmessage("Unable to rewind any further.");
+			break;
+	}
+
+	// stay on this frame until asked to move on, and don't snapshot it again
+	if (primary_screen != NULL)
+		m_rewind_frame = primary_screen->frame_number();
+	m_saveload_schedule = SLS_NONE;
+	pause();
+}
+
+
+//-------------------------------------------------
+//  rewind_capture - take a rewind snapshot once
+//  per frame of the primary screen
+//-------------------------------------------------
+
+void running_machine::rewind_capture()
+{
+	if (primary_screen == NULL || primary_screen->frame_number() == m_rewind_frame)
+		return;
+	m_rewind_frame = primary_screen->frame_number();
+
+	// if there are anonymous timers, skip this frame rather than wait for them
+	if (!m_scheduler.can_save())
+		return;
+
+	if (m_save.snapshot_save() != STATERR_NONE)
+	{
+		popmessage("Error: Unable to rewind due to illegal registrations. See error.log for details.");
+		m_rewind_enabled = false;
+	}
+}
+
+
 //-------------------------------------------------
 //  soft_reset - actually perform a soft-reset
 //  of the system
@@ -246,6 +246,7 @@ public:
 	void schedule_new_driver(const game_driver &driver);
 	void schedule_save(const char *filename);
 	void schedule_load(const char *filename);
+	void schedule_rewind();
 
 	// date & time
 	void base_datetime(system_time &systime);
@@ -291,6 +292,8 @@ private:
 	astring get_statename(const char *statename_opt);
 	void fill_systime(system_time &systime, time_t t);
 	void handle_saveload();
+	void handle_rewind();
+	void rewind_capture();
 	void soft_reset(void *ptr = NULL, INT32 param = 0);
 	void watchdog_fired(void *ptr = NULL, INT32 param = 0);
 	void watchdog_vblank(screen_device &screen, bool vblank_state);
@@ -349,12 +352,15 @@ private:
 	{
 		SLS_NONE,
 		SLS_SAVE,
-		SLS_LOAD
+		SLS_LOAD,
+		SLS_REWIND
 	};
 	saveload_schedule       m_saveload_schedule;
 	attotime                m_saveload_schedule_time;
 	astring                 m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
+	bool                    m_rewind_enabled;       // are we keeping rewind snapshots?
+	UINT64                  m_rewind_frame;         // primary screen frame of the last snapshot
 
 	// notifier callbacks
 	struct notifier_callback_item
@@ -12,7 +12,11 @@
 // ----------------------------------------------------------------------------------------
 
 netlist_base_t::netlist_base_t()
-	: m_mainclock(NULL),
+	: m_perf_out_processed(0),
+		m_perf_inp_processed(0),
+		m_perf_inp_active(0),
+		m_perf_ticks(0),
+		m_mainclock(NULL),
 		m_time_ps(netlist_time::zero),
 		m_rem(0),
 		m_div(NETLIST_DIV)
@@ -66,6 +70,9 @@ ATTR_HOT ATTR_ALIGN inline void netlist_base_t::update_time(const netlist_time t
 
 ATTR_HOT ATTR_ALIGN void netlist_base_t::process_queue(INT32 &atime)
 {
+	if (NL_KEEP_STATISTICS)
+		m_perf_ticks -= osd_ticks();
+
 	if (m_mainclock == NULL)
 	{
 		while ( (atime > 0) && (m_queue.is_not_empty()))
@@ -129,6 +136,9 @@ ATTR_HOT ATTR_ALIGN void netlist_base_t::process_queue(INT32 &atime)
 			atime = 0;
 		}
 	}
+
+	if (NL_KEEP_STATISTICS)
+		m_perf_ticks += osd_ticks();
 }
 
 // ----------------------------------------------------------------------------------------
@@ -320,9 +330,17 @@ ATTR_HOT inline void net_output_t::update_devs()
 
 	const UINT32 mask = masks[ (m_last_Q  << 1) | m_Q ];
 
+	/* register_con keeps the inputs of one device together; a device
+	 * listening on several of them is only updated once per event
+	 */
 	switch (m_num_cons)
 	{
 	case 2:
+		if (m_cons[0]->netdev() == m_cons[1]->netdev())
+		{
+			update_dev(((m_cons[1]->state() & mask) != 0) ? m_cons[1] : m_cons[0], mask);
+			break;
+		}
 		update_dev(m_cons[1], mask);
 	case 1:
 		update_dev(m_cons[0], mask);
@@ -330,7 +348,16 @@ ATTR_HOT inline void net_output_t::update_devs()
 	default:
 		{
 			for (int i=0; i < m_num_cons; i++)
-				update_dev(m_cons[i], mask);
+			{
+				const net_input_t *inp = m_cons[i];
+				while (i + 1 < m_num_cons && m_cons[i + 1]->netdev() == inp->netdev())
+				{
+					if ((inp->state() & mask) == 0)
+						inp = m_cons[i + 1];
+					i++;
+				}
+				update_dev(inp, mask);
+			}
 		}
 		break;
 	}
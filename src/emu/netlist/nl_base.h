@@ -538,7 +538,7 @@ class netlist_base_t
 {
 public:
 
-	typedef netlist_timed_queue1<net_output_t, netlist_time, 512> queue_t;
+	typedef netlist_timed_queue_wheel<net_output_t, netlist_time, 512, 10> queue_t;
 
 	netlist_base_t();
 	virtual ~netlist_base_t();
@@ -558,6 +558,10 @@ public:
 
 	ATTR_COLD void reset();
 
+	// statistics, only kept with NL_KEEP_STATISTICS
+	ATTR_COLD int perf_out_processed() const { return m_perf_out_processed; }
+	ATTR_COLD osd_ticks_t perf_ticks() const { return m_perf_ticks; }
+
 	// FIXME: should'nt be public
 	queue_t m_queue;
 
@@ -566,6 +570,7 @@ protected:
 	int m_perf_out_processed;
 	int m_perf_inp_processed;
 	int m_perf_inp_active;
+	osd_ticks_t m_perf_ticks;
 
 private:
 	NETLIB_NAME(netdev_mainclock) *m_mainclock;
@@ -130,5 +130,148 @@ private:
 
 };
 
+// ----------------------------------------------------------------------------------------
+// timing wheel
+//
+// Events less than 1 << _WheelBits raw time units after the last one popped
+// go into a wheel with one slot per time unit. Each slot is a LIFO chain, so
+// pushing them is O(1). Anything further out falls back to a sorted
+// netlist_timed_queue1.
+// Equal times still come out newest first, as with netlist_timed_queue1:
+// an overflow entry for a given time is always older than any wheel entry
+// for it, so ties go to the wheel.
+// ----------------------------------------------------------------------------------------
+
+template <class _Element, class _Time, int _Size, int _WheelBits>
+class netlist_timed_queue_wheel
+{
+public:
+
+	typedef typename netlist_timed_queue1<_Element, _Time, _Size>::entry_t entry_t;
+
+	netlist_timed_queue_wheel()
+	: m_prof_wheel(0), m_prof_overflow(0)
+	{
+		clear();
+	}
+
+	ATTR_HOT inline bool is_empty() const { return (m_count == 0 && m_overflow.is_empty()); }
+	ATTR_HOT inline bool is_not_empty() const { return !is_empty(); }
+
+	ATTR_HOT inline void push(const entry_t &e)
+	{
+		const UINT64 raw = e.time().as_raw();
+		if (raw - m_base < WHEEL_SIZE)
+		{
+			const int slot = raw & WHEEL_MASK;
+			const int node = m_free;
+			assert(node >= 0);
+			m_free = m_next[node];
+
+			m_entry[node] = e;
+			m_next[node] = m_head[slot];
+			m_head[slot] = node;
+			m_used[slot >> 5] |= 1U << (slot & 31);
+			m_count++;
+			inc_stat(m_prof_wheel);
+		}
+		else
+		{
+			m_overflow.push(e);
+			inc_stat(m_prof_overflow);
+		}
+	}
+
+	ATTR_HOT inline const entry_t pop()
+	{
+		const int slot = first_slot();
+		if (slot < 0 || (m_overflow.is_not_empty() && m_overflow.peek().time() < m_entry[m_head[slot]].time()))
+		{
+			const entry_t e = m_overflow.pop();
+			m_base = e.time().as_raw();
+			return e;
+		}
+
+		const int node = m_head[slot];
+		const entry_t e = m_entry[node];
+		m_head[slot] = m_next[node];
+		if (m_head[slot] < 0)
+			m_used[slot >> 5] &= ~(1U << (slot & 31));
+		m_next[node] = m_free;
+		m_free = node;
+		m_count--;
+		m_base = e.time().as_raw();
+		return e;
+	}
+
+	ATTR_HOT inline const entry_t peek() const
+	{
+		const int slot = first_slot();
+		if (slot < 0 || (m_overflow.is_not_empty() && m_overflow.peek().time() < m_entry[m_head[slot]].time()))
+			return m_overflow.peek();
+		return m_entry[m_head[slot]];
+	}
+
+	ATTR_COLD void clear()
+	{
+		m_overflow.clear();
+		m_base = 0;
+		m_count = 0;
+		for (int i = 0; i < WHEEL_SIZE; i++)
+			m_head[i] = -1;
+		for (int i = 0; i < WHEEL_WORDS; i++)
+			m_used[i] = 0;
+		for (int i = 0; i < _Size; i++)
+			m_next[i] = i + 1;
+		m_next[_Size - 1] = -1;
+		m_free = 0;
+	}
+
+	// profiling
+
+	INT32   m_prof_wheel;
+	INT32   m_prof_overflow;
+
+private:
+
+	enum
+	{
+		WHEEL_SIZE = 1 << _WheelBits,
+		WHEEL_MASK = WHEEL_SIZE - 1,
+		WHEEL_WORDS = WHEEL_SIZE / 32
+	};
+
+	// the occupied slot holding the earliest time, scanning forward from the base
+	ATTR_HOT inline int first_slot() const
+	{
+		if (m_count == 0)
+			return -1;
+
+		const int start = m_base & WHEEL_MASK;
+		int word = start >> 5;
+		UINT32 bits = m_used[word] & (~0U << (start & 31));
+
+		// one extra step picks up the slots just before the start, which wrapped around
+		for (int i = 0; i <= WHEEL_WORDS; i++)
+		{
+			if (bits != 0)
+				return (word << 5) | (31 - count_leading_zeros(bits & -bits));
+			word = (word + 1) & (WHEEL_WORDS - 1);
+			bits = m_used[word];
+		}
+		return -1;
+	}
+
+	UINT64 m_base;                      // time of the last event popped
+	int m_count;                        // number of events in the wheel
+	int m_free;                         // first unused node
+	int m_head[WHEEL_SIZE];             // newest node for each slot, or -1
+	UINT32 m_used[WHEEL_WORDS];         // one bit per non-empty slot
+	int m_next[_Size];                  // next node in the slot or free chain
+	entry_t m_entry[_Size];
+
+	netlist_timed_queue1<_Element, _Time, _Size> m_overflow;
+};
+
 
 #endif /* NLLISTS_H_ */
@@ -309,9 +309,12 @@ void netlist_setup_t::print_stats()
 			//entry->object()->s
 			printf("Device %20s : %12d %15ld\n", entry->object()->name().cstr(), entry->object()->stat_count, (long int) entry->object()->total_time / (entry->object()->stat_count + 1));
 		}
-		printf("Queue Start %15d\n", m_netlist.m_queue.m_prof_start);
-		printf("Queue End   %15d\n", m_netlist.m_queue.m_prof_end);
-		printf("Queue Sort  %15d\n", m_netlist.m_queue.m_prof_sort);
-		printf("Queue Move  %15d\n", m_netlist.m_queue.m_prof_sortmove);
+		printf("Queue Wheel    %15d\n", m_netlist.m_queue.m_prof_wheel);
+		printf("Queue Overflow %15d\n", m_netlist.m_queue.m_prof_overflow);
+
+		/* events per second of host time spent in process_queue */
+		double seconds = (double) m_netlist.perf_ticks() / (double) osd_ticks_per_second();
+		printf("Events      %15d in %.3f s: %.0f events/s\n", m_netlist.perf_out_processed(), seconds,
+				(seconds > 0) ? m_netlist.perf_out_processed() / seconds : 0.0);
 	}
 }
@@ -44,6 +44,37 @@ struct profile_string
 
 profiler_state g_profiler;
 
+static const profile_string s_names[] =
+{
+	{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
+	{ PROFILER_MEM_REMAP,        "Memory Remapping" },
+	{ PROFILER_MEMREAD,          "Memory Read" },
+	{ PROFILER_MEMWRITE,         "Memory Write" },
+	{ PROFILER_VIDEO,            "Video Update" },
+	{ PROFILER_DRAWGFX,          "drawgfx" },
+	{ PROFILER_COPYBITMAP,       "copybitmap" },
+	{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
+	{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
+	{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
+	{ PROFILER_BLIT,             "OSD Blitting" },
+	{ PROFILER_SOUND,            "Sound Generation" },
+	{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
+	{ PROFILER_INPUT,            "Input Processing" },
+	{ PROFILER_MOVIE_REC,        "Movie Recording" },
+	{ PROFILER_LOGERROR,         "Error Logging" },
+	{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
+	{ PROFILER_USER1,            "User 1" },
+	{ PROFILER_USER2,            "User 2" },
+	{ PROFILER_USER3,            "User 3" },
+	{ PROFILER_USER4,            "User 4" },
+	{ PROFILER_USER5,            "User 5" },
+	{ PROFILER_USER6,            "User 6" },
+	{ PROFILER_USER7,            "User 7" },
+	{ PROFILER_USER8,            "User 8" },
+	{ PROFILER_PROFILER,         "Profiler" },
+	{ PROFILER_IDLE,             "Idle" }
+};
+
 
 
 //**************************************************************************
@@ -95,8 +126,9 @@ void real_profiler_state::reset(bool enabled)
 
 	if (enabled)
 	{
-		// we're enabled now
+		// we're enabled now; discard anything left over from a previous run
 		m_filoptr = m_filo;
+		memset(m_data, 0, sizeof(m_data));
 
 		// set up dummy entry
 		m_filoptr->start = 0;
@@ -111,6 +143,21 @@ void real_profiler_state::reset(bool enabled)
 
 
 
+//-------------------------------------------------
+//  type_name - return the display name of a
+//  non-device profiler type
+//-------------------------------------------------
+
+const char *real_profiler_state::type_name(profile_type type)
+{
+	for (int nameindex = 0; nameindex < ARRAY_LENGTH(s_names); nameindex++)
+		if (s_names[nameindex].type == type)
+			return s_names[nameindex].string;
+	return "";
+}
+
+
+
 //-------------------------------------------------
 //  text - return the current text in an astring
 //-------------------------------------------------
@@ -141,37 +188,6 @@ const char *real_profiler_state::text(running_machine &machine)
 
 void real_profiler_state::update_text(running_machine &machine)
 {
-	static const profile_string names[] =
-	{
-		{ PROFILER_DRC_COMPILE,      "DRC Compilation" },
-		{ PROFILER_MEM_REMAP,        "Memory Remapping" },
-		{ PROFILER_MEMREAD,          "Memory Read" },
-		{ PROFILER_MEMWRITE,         "Memory Write" },
-		{ PROFILER_VIDEO,            "Video Update" },
-		{ PROFILER_DRAWGFX,          "drawgfx" },
-		{ PROFILER_COPYBITMAP,       "copybitmap" },
-		{ PROFILER_TILEMAP_DRAW,     "Tilemap Draw" },
-		{ PROFILER_TILEMAP_DRAW_ROZ, "Tilemap ROZ Draw" },
-		{ PROFILER_TILEMAP_UPDATE,   "Tilemap Update" },
-		{ PROFILER_BLIT,             "OSD Blitting" },
-		{ PROFILER_SOUND,            "Sound Generation" },
-		{ PROFILER_TIMER_CALLBACK,   "Timer Callbacks" },
-		{ PROFILER_INPUT,            "Input Processing" },
-		{ PROFILER_MOVIE_REC,        "Movie Recording" },
-		{ PROFILER_LOGERROR,         "Error Logging" },
-		{ PROFILER_EXTRA,            "Unaccounted/Overhead" },
-		{ PROFILER_USER1,            "User 1" },
-		{ PROFILER_USER2,            "User 2" },
-		{ PROFILER_USER3,            "User 3" },
-		{ PROFILER_USER4,            "User 4" },
-		{ PROFILER_USER5,            "User 5" },
-		{ PROFILER_USER6,            "User 6" },
-		{ PROFILER_USER7,            "User 7" },
-		{ PROFILER_USER8,            "User 8" },
-		{ PROFILER_PROFILER,         "Profiler" },
-		{ PROFILER_IDLE,             "Idle" }
-	};
-
 	// compute the total time for all bits, not including profiler or idle
 	UINT64 computed = 0;
 	profile_type curtype;
@@ -212,12 +228,7 @@ void real_profiler_state::update_text(running_machine &machine)
 			if (curtype >= PROFILER_DEVICE_FIRST && curtype <= PROFILER_DEVICE_MAX)
 				m_text.catprintf("'%s'", iter.byindex(curtype - PROFILER_DEVICE_FIRST)->tag());
 			else
-				for (int nameindex = 0; nameindex < ARRAY_LENGTH(names); nameindex++)
-					if (names[nameindex].type == curtype)
-					{
-						m_text.cat(names[nameindex].string);
-						break;
-					}
+				m_text.cat(type_name(curtype));
 
 			// followed by a carriage return
 			m_text.cat("\n");
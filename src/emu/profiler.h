@@ -98,6 +98,8 @@ public:
 #endif
 	}
 	const char *text(running_machine &machine);
+	osd_ticks_t data(profile_type type) const { return m_data[type]; }
+	static const char *type_name(profile_type type);
 
 	// enable/disable
 	void enable(bool state = true)
@@ -189,6 +191,8 @@ public:
 	// getters
 	bool enabled() const { return false; }
 	const char *text(running_machine &machine) { return ""; }
+	osd_ticks_t data(profile_type type) const { return 0; }
+	static const char *type_name(profile_type type) { return ""; }
 
 	// enable/disable
 	void enable(bool state = true) { }
@@ -338,10 +338,10 @@ render_texture::render_texture()
 		m_osddata(~0L),
 		m_scaler(NULL),
 		m_param(NULL),
-		m_curseq(0)
+		m_curseq(0),
+		m_scaled(NULL)
 {
 	m_sbounds.set(0, -1, 0, -1);
-	memset(m_scaled, 0, sizeof(m_scaled));
 }
 
 
@@ -380,13 +380,7 @@ void render_texture::reset(render_manager &manager, texture_scaler_func scaler,
 void render_texture::release()
 {
 	// free all scaled versions
-	for (int scalenum = 0; scalenum < ARRAY_LENGTH(m_scaled); scalenum++)
-	{
-		m_manager->invalidate_all(m_scaled[scalenum].bitmap);
-		auto_free(m_manager->machine(), m_scaled[scalenum].bitmap);
-		m_scaled[scalenum].bitmap = NULL;
-		m_scaled[scalenum].seqid = 0;
-	}
+	free_scaled();
 
 	// invalidate references to the original bitmap as well
 	m_manager->invalidate_all(m_bitmap);
@@ -424,16 +418,7 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	m_format = format;
 
 	// invalidate all scaled versions
-	for (int scalenum = 0; scalenum < ARRAY_LENGTH(m_scaled); scalenum++)
-	{
-		if (m_scaled[scalenum].bitmap != NULL)
-		{
-			m_manager->invalidate_all(m_scaled[scalenum].bitmap);
-			auto_free(m_manager->machine(), m_scaled[scalenum].bitmap);
-		}
-		m_scaled[scalenum].bitmap = NULL;
-		m_scaled[scalenum].seqid = 0;
-	}
+	free_scaled();
 }
 
 
@@ -486,46 +471,35 @@ bool render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 	bitmap_argb32 &srcbitmap = (m_bitmap != NULL) ? downcast<bitmap_argb32 &>(*m_bitmap) : dummy;
 
 	// is it a size we already have?
-	scaled_texture *scaled = NULL;
-	int scalenum;
-	for (scalenum = 0; scalenum < ARRAY_LENGTH(m_scaled); scalenum++)
-	{
-		scaled = &m_scaled[scalenum];
-
-		// we need a non-NULL bitmap with matching dest size
-		if (scaled->bitmap != NULL && dwidth == scaled->bitmap->width() && dheight == scaled->bitmap->height())
+	scaled_texture *scaled;
+	for (scaled = m_scaled; scaled != NULL; scaled = scaled->next)
+		if (dwidth == scaled->bitmap->width() && dheight == scaled->bitmap->height())
 			break;
-	}
 
-	// did we get one?
-	if (scalenum == ARRAY_LENGTH(m_scaled))
+	// if so, mark it as recently used
+	if (scaled != NULL)
 	{
-		int lowest = -1;
-
-		// didn't find one -- take the entry with the lowest seqnum
-		for (scalenum = 0; scalenum < ARRAY_LENGTH(m_scaled); scalenum++)
-			if ((lowest == -1 || m_scaled[scalenum].seqid < m_scaled[lowest].seqid) && !primlist.has_reference(m_scaled[scalenum].bitmap))
-				lowest = scalenum;
-		assert_always(lowest != -1, "Too many live texture instances!");
-
-		// throw out any existing entries
-		scaled = &m_scaled[lowest];
-		if (scaled->bitmap != NULL)
-		{
-			m_manager->invalidate_all(scaled->bitmap);
-			auto_free(m_manager->machine(), scaled->bitmap);
-		}
+		m_manager->scaled_cache_touch(*scaled);
+		primlist.add_reference(scaled->bitmap);
+	}
 
-		// allocate a new bitmap
+	// otherwise, allocate a new bitmap and let the scaler do the work
+	else
+	{
+		scaled = auto_alloc(m_manager->machine(), scaled_texture);
+		scaled->owner = this;
+		scaled->next = m_scaled;
 		scaled->bitmap = auto_alloc(m_manager->machine(), bitmap_argb32(dwidth, dheight));
 		scaled->seqid = ++m_curseq;
-
-		// let the scaler do the work
+		m_scaled = scaled;
 		(*m_scaler)(*scaled->bitmap, srcbitmap, m_sbounds, m_param);
+
+		// reference it before adding, so making room can't evict it
+		primlist.add_reference(scaled->bitmap);
+		m_manager->scaled_cache_add(*scaled);
 	}
 
 	// finally fill out the new info
-	primlist.add_reference(scaled->bitmap);
 	texinfo.base = &scaled->bitmap->pix32(0);
 	texinfo.rowpixels = scaled->bitmap->rowpixels();
 	texinfo.width = dwidth;
@@ -536,6 +510,22 @@ bool render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 }
 
 
+//-------------------------------------------------
+//  free_scaled - free all scaled variants of
+//  this texture
+//-------------------------------------------------
+
+void render_texture::free_scaled()
+{
+	// these are ours, so drop any lists still drawing from them
+	while (m_scaled != NULL)
+	{
+		m_manager->invalidate_all(m_scaled->bitmap);
+		m_manager->scaled_cache_free(*m_scaled);
+	}
+}
+
+
 //-------------------------------------------------
 //  get_adjusted_palette - return the adjusted
 //  palette for a texture
@@ -1470,6 +1460,27 @@ void render_target::invalidate_all(void *refptr)
 }
 
 
+//-------------------------------------------------
+//  is_referenced - return true if any of our
+//  primitive lists refer to the given pointer
+//-------------------------------------------------
+
+bool render_target::is_referenced(void *refptr)
+{
+	for (int listnum = 0; listnum < ARRAY_LENGTH(m_primlist); listnum++)
+	{
+		render_primitive_list &list = m_primlist[listnum];
+
+		list.acquire_lock();
+		bool result = list.has_reference(refptr);
+		list.release_lock();
+		if (result)
+			return true;
+	}
+	return false;
+}
+
+
 //-------------------------------------------------
 //  debug_alloc - allocate a container for a debug
 //  view
@@ -2416,8 +2427,14 @@ render_manager::render_manager(running_machine &machine)
 		m_ui_target(NULL),
 		m_live_textures(0),
 		m_texture_allocator(machine.respool()),
+		m_scaled_head(NULL),
+		m_scaled_tail(NULL),
+		m_scaled_bytes(0),
+		m_scaled_hits(0),
+		m_scaled_misses(0),
 		m_ui_container(auto_alloc(machine, render_container(*this))),
-		m_screen_container_list(machine.respool())
+		m_screen_container_list(machine.respool()),
+		m_work_queue(NULL)
 {
 	// register callbacks
 	config_register(machine, "video", config_saveload_delegate(FUNC(render_manager::config_load), this), config_saveload_delegate(FUNC(render_manager::config_save), this));
@@ -2441,6 +2458,10 @@ render_manager::~render_manager()
 
 	// better not be any outstanding textures when we die
 	assert(m_live_textures == 0);
+
+	// free the software renderer's band queue; bands never outlive a draw
+	if (m_work_queue != NULL)
+		osd_work_queue_free(m_work_queue);
 }
 
 
@@ -2574,6 +2595,94 @@ void render_manager::texture_free(render_texture *texture)
 }
 
 
+//-------------------------------------------------
+//  scaled_cache_add - add a freshly scaled bitmap
+//  to the cache, then evict the least recently
+//  used ones until we fit again
+//-------------------------------------------------
+
+void render_manager::scaled_cache_add(render_texture::scaled_texture &scaled)
+{
+	m_scaled_misses++;
+
+	// link at the head
+	scaled.lru_prev = NULL;
+	scaled.lru_next = m_scaled_head;
+	if (m_scaled_head != NULL)
+		m_scaled_head->lru_prev = &scaled;
+	else
+		m_scaled_tail = &scaled;
+	m_scaled_head = &scaled;
+	m_scaled_bytes += UINT64(scaled.bitmap->rowbytes()) * scaled.bitmap->height();
+
+	// evict from the tail, skipping anything a primitive list on any target still
+	// draws from; if everything is in use we run over the limit until it isn't
+	render_texture::scaled_texture *victim = m_scaled_tail;
+	while (m_scaled_bytes > SCALED_CACHE_BYTES && victim != NULL)
+	{
+		render_texture::scaled_texture *prev = victim->lru_prev;
+		if (!is_referenced(victim->bitmap))
+			scaled_cache_free(*victim);
+		victim = prev;
+	}
+}
+
+
+//-------------------------------------------------
+//  scaled_cache_touch - note a cache hit, moving
+//  the bitmap to the head of the LRU list
+//-------------------------------------------------
+
+void render_manager::scaled_cache_touch(render_texture::scaled_texture &scaled)
+{
+	m_scaled_hits++;
+	if (m_scaled_head == &scaled)
+		return;
+
+	// unlink; we're not the head so we have a predecessor
+	scaled.lru_prev->lru_next = scaled.lru_next;
+	if (scaled.lru_next != NULL)
+		scaled.lru_next->lru_prev = scaled.lru_prev;
+	else
+		m_scaled_tail = scaled.lru_prev;
+
+	// relink at the head
+	scaled.lru_prev = NULL;
+	scaled.lru_next = m_scaled_head;
+	m_scaled_head->lru_prev = &scaled;
+	m_scaled_head = &scaled;
+}
+
+
+//-------------------------------------------------
+//  scaled_cache_free - remove a scaled bitmap from
+//  the cache and from its texture, and free it;
+//  the caller makes sure nothing references it
+//-------------------------------------------------
+
+void render_manager::scaled_cache_free(render_texture::scaled_texture &scaled)
+{
+	// unlink from the LRU list
+	if (scaled.lru_prev != NULL)
+		scaled.lru_prev->lru_next = scaled.lru_next;
+	else
+		m_scaled_head = scaled.lru_next;
+	if (scaled.lru_next != NULL)
+		scaled.lru_next->lru_prev = scaled.lru_prev;
+	else
+		m_scaled_tail = scaled.lru_prev;
+	m_scaled_bytes -= UINT64(scaled.bitmap->rowbytes()) * scaled.bitmap->height();
+
+	// unlink from the owning texture's list
+	render_texture::scaled_texture **curptr;
+	for (curptr = &scaled.owner->m_scaled; *curptr != &scaled; curptr = &(*curptr)->next) ;
+	*curptr = scaled.next;
+
+	auto_free(machine(), scaled.bitmap);
+	auto_free(machine(), &scaled);
+}
+
+
 //-------------------------------------------------
 //  font_alloc - allocate a new font instance
 //-------------------------------------------------
@@ -2611,6 +2720,40 @@ void render_manager::invalidate_all(void *refptr)
 }
 
 
+//-------------------------------------------------
+//  is_referenced - return true if any target's
+//  primitive lists refer to the given pointer
+//-------------------------------------------------
+
+bool render_manager::is_referenced(void *refptr)
+{
+	for (render_target *target = m_targetlist.first(); target != NULL; target = target->next())
+		if (target->is_referenced(refptr))
+			return true;
+	return false;
+}
+
+
+//-------------------------------------------------
+//  work_queue - return the queue the software
+//  renderer draws bands on, allocating it the
+//  first time it is needed; may return NULL, in
+//  which case targets are drawn in a single pass
+//-------------------------------------------------
+
+osd_work_queue *render_manager::work_queue()
+{
+	// OSD window threads may get here at the same time; if another beats us to it, use theirs
+	if (m_work_queue == NULL)
+	{
+		osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+		if (compare_exchange_ptr((void * volatile *)&m_work_queue, NULL, queue) != NULL && queue != NULL)
+			osd_work_queue_free(queue);
+	}
+	return m_work_queue;
+}
+
+
 //-------------------------------------------------
 //  container_alloc - allocate a new container
 //-------------------------------------------------
@@ -438,12 +438,15 @@ private:
 	// internal helpers
 	bool get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &texinfo, render_primitive_list &primlist);
 	const rgb_t *get_adjusted_palette(render_container &container);
-
-	static const int MAX_TEXTURE_SCALES = 8;
+	void free_scaled();
 
 	// a scaled_texture contains a single scaled entry for a texture
 	struct scaled_texture
 	{
+		render_texture *    owner;                  // texture this is a variant of
+		scaled_texture *    next;                   // next variant of the same texture
+		scaled_texture *    lru_prev;               // next more recently used variant of any texture
+		scaled_texture *    lru_next;               // next less recently used variant of any texture
 		bitmap_argb32 *     bitmap;                 // final bitmap
 		UINT32              seqid;                  // sequence number
 	};
@@ -462,7 +465,7 @@ private:
 	texture_scaler_func m_scaler;                   // scaling callback
 	void *              m_param;                    // scaling callback parameter
 	UINT32              m_curseq;                   // current sequence number
-	scaled_texture      m_scaled[MAX_TEXTURE_SCALES];// array of scaled variants of this texture
+	scaled_texture *    m_scaled;                   // list of scaled variants of this texture
 };
 
 
@@ -658,6 +661,7 @@ public:
 
 	// reference tracking
 	void invalidate_all(void *refptr);
+	bool is_referenced(void *refptr);
 
 	// debug containers
 	render_container *debug_alloc();
@@ -725,6 +729,7 @@ private:
 class render_manager
 {
 	friend class render_target;
+	friend class render_texture;
 
 public:
 	// construction/destruction
@@ -756,22 +761,38 @@ public:
 	render_texture *texture_alloc(texture_scaler_func scaler = NULL, void *param = NULL);
 	void texture_free(render_texture *texture);
 
+	// scaled texture cache statistics
+	UINT32 scaled_cache_hits() const { return m_scaled_hits; }
+	UINT32 scaled_cache_misses() const { return m_scaled_misses; }
+	UINT64 scaled_cache_bytes() const { return m_scaled_bytes; }
+
 	// fonts
 	render_font *font_alloc(const char *filename = NULL);
 	void font_free(render_font *font);
 
 	// reference tracking
 	void invalidate_all(void *refptr);
+	bool is_referenced(void *refptr);
+
+	// work queue for the software renderer's bands
+	osd_work_queue *work_queue();
 
 private:
 	// containers
 	render_container *container_alloc(screen_device *screen = NULL);
 	void container_free(render_container *container);
 
+	// scaled texture cache
+	void scaled_cache_add(render_texture::scaled_texture &scaled);
+	void scaled_cache_touch(render_texture::scaled_texture &scaled);
+	void scaled_cache_free(render_texture::scaled_texture &scaled);
+
 	// config callbacks
 	void config_load(int config_type, xml_data_node *parentnode);
 	void config_save(int config_type, xml_data_node *parentnode);
 
+	static const UINT64 SCALED_CACHE_BYTES = 64 * 1024 * 1024;
+
 	// internal state
 	running_machine &               m_machine;          // reference back to the machine
 
@@ -783,9 +804,19 @@ private:
 	UINT32                          m_live_textures;    // number of live textures
 	fixed_allocator<render_texture> m_texture_allocator;// texture allocator
 
+	// scaled variants of all textures, most recently used first
+	render_texture::scaled_texture *m_scaled_head;      // most recently used
+	render_texture::scaled_texture *m_scaled_tail;      // least recently used
+	UINT64                          m_scaled_bytes;     // total bytes of scaled bitmaps
+	UINT32                          m_scaled_hits;      // lookups that found a scaled bitmap
+	UINT32                          m_scaled_misses;    // lookups that had to run the scaler
+
 	// containers for the UI and for screens
 	render_container *              m_ui_container;     // UI container
 	simple_list<render_container>   m_screen_container_list; // list of containers for the screen
+
+	// software rendering
+	osd_work_queue *volatile        m_work_queue;       // queue for rendering bands, allocated on first use
 };
 
 
@@ -344,14 +344,30 @@ private:
 
 
 	//-------------------------------------------------
-	//  draw_line - draw a line or point
+	//  cosine_table - return the table of beam width
+	//  adjustments for anti-aliased lines, building
+	//  it on first use
 	//-------------------------------------------------
 
-	static void draw_line(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch)
+	static const UINT32 *cosine_table()
 	{
-		// internal tables
 		static UINT32 s_cosine_table[2049];
 
+		// build up the cosine table if we haven't yet; fill entry 0 last since it flags completion
+		if (s_cosine_table[0] == 0)
+			for (int entry = 2048; entry >= 0; entry--)
+				s_cosine_table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+		return s_cosine_table;
+	}
+
+
+	//-------------------------------------------------
+	//  draw_line - draw a line or point, clipped to
+	//  rows miny through height - 1
+	//-------------------------------------------------
+
+	static void draw_line(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 miny)
+	{
 		// compute the start/end coordinates
 		int x1 = int(prim.bounds.x0 * 65536.0f);
 		int y1 = int(prim.bounds.y0 * 65536.0f);
@@ -363,10 +379,7 @@ private:
 
 		if (PRIMFLAG_GET_ANTIALIAS(prim.flags))
 		{
-			// build up the cosine table if we haven't yet
-			if (s_cosine_table[0] == 0)
-				for (int entry = 0; entry <= 2048; entry++)
-					s_cosine_table[entry] = int(double(1.0 / cos(atan(double(entry) / 2048.0))) * 0x10000000 + 0.5);
+			const UINT32 *s_cosine_table = cosine_table();
 
 			int beam = prim.width * 65536.0f;
 			if (beam < 0x00010000)
@@ -392,7 +405,7 @@ private:
 					{
 						dx = bwidth;    // init diameter of beam
 						dy = y1 >> 16;
-						if (dy >= 0 && dy < height)
+						if (dy >= miny && dy < height)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(0xff & (~y1 >> 8), col));
 						dy++;
 						dx -= 0x10000 - (0xffff & y1); // take off amount plotted
@@ -400,11 +413,11 @@ private:
 						dx >>= 16;                   // adjust to pixel (solid) count
 						while (dx--)                 // plot rest of pixels
 						{
-							if (dy >= 0 && dy < height)
+							if (dy >= miny && dy < height)
 								draw_aa_pixel(dstdata, pitch, x1, dy, col);
 							dy++;
 						}
-						if (dy >= 0 && dy < height)
+						if (dy >= miny && dy < height)
 							draw_aa_pixel(dstdata, pitch, x1, dy, apply_intensity(a1,col));
 					}
 					if (x1 == xx) break;
@@ -424,7 +437,7 @@ private:
 				x1 -= bwidth >> 1; // start back half the width
 				for (;;)
 				{
-					if (y1 >= 0 && y1 < height)
+					if (y1 >= miny && y1 < height)
 					{
 						dy = bwidth;    // calc diameter of beam
 						dx = x1 >> 16;
@@ -467,7 +480,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= miny && y1 < height)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (x1 == x2) break;
 					x1 += sx;
@@ -483,7 +496,7 @@ private:
 			{
 				for (;;)
 				{
-					if (x1 >= 0 && x1 < width && y1 >= 0 && y1 < height)
+					if (x1 >= 0 && x1 < width && y1 >= miny && y1 < height)
 						draw_aa_pixel(dstdata, pitch, x1, y1, col);
 					if (y1 == y2) break;
 					y1 += sy;
@@ -505,10 +518,11 @@ private:
 	//**************************************************************************
 
 	//-------------------------------------------------
-	//  draw_rect - draw a solid rectangle
+	//  draw_rect - draw a solid rectangle, clipped
+	//  to rows miny through height - 1
 	//-------------------------------------------------
 
-	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch)
+	static void draw_rect(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 miny)
 	{
 		render_bounds fpos = prim.bounds;
 		assert(fpos.x0 <= fpos.x1);
@@ -525,9 +539,9 @@ private:
 		if (startx >= width) startx = width;
 		if (endx < 0) endx = 0;
 		if (endx >= width) endx = width;
-		if (starty < 0) starty = 0;
+		if (starty < miny) starty = miny;
 		if (starty >= height) starty = height;
-		if (endy < 0) endy = 0;
+		if (endy < miny) endy = miny;
 		if (endy >= height) endy = height;
 
 		// bail if nothing left
@@ -1808,10 +1822,11 @@ private:
 	//-------------------------------------------------
 	//  setup_and_draw_textured_quad - perform setup
 	//  and then dispatch to a texture-mode-specific
-	//  drawing routine
+	//  drawing routine, clipped to rows miny through
+	//  height - 1
 	//-------------------------------------------------
 
-	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch)
+	static void setup_and_draw_textured_quad(const render_primitive &prim, _PixelType *dstdata, INT32 width, INT32 height, UINT32 pitch, INT32 miny)
 	{
 		assert(prim.bounds.x0 <= prim.bounds.x1);
 		assert(prim.bounds.y0 <= prim.bounds.y1);
@@ -1858,6 +1873,16 @@ private:
 			setup.startv -= 0x8000;
 		}
 
+		// skip down to the first row we own, stepping U/V exactly as the row loops would
+		if (setup.starty < miny)
+		{
+			setup.startu += (miny - setup.starty) * setup.dudy;
+			setup.startv += (miny - setup.starty) * setup.dvdy;
+			setup.starty = miny;
+		}
+		if (setup.endy < setup.starty)
+			setup.endy = setup.starty;
+
 		// render based on the texture coordinates
 		switch (prim.flags & (PRIMFLAG_TEXFORMAT_MASK | PRIMFLAG_BLENDMODE_MASK))
 		{
@@ -1908,34 +1933,114 @@ private:
 
 
 	//**************************************************************************
-	//  PRIMARY ENTRY POINT
+	//  BANDED RENDERING
 	//**************************************************************************
 
+	// a horizontal band of the target, rendered independently
+	struct render_band
+	{
+		const render_primitive *first;
+		void *          dstdata;
+		UINT32          width;
+		UINT32          pitch;
+		INT32           starty;
+		INT32           endy;
+		osd_work_item * item;
+	};
+
 	//-------------------------------------------------
-	//  draw_primitives - draw a series of primitives
-	//  using a software rasterizer
+	//  draw_band - draw every primitive, clipped to
+	//  rows starty through endy - 1
 	//-------------------------------------------------
 
-public:
-	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch)
+	static void draw_band(const render_primitive *first, void *dstdata, UINT32 width, UINT32 pitch, INT32 starty, INT32 endy)
 	{
 		// loop over the list and render each element
-		for (const render_primitive *prim = primlist.first(); prim != NULL; prim = prim->next())
+		for (const render_primitive *prim = first; prim != NULL; prim = prim->next())
 			switch (prim->type)
 			{
 				case render_primitive::LINE:
-					draw_line(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+					draw_line(*prim, reinterpret_cast<_PixelType *>(dstdata), width, endy, pitch, starty);
 					break;
 
 				case render_primitive::QUAD:
 					if (!prim->texture.base)
-						draw_rect(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						draw_rect(*prim, reinterpret_cast<_PixelType *>(dstdata), width, endy, pitch, starty);
 					else
-						setup_and_draw_textured_quad(*prim, reinterpret_cast<_PixelType *>(dstdata), width, height, pitch);
+						setup_and_draw_textured_quad(*prim, reinterpret_cast<_PixelType *>(dstdata), width, endy, pitch, starty);
 					break;
 
 				default:
 					throw emu_fatalerror("Unexpected render_primitive type");
 			}
 	}
+
+	//-------------------------------------------------
+	//  draw_band_callback - work item callback to
+	//  draw a single band
+	//-------------------------------------------------
+
+	static void *draw_band_callback(void *param, int threadid)
+	{
+		render_band &band = *reinterpret_cast<render_band *>(param);
+		draw_band(band.first, band.dstdata, band.width, band.pitch, band.starty, band.endy);
+		return NULL;
+	}
+
+	//**************************************************************************
+	//  PRIMARY ENTRY POINT
+	//**************************************************************************
+
+	static const int MAX_BANDS = 8;             // most bands to split a target into
+	static const int MIN_BAND_HEIGHT = 64;      // fewest rows worth a band of their own
+
+	//-------------------------------------------------
+	//  draw_primitives - draw a series of primitives
+	//  using a software rasterizer; given a queue,
+	//  taller targets are split into horizontal bands
+	//  that render in parallel, each drawing every
+	//  primitive in order, so the result matches a
+	//  single pass
+	//-------------------------------------------------
+
+public:
+	static void draw_primitives(const render_primitive_list &primlist, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch, osd_work_queue *queue)
+	{
+		draw_primitives(primlist.first(), dstdata, width, height, pitch, queue);
+	}
+
+	static void draw_primitives(const render_primitive *first, void *dstdata, UINT32 width, UINT32 height, UINT32 pitch, osd_work_queue *queue)
+	{
+		// small targets aren't worth splitting
+		int bands = MIN(MAX_BANDS, height / MIN_BAND_HEIGHT);
+		if (queue == NULL || bands <= 1)
+			return draw_band(first, dstdata, width, pitch, 0, height);
+
+		// make sure shared tables are built before the bands race to use them
+		cosine_table();
+
+		// queue up all but the first band, then draw that one ourselves
+		render_band band[MAX_BANDS];
+		for (int bandnum = 0; bandnum < bands; bandnum++)
+		{
+			band[bandnum].first = first;
+			band[bandnum].dstdata = dstdata;
+			band[bandnum].width = width;
+			band[bandnum].pitch = pitch;
+			band[bandnum].starty = height * bandnum / bands;
+			band[bandnum].endy = height * (bandnum + 1) / bands;
+			band[bandnum].item = (bandnum == 0) ? NULL : osd_work_item_queue(queue, draw_band_callback, &band[bandnum], 0);
+		}
+		draw_band(first, dstdata, width, pitch, band[0].starty, band[0].endy);
+
+		// wait for the others
+		for (int bandnum = 1; bandnum < bands; bandnum++)
+			if (band[bandnum].item != NULL)
+			{
+				while (!osd_work_item_wait(band[bandnum].item, osd_ticks_per_second() * 10)) ;
+				osd_work_item_release(band[bandnum].item);
+			}
+			else
+				draw_band(first, dstdata, width, pitch, band[bandnum].starty, band[bandnum].endy);
+	}
 };
@@ -11,18 +11,45 @@
     Save state file format:
 
     00..07  'MAMESAVE'
-    08      Format version (this is format 2)
+    08      Format version (this is format 3)
     09      Flags
     0A..1B  Game name padded with \0
     1C..1F  Signature
-    20..end Save game data (compressed)
+    20..23  Number of chunks
+    24..27  Number of index entries
+    28..2B  Size of the index in bytes
+    2C..    Chunk table, 12 bytes per chunk:
+                00..03  Compressed length
+                04..07  Uncompressed length
+                08..0B  CRC32 of the uncompressed data
+            Index, one record per entry, in name order:
+                00..03  Offset of the entry in the uncompressed data
+                04..07  Length of the entry
+                08..    Entry name, NUL-terminated
+            Chunk data, each chunk an independent zlib stream
+
+    The entries are laid out end-to-end and the result is split into
+    fixed-size chunks, which are compressed and decompressed in parallel;
+    see savechunk.c. The index lets a load match up every entry by name
+    and size before anything is decompressed. There are at most 4096
+    chunks of 256k each. All values in the header, chunk table and index
+    are little-endian.
+
+    Format 2 files, where the data after the signature is a single zlib
+    stream, can still be read.
 
     Data is always written as native-endian.
     Data is converted from the endiannness it was written upon load.
 
+****************************************************************************
+
+    In-memory snapshots lay the entries out end-to-end, as for files, and
+    keep them in a snapshot_ring; see snapring.c.
+
 ***************************************************************************/
 
 #include "emu.h"
+#include "savechunk.h"
 
 #include <zlib.h>
 
@@ -41,7 +68,8 @@
 //  CONSTANTS
 //**************************************************************************
 
-const int SAVE_VERSION      = 2;
+const int SAVE_VERSION      = 3;
+const int SAVE_VERSION_SERIAL = 2;
 const int HEADER_SIZE       = 32;
 
 // Available flags
@@ -227,13 +255,12 @@ save_error save_manager::read_file(emu_file &file)
 	if (m_illegal_regs > 0)
 		return STATERR_ILLEGAL_REGISTRATIONS;
 
-	// read the header and turn on compression for the rest of the file
+	// read the header
 	file.compress(FCOMPRESS_NONE);
 	file.seek(0, SEEK_SET);
 	UINT8 header[HEADER_SIZE];
 	if (file.read(header, sizeof(header)) != sizeof(header))
 		return STATERR_READ_ERROR;
-	file.compress(FCOMPRESS_MEDIUM);
 
 	// verify the header and report an error if it doesn't match
 	UINT32 sig = signature();
@@ -243,17 +270,10 @@ save_error save_manager::read_file(emu_file &file)
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
-	// read all the data, flipping if necessary
-	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
-	{
-		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
-		if (file.read(entry->m_data, totalsize) != totalsize)
-			return STATERR_READ_ERROR;
-
-		// handle flipping
-		if (flip)
-			entry->flip_data();
-	}
+	// read the data in whichever format it was written
+	save_error err = (header[8] == SAVE_VERSION_SERIAL) ? read_file_serial(file, flip) : read_file_chunked(file, flip);
+	if (err != STATERR_NONE)
+		return err;
 
 	// call the post-load functions
 	for (state_callback *func = m_postload_list.first(); func != NULL; func = func->next())
@@ -273,6 +293,15 @@ save_error save_manager::write_file(emu_file &file)
 	if (m_illegal_regs > 0)
 		return STATERR_ILLEGAL_REGISTRATIONS;
 
+	// make sure it all fits in the chunk table
+	chunked_state state;
+	UINT32 rawsize = layout_entries();
+	if (!state.allocate(rawsize))
+	{
+		logerror("Save state of %u bytes exceeds the %u byte limit\n", rawsize, chunked_state::MAX_CHUNKS * chunked_state::CHUNK_SIZE);
+		return STATERR_TOO_LARGE;
+	}
+
 	// generate the header
 	UINT8 header[HEADER_SIZE];
 	memcpy(&header[0], emulator_info::get_state_magic_num(), 8);
@@ -282,28 +311,191 @@ save_error save_manager::write_file(emu_file &file)
 	UINT32 sig = signature();
 	*(UINT32 *)&header[0x1c] = LITTLE_ENDIANIZE_INT32(sig);
 
-	// write the header and turn on compression for the rest of the file
+	// call the pre-save functions
+	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
+	// gather all the data end-to-end and index it as we go
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	{
+		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
+		if (totalsize != 0)
+			memcpy(state.data(entry->m_offset), entry->m_data, totalsize);
+		state.add_entry(entry->m_name, entry->m_offset, totalsize);
+	}
+
+	// write the header, then let the chunks compress in parallel and follow it
 	file.compress(FCOMPRESS_NONE);
 	file.seek(0, SEEK_SET);
 	if (file.write(header, sizeof(header)) != sizeof(header))
 		return STATERR_WRITE_ERROR;
+	return state.write(file);
+}
+
+
+//-------------------------------------------------
+//  read_file_serial - read the data from a file
+//  in the old single-stream format
+//-------------------------------------------------
+
+save_error save_manager::read_file_serial(emu_file &file, bool flip)
+{
+	// the rest of the file is one compressed stream
 	file.compress(FCOMPRESS_MEDIUM);
 
+	// read all the data, flipping if necessary
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	{
+		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
+		if (file.read(entry->m_data, totalsize) != totalsize)
+			return STATERR_READ_ERROR;
+
+		// handle flipping
+		if (flip)
+			entry->flip_data();
+	}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_file_chunked - read the data from a file
+//  in the chunked format
+//-------------------------------------------------
+
+save_error save_manager::read_file_chunked(emu_file &file, bool flip)
+{
+	// read the directory
+	chunked_state state;
+	save_error err = state.read_directory(file);
+	if (err != STATERR_NONE)
+		return err;
+
+	// match our entries against the index, which is sorted by name like our
+	// list; offsets into the raw data are kept aside, since the entries' own
+	// offsets describe the snapshot layout
+	dynamic_array<UINT32> offsets;
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	{
+		UINT32 offset;
+		if (!state.find_entry(entry->m_name, entry->m_typesize * entry->m_typecount, offset))
+			return STATERR_INVALID_HEADER;
+		offsets.append(offset);
+	}
+
+	// decompress and verify all the chunks
+	err = state.read_data(file);
+	if (err != STATERR_NONE)
+		return err;
+
+	// copy the entries into place, flipping if necessary
+	int entrynum = 0;
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next(), entrynum++)
+	{
+		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
+		if (totalsize != 0)
+			memcpy(entry->m_data, state.data(offsets[entrynum]), totalsize);
+		if (flip)
+			entry->flip_data();
+	}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  snapshot_allocate - set aside a ring buffer
+//  of the given size for in-memory snapshots,
+//  discarding any taken so far
+//-------------------------------------------------
+
+void save_manager::snapshot_allocate(UINT32 bufsize)
+{
+	m_snapshot.allocate(layout_entries(), bufsize);
+}
+
+
+//-------------------------------------------------
+//  snapshot_save - take an in-memory snapshot,
+//  keeping only the data that changed since the
+//  previous one; as with files, the caller must
+//  check that the scheduler can save first
+//-------------------------------------------------
+
+save_error save_manager::snapshot_save()
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// allocate a default-sized ring if nobody asked for one
+	if (!m_snapshot.allocated())
+		snapshot_allocate(16 * 1024 * 1024);
+
 	// call the pre-save functions
 	for (state_callback *func = m_presave_list.first(); func != NULL; func = func->next())
 		func->m_func();
 
-	// then write all the data
+	// hand every entry to the ring
+	m_snapshot.begin();
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+		m_snapshot.capture(entry->m_offset, entry->m_data, entry->m_typesize * entry->m_typecount);
+	m_snapshot.end();
+
+	LOG(("snapshot_save: %d snapshots held in %d bytes of frames\n", m_snapshot.count(), m_snapshot.frame_bytes()));
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  snapshot_load - restore the snapshot taken the
+//  given number of snapshots before the most
+//  recent one; newer snapshots are discarded
+//-------------------------------------------------
+
+save_error save_manager::snapshot_load(int steps_back)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// make sure we can get there
+	if (!m_snapshot.rewind(steps_back))
+		return STATERR_NO_SNAPSHOT;
+
+	// copy the full copy into place
 	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
 	{
 		UINT32 totalsize = entry->m_typesize * entry->m_typecount;
-		if (file.write(entry->m_data, totalsize) != totalsize)
-			return STATERR_WRITE_ERROR;
+		if (totalsize != 0)
+			memcpy(entry->m_data, m_snapshot.state(entry->m_offset), totalsize);
 	}
+
+	// call the post-load functions
+	for (state_callback *func = m_postload_list.first(); func != NULL; func = func->next())
+		func->m_func();
+
 	return STATERR_NONE;
 }
 
 
+//-------------------------------------------------
+//  layout_entries - assign each entry an offset
+//  as if they were laid out end-to-end, and
+//  return the total size
+//-------------------------------------------------
+
+UINT32 save_manager::layout_entries()
+{
+	UINT32 offset = 0;
+	for (state_entry *entry = m_entry_list.first(); entry != NULL; entry = entry->next())
+	{
+		entry->m_offset = offset;
+		offset += entry->m_typesize * entry->m_typecount;
+	}
+	return offset;
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -357,7 +549,7 @@ save_error save_manager::validate_header(const UINT8 *header, const char *gamena
 	}
 
 	// check save state version
-	if (header[8] != SAVE_VERSION)
+	if (header[8] != SAVE_VERSION && header[8] != SAVE_VERSION_SERIAL)
 	{
 		if (errormsg != NULL)
 			(*errormsg)("%sWrong version in save file (version %d, expected %d)", error_prefix, header[8], SAVE_VERSION);
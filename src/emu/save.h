@@ -29,7 +29,9 @@ enum save_error
 	STATERR_ILLEGAL_REGISTRATIONS,
 	STATERR_INVALID_HEADER,
 	STATERR_READ_ERROR,
-	STATERR_WRITE_ERROR
+	STATERR_WRITE_ERROR,
+	STATERR_NO_SNAPSHOT,
+	STATERR_TOO_LARGE
 };
 
 
@@ -141,11 +143,20 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// in-memory snapshots
+	void snapshot_allocate(UINT32 bufsize);
+	int snapshot_count() const { return m_snapshot.count(); }
+	save_error snapshot_save();
+	save_error snapshot_load(int steps_back = 0);
+
 private:
 	// internal helpers
 	UINT32 signature() const;
 	void dump_registry() const;
 	static save_error validate_header(const UINT8 *header, const char *gamename, UINT32 signature, void (CLIB_DECL *errormsg)(const char *fmt, ...), const char *error_prefix);
+	UINT32 layout_entries();
+	save_error read_file_serial(emu_file &file, bool flip);
+	save_error read_file_chunked(emu_file &file, bool flip);
 
 	// state callback item
 	class state_callback
@@ -191,6 +202,7 @@ private:
 	simple_list<state_entry> m_entry_list;          // list of reigstered entries
 	simple_list<state_callback> m_presave_list;     // list of pre-save functions
 	simple_list<state_callback> m_postload_list;    // list of post-load functions
+	snapshot_ring           m_snapshot;             // in-memory snapshots
 };
 
 
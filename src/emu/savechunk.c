@@ -0,0 +1,300 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    savechunk.c
+
+    Chunked, indexed save state data.
+
+****************************************************************************
+
+    This handles everything in a save state file after the header; see
+    save.c for the layout. The entries are laid out end-to-end and the
+    result is split into fixed-size chunks, which are compressed and
+    decompressed in parallel, and each chunk's CRC is checked as it is
+    decompressed.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "savechunk.h"
+
+#include <zlib.h>
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+const int DIRECTORY_SIZE    = 12;
+const int CHUNK_ENTRY_SIZE  = 12;
+
+
+
+//**************************************************************************
+//  CHUNKED STATE
+//**************************************************************************
+
+//-------------------------------------------------
+//  chunked_state - constructor
+//-------------------------------------------------
+
+chunked_state::chunked_state()
+	: m_entries(0),
+		m_indexpos(0)
+{
+}
+
+
+//-------------------------------------------------
+//  allocate - size the data for writing; fails
+//  if it would need too many chunks
+//-------------------------------------------------
+
+bool chunked_state::allocate(UINT32 rawsize)
+{
+	if (UINT64(rawsize) > UINT64(MAX_CHUNKS) * CHUNK_SIZE)
+		return false;
+	m_raw.resize(rawsize);
+	m_index.resize(0);
+	m_entries = 0;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  add_entry - add an entry to the index; they
+//  must be added in name order
+//-------------------------------------------------
+
+void chunked_state::add_entry(const char *name, UINT32 offset, UINT32 length)
+{
+	int start = m_index.count();
+	m_index.resize(start + 8 + strlen(name) + 1, true);
+	*(UINT32 *)&m_index[start + 0] = LITTLE_ENDIANIZE_INT32(offset);
+	*(UINT32 *)&m_index[start + 4] = LITTLE_ENDIANIZE_INT32(length);
+	strcpy((char *)&m_index[start + 8], name);
+	m_entries++;
+}
+
+
+//-------------------------------------------------
+//  write - compress the data and write it out,
+//  along with the directory and index, at the
+//  current position in the file
+//-------------------------------------------------
+
+save_error chunked_state::write(core_file &file)
+{
+	// split the data into chunks, each with room for its worst-case compressed size
+	UINT32 chunks = (m_raw.count() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	if (chunks > MAX_CHUNKS)
+		return STATERR_TOO_LARGE;
+	m_chunk.resize(chunks);
+	UINT32 bound = compressBound(CHUNK_SIZE);
+	m_compressed.resize(chunks * bound);
+	for (UINT32 chunknum = 0; chunknum < chunks; chunknum++)
+	{
+		m_chunk[chunknum].m_raw = &m_raw[chunknum * CHUNK_SIZE];
+		m_chunk[chunknum].m_rawsize = MIN(m_raw.count() - chunknum * CHUNK_SIZE, CHUNK_SIZE);
+		m_chunk[chunknum].m_compressed = &m_compressed[chunknum * bound];
+		m_chunk[chunknum].m_compsize = bound;
+	}
+
+	// compress them all in parallel
+	process_chunks(compress_chunk);
+
+	// build the directory and chunk table
+	dynamic_array<UINT8> directory(DIRECTORY_SIZE + chunks * CHUNK_ENTRY_SIZE);
+	*(UINT32 *)&directory[0] = LITTLE_ENDIANIZE_INT32(chunks);
+	*(UINT32 *)&directory[4] = LITTLE_ENDIANIZE_INT32(m_entries);
+	*(UINT32 *)&directory[8] = LITTLE_ENDIANIZE_INT32(m_index.count());
+	for (UINT32 chunknum = 0; chunknum < chunks; chunknum++)
+	{
+		if (!m_chunk[chunknum].m_success)
+			return STATERR_WRITE_ERROR;
+		UINT8 *dest = &directory[DIRECTORY_SIZE + chunknum * CHUNK_ENTRY_SIZE];
+		*(UINT32 *)&dest[0] = LITTLE_ENDIANIZE_INT32(m_chunk[chunknum].m_compsize);
+		*(UINT32 *)&dest[4] = LITTLE_ENDIANIZE_INT32(m_chunk[chunknum].m_rawsize);
+		*(UINT32 *)&dest[8] = LITTLE_ENDIANIZE_INT32(m_chunk[chunknum].m_crc);
+	}
+
+	// write it all out
+	if (core_fwrite(&file, &directory[0], directory.count()) != directory.count())
+		return STATERR_WRITE_ERROR;
+	if (m_index.count() > 0 && core_fwrite(&file, &m_index[0], m_index.count()) != m_index.count())
+		return STATERR_WRITE_ERROR;
+	for (UINT32 chunknum = 0; chunknum < chunks; chunknum++)
+		if (core_fwrite(&file, m_chunk[chunknum].m_compressed, m_chunk[chunknum].m_compsize) != m_chunk[chunknum].m_compsize)
+			return STATERR_WRITE_ERROR;
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_directory - read and check the directory,
+//  chunk table and index at the current position
+//  in the file
+//-------------------------------------------------
+
+save_error chunked_state::read_directory(core_file &file)
+{
+	// read the directory
+	UINT64 fileoffs = core_ftell(&file);
+	UINT64 filesize = core_fsize(&file);
+	UINT8 dirheader[DIRECTORY_SIZE];
+	if (core_fread(&file, dirheader, sizeof(dirheader)) != sizeof(dirheader))
+		return STATERR_READ_ERROR;
+	UINT32 chunks = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&dirheader[0]);
+	m_entries = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&dirheader[4]);
+	UINT32 indexsize = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&dirheader[8]);
+
+	// the chunk table and index must fit in the file
+	fileoffs += DIRECTORY_SIZE + UINT64(chunks) * CHUNK_ENTRY_SIZE + indexsize;
+	if (chunks > MAX_CHUNKS || fileoffs > filesize)
+		return STATERR_INVALID_HEADER;
+
+	// read the chunk table and index, terminating the index so names can't run off the end
+	dynamic_array<UINT8> table(chunks * CHUNK_ENTRY_SIZE + 1);
+	m_index.resize(indexsize + 1);
+	if (core_fread(&file, &table[0], table.count() - 1) != table.count() - 1)
+		return STATERR_READ_ERROR;
+	if (core_fread(&file, &m_index[0], indexsize) != indexsize)
+		return STATERR_READ_ERROR;
+	m_index[indexsize] = 0;
+	m_indexpos = 0;
+
+	// parse the chunk table, noting where each chunk lives in the file; every
+	// chunk but the last must be full, since that's how the raw data is split
+	m_chunk.resize(chunks);
+	UINT32 rawsize = 0;
+	for (UINT32 chunknum = 0; chunknum < chunks; chunknum++)
+	{
+		const UINT8 *src = &table[chunknum * CHUNK_ENTRY_SIZE];
+		m_chunk[chunknum].m_compsize = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&src[0]);
+		m_chunk[chunknum].m_rawsize = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&src[4]);
+		m_chunk[chunknum].m_crc = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&src[8]);
+		m_chunk[chunknum].m_success = false;
+		if (m_chunk[chunknum].m_rawsize == 0 || m_chunk[chunknum].m_rawsize > CHUNK_SIZE || (chunknum != chunks - 1 && m_chunk[chunknum].m_rawsize != CHUNK_SIZE))
+			return STATERR_INVALID_HEADER;
+		m_chunk[chunknum].m_fileoffs = fileoffs;
+		fileoffs += m_chunk[chunknum].m_compsize;
+		rawsize += m_chunk[chunknum].m_rawsize;
+	}
+	if (fileoffs > filesize)
+		return STATERR_INVALID_HEADER;
+	m_raw.resize(rawsize);
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  find_entry - look up an entry in the index,
+//  returning its offset in the data; entries
+//  must be looked up in name order
+//-------------------------------------------------
+
+bool chunked_state::find_entry(const char *name, UINT32 length, UINT32 &offset)
+{
+	// skip over index records that sort before us
+	UINT32 indexsize = m_index.count() - 1;
+	const char *recname = NULL;
+	while (m_entries > 0 && m_indexpos + 8 < indexsize)
+	{
+		recname = (const char *)&m_index[m_indexpos + 8];
+		if (strcmp(recname, name) >= 0)
+			break;
+		m_indexpos += 8 + strlen(recname) + 1;
+		m_entries--;
+		recname = NULL;
+	}
+
+	// the name and length must match, and the data must be there
+	if (recname == NULL || strcmp(recname, name) != 0 || LITTLE_ENDIANIZE_INT32(*(UINT32 *)&m_index[m_indexpos + 4]) != length)
+		return false;
+	offset = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&m_index[m_indexpos + 0]);
+	return UINT64(offset) + length <= m_raw.count();
+}
+
+
+//-------------------------------------------------
+//  read_data - read all the chunks, and
+//  decompress and verify them in parallel
+//-------------------------------------------------
+
+save_error chunked_state::read_data(core_file &file)
+{
+	UINT32 chunks = m_chunk.count();
+	if (chunks == 0)
+		return STATERR_NONE;
+
+	// the chunks follow one another, so read them all at once
+	UINT64 start = m_chunk[0].m_fileoffs;
+	UINT64 total = m_chunk[chunks - 1].m_fileoffs + m_chunk[chunks - 1].m_compsize - start;
+	if (total > UINT64(MAX_CHUNKS) * compressBound(CHUNK_SIZE))
+		return STATERR_INVALID_HEADER;
+	m_compressed.resize(total);
+	core_fseek(&file, start, SEEK_SET);
+	if (total > 0 && core_fread(&file, &m_compressed[0], total) != total)
+		return STATERR_READ_ERROR;
+	for (UINT32 chunknum = 0; chunknum < chunks; chunknum++)
+	{
+		m_chunk[chunknum].m_raw = &m_raw[chunknum * CHUNK_SIZE];
+		m_chunk[chunknum].m_compressed = &m_compressed[m_chunk[chunknum].m_fileoffs - start];
+	}
+
+	// decompress them in parallel and verify them
+	process_chunks(decompress_chunk);
+	for (UINT32 chunknum = 0; chunknum < chunks; chunknum++)
+		if (!m_chunk[chunknum].m_success)
+			return STATERR_READ_ERROR;
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  process_chunks - run a work item callback on
+//  every chunk in parallel
+//-------------------------------------------------
+
+void chunked_state::process_chunks(osd_work_callback callback)
+{
+	if (m_chunk.count() == 0)
+		return;
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	osd_work_item_queue_multiple(queue, callback, m_chunk.count(), &m_chunk[0], sizeof(m_chunk[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	osd_work_queue_wait(queue, osd_ticks_per_second() * 100);
+	osd_work_queue_free(queue);
+}
+
+
+//-------------------------------------------------
+//  compress_chunk - work item callback to
+//  compress one chunk
+//-------------------------------------------------
+
+void *chunked_state::compress_chunk(void *param, int threadid)
+{
+	state_chunk &chunk = *reinterpret_cast<state_chunk *>(param);
+	uLongf complen = chunk.m_compsize;
+	chunk.m_success = (compress2(chunk.m_compressed, &complen, chunk.m_raw, chunk.m_rawsize, Z_DEFAULT_COMPRESSION) == Z_OK);
+	chunk.m_compsize = complen;
+	chunk.m_crc = crc32(0, chunk.m_raw, chunk.m_rawsize);
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  decompress_chunk - work item callback to
+//  decompress and verify one chunk
+//-------------------------------------------------
+
+void *chunked_state::decompress_chunk(void *param, int threadid)
+{
+	state_chunk &chunk = *reinterpret_cast<state_chunk *>(param);
+	uLongf rawlen = chunk.m_rawsize;
+	chunk.m_success = (uncompress(chunk.m_raw, &rawlen, chunk.m_compressed, chunk.m_compsize) == Z_OK &&
+						rawlen == chunk.m_rawsize && crc32(0, chunk.m_raw, chunk.m_rawsize) == chunk.m_crc);
+	return NULL;
+}
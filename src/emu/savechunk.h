@@ -0,0 +1,83 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    savechunk.h
+
+    Chunked, indexed save state data.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __EMU_H__
+#error Dont include this file directly; include emu.h instead.
+#endif
+
+#ifndef __SAVECHUNK_H__
+#define __SAVECHUNK_H__
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> chunked_state
+
+// the entries of a save state laid out end-to-end, plus an index of where
+// each one lives, stored as independently compressed chunks
+class chunked_state
+{
+public:
+	// amount of uncompressed data per chunk, and the most chunks a file may have
+	static const UINT32 CHUNK_SIZE = 256 * 1024;
+	static const UINT32 MAX_CHUNKS = 4096;
+
+	// construction/destruction
+	chunked_state();
+
+	// getters
+	UINT32 size() const { return m_raw.count(); }
+	int chunks() const { return m_chunk.count(); }
+	UINT8 *data(UINT32 offset) { return &m_raw[offset]; }
+
+	// writing: size the data, fill it in and index each entry, then write it all
+	bool allocate(UINT32 rawsize);
+	void add_entry(const char *name, UINT32 offset, UINT32 length);
+	save_error write(core_file &file);
+
+	// reading: read the directory, look up each entry, then read the data
+	save_error read_directory(core_file &file);
+	bool find_entry(const char *name, UINT32 length, UINT32 &offset);
+	save_error read_data(core_file &file);
+
+private:
+	// internal helpers
+	void process_chunks(osd_work_callback callback);
+	static void *compress_chunk(void *param, int threadid);
+	static void *decompress_chunk(void *param, int threadid);
+
+	// a piece of the data compressed independently of the others
+	struct state_chunk
+	{
+		UINT8 *             m_raw;                  // uncompressed data
+		UINT32              m_rawsize;              // size of the uncompressed data
+		UINT8 *             m_compressed;           // compressed data
+		UINT32              m_compsize;             // size of the compressed data (or buffer, when compressing)
+		UINT32              m_crc;                  // CRC of the uncompressed data
+		UINT64              m_fileoffs;             // offset of the compressed data in the file
+		bool                m_success;              // did the work succeed?
+	};
+
+	// internal state
+	dynamic_array<UINT8>    m_raw;                  // uncompressed data, end-to-end
+	dynamic_array<UINT8>    m_index;                // index records, followed by a NUL when reading
+	int                     m_entries;              // number of index records
+	UINT32                  m_indexpos;             // position of the next record to match when reading
+	dynamic_array<state_chunk> m_chunk;             // the chunks
+	dynamic_array<UINT8>    m_compressed;           // compressed data for all the chunks
+};
+
+
+#endif  /* __SAVECHUNK_H__ */
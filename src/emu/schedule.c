@@ -48,6 +48,9 @@ emu_timer::emu_timer()
 	: m_machine(NULL),
 		m_next(NULL),
 		m_prev(NULL),
+		m_heapindex(-1),
+		m_heapexpire(attotime::never),
+		m_heapsequence(0),
 		m_param(0),
 		m_ptr(NULL),
 		m_enabled(false),
@@ -81,6 +84,7 @@ emu_timer &emu_timer::init(running_machine &machine, timer_expired_delegate call
 	m_machine = &machine;
 	m_next = NULL;
 	m_prev = NULL;
+	m_heapindex = -1;
 	m_callback = callback;
 	m_param = 0;
 	m_ptr = ptr;
@@ -113,6 +117,7 @@ emu_timer &emu_timer::init(device_t &device, device_timer_id id, void *ptr, bool
 	m_machine = &device.machine();
 	m_next = NULL;
 	m_prev = NULL;
+	m_heapindex = -1;
 	m_callback = timer_expired_delegate();
 	m_param = 0;
 	m_ptr = ptr;
@@ -160,9 +165,8 @@ bool emu_timer::enable(bool enable)
 		// set the enable flag
 		m_enabled = enable;
 
-		// remove the timer and insert back into the list
-		machine().scheduler().timer_list_remove(*this);
-		machine().scheduler().timer_list_insert(*this);
+		// move the timer to its new position in the heap
+		machine().scheduler().timer_heap_update(*this);
 	}
 	return old;
 }
@@ -194,12 +198,11 @@ void emu_timer::adjust(attotime start_delay, INT32 param, attotime period)
 	m_expire = m_start + start_delay;
 	m_period = period;
 
-	// remove and re-insert the timer in its new order
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move the timer to its new position in the heap
+	scheduler.timer_heap_update(*this);
 
-	// if this was inserted as the head, abort the current timeslice and resync
-	if (this == scheduler.first_timer())
+	// if this is now the first to expire, abort the current timeslice and resync
+	if (this == &scheduler.first_expiring_timer())
 		scheduler.abort_timeslice();
 }
 
@@ -278,10 +281,8 @@ inline void emu_timer::schedule_next_period()
 	m_start = m_expire;
 	m_expire += m_period;
 
-	// remove and re-insert us
-	device_scheduler &scheduler = machine().scheduler();
-	scheduler.timer_list_remove(*this);
-	scheduler.timer_list_insert(*this);
+	// move us to our new position in the heap
+	machine().scheduler().timer_heap_update(*this);
 }
 
 
@@ -315,6 +316,7 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_execute_list(NULL),
 	m_basetime(attotime::zero),
 	m_timer_list(NULL),
+	m_timer_sequence(0),
 	m_timer_allocator(machine.respool()),
 	m_callback_timer(NULL),
 	m_callback_timer_modified(false),
@@ -324,9 +326,8 @@ device_scheduler::device_scheduler(running_machine &machine) :
 	m_quantum_allocator(machine.respool()),
 	m_quantum_minimum(ATTOSECONDS_IN_NSEC(1) / 1000)
 {
-	// append a single never-expiring timer so there is always one in the list
-	m_timer_list = &m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), NULL, true);
-	m_timer_list->adjust(attotime::never);
+	// append a single never-expiring timer so there is always one in the heap
+	m_timer_allocator.alloc()->init(machine, timer_expired_delegate(), NULL, true).adjust(attotime::never);
 
 	// register global states
 	machine.save().save_item(NAME(m_basetime));
@@ -425,14 +426,14 @@ void device_scheduler::timeslice()
 	execute_timers();
 
 	// loop until we hit the next timer
-	while (m_basetime < m_timer_list->m_expire)
+	while (m_basetime < first_expiring_timer().m_heapexpire)
 	{
 		// by default, assume our target is the end of the next quantum
 		attotime target = m_basetime + attotime(0, m_quantum_list.first()->m_actual);
 
 		// however, if the next timer is going to fire before then, override
-		if (m_timer_list->m_expire < target)
-			target = m_timer_list->m_expire;
+		if (first_expiring_timer().m_heapexpire < target)
+			target = first_expiring_timer().m_heapexpire;
 
 		LOG(("------------------\n"));
 		LOG(("cpu_timeslice: target = %s\n", target.as_string()));
@@ -662,11 +663,11 @@ void device_scheduler::presave()
 
 void device_scheduler::postload()
 {
-	// remove all timers and make a private list of permanent ones
+	// remove all timers in their current expiration order and make a private list of permanent ones
 	simple_list<emu_timer> private_list;
 	while (m_timer_list != NULL)
 	{
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = first_expiring_timer();
 
 		// temporary timers go away entirely (except our special never-expiring one)
 		if (timer.m_temporary && !timer.expire().is_never())
@@ -677,7 +678,7 @@ void device_scheduler::postload()
 			private_list.append(timer_list_remove(timer));
 	}
 
-	// now re-insert them; this effectively re-sorts them by time
+	// now re-insert them; this effectively re-sorts them by the restored times
 	emu_timer *timer;
 	while ((timer = private_list.detach_head()) != NULL)
 		timer_list_insert(*timer);
@@ -804,51 +805,33 @@ void device_scheduler::rebuild_execute_list()
 
 
 //-------------------------------------------------
-//  timer_list_insert - insert a new timer into
-//  the list at the appropriate location
+//  timer_list_insert - add a new timer to the
+//  list of all timers and insert it into the
+//  expiration heap
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_insert(emu_timer &timer)
 {
-	// disabled timers sort to the end
-	attotime expire = timer.m_enabled ? timer.m_expire : attotime::never;
-
-	// loop over the timer list
-	emu_timer *prevtimer = NULL;
-	for (emu_timer *curtimer = m_timer_list; curtimer != NULL; prevtimer = curtimer, curtimer = curtimer->next())
-	{
-		// if the current list entry expires after us, we should be inserted before it
-		if (curtimer->m_expire > expire)
-		{
-			// link the new guy in before the current list entry
-			timer.m_prev = curtimer->m_prev;
-			timer.m_next = curtimer;
-
-			if (curtimer->m_prev != NULL)
-				curtimer->m_prev->m_next = &timer;
-			else
-				m_timer_list = &timer;
-
-			curtimer->m_prev = &timer;
-			return timer;
-		}
-	}
-
-	// need to insert after the last one
-	if (prevtimer != NULL)
-		prevtimer->m_next = &timer;
-	else
-		m_timer_list = &timer;
-
-	timer.m_prev = prevtimer;
-	timer.m_next = NULL;
+	// link it at the head of the list of all timers
+	timer.m_prev = NULL;
+	timer.m_next = m_timer_list;
+	if (m_timer_list != NULL)
+		m_timer_list->m_prev = &timer;
+	m_timer_list = &timer;
+
+	// add it to the end of the heap and let it find its place
+	timer.m_heapexpire = timer.m_enabled ? timer.m_expire : attotime::never;
+	timer.m_heapsequence = m_timer_sequence++;
+	m_timer_heap.append(&timer);
+	timer.m_heapindex = m_timer_heap.count() - 1;
+	timer_heap_sift_up(timer.m_heapindex);
 	return timer;
 }
 
 
 //-------------------------------------------------
 //  timer_list_remove - remove a timer from the
-//  linked list
+//  list of all timers and from the heap
 //-------------------------------------------------
 
 emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
@@ -862,10 +845,107 @@ emu_timer &device_scheduler::timer_list_remove(emu_timer &timer)
 	if (timer.m_next != NULL)
 		timer.m_next->m_prev = timer.m_prev;
 
+	timer.m_prev = timer.m_next = NULL;
+
+	// move the last heap entry into the vacated slot and restore the heap order
+	int index = timer.m_heapindex;
+	int last = m_timer_heap.count() - 1;
+	assert(index >= 0 && index <= last && m_timer_heap[index] == &timer);
+	if (index != last)
+	{
+		timer_heap_set(index, *m_timer_heap[last]);
+		m_timer_heap.resize(last, true);
+		timer_heap_sift_up(index);
+		timer_heap_sift_down(index);
+	}
+	else
+		m_timer_heap.resize(last, true);
+
+	timer.m_heapindex = -1;
 	return timer;
 }
 
 
+//-------------------------------------------------
+//  timer_heap_update - move a timer to its new
+//  position in the heap after its expiration or
+//  enabled state changed
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_update(emu_timer &timer)
+{
+	// disabled timers sort to the end; a fresh sequence number places the timer
+	// after any others with the same expiration time, just like a re-insert
+	timer.m_heapexpire = timer.m_enabled ? timer.m_expire : attotime::never;
+	timer.m_heapsequence = m_timer_sequence++;
+	timer_heap_sift_up(timer.m_heapindex);
+	timer_heap_sift_down(timer.m_heapindex);
+}
+
+
+//-------------------------------------------------
+//  timer_heap_before - return true if the left
+//  timer expires before the right one
+//-------------------------------------------------
+
+inline bool device_scheduler::timer_heap_before(const emu_timer &left, const emu_timer &right)
+{
+	if (left.m_heapexpire != right.m_heapexpire)
+		return left.m_heapexpire < right.m_heapexpire;
+	return left.m_heapsequence < right.m_heapsequence;
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_up - move the timer at the
+//  given heap index toward the root until its
+//  parent expires before it
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_up(int index)
+{
+	emu_timer &timer = *m_timer_heap[index];
+	while (index > 0)
+	{
+		int parent = (index - 1) / 2;
+		if (!timer_heap_before(timer, *m_timer_heap[parent]))
+			break;
+		timer_heap_set(index, *m_timer_heap[parent]);
+		index = parent;
+	}
+	timer_heap_set(index, timer);
+}
+
+
+//-------------------------------------------------
+//  timer_heap_sift_down - move the timer at the
+//  given heap index toward the leaves until it
+//  expires before both of its children
+//-------------------------------------------------
+
+void device_scheduler::timer_heap_sift_down(int index)
+{
+	emu_timer &timer = *m_timer_heap[index];
+	int count = m_timer_heap.count();
+	while (true)
+	{
+		// pick the earlier of the two children
+		int child = index * 2 + 1;
+		if (child >= count)
+			break;
+		if (child + 1 < count && timer_heap_before(*m_timer_heap[child + 1], *m_timer_heap[child]))
+			child++;
+
+		// stop once we expire before it
+		if (!timer_heap_before(*m_timer_heap[child], timer))
+			break;
+		timer_heap_set(index, *m_timer_heap[child]);
+		index = child;
+	}
+	timer_heap_set(index, timer);
+}
+
+
 //-------------------------------------------------
 //  execute_timers - execute timers and update
 //  scheduling quanta
@@ -877,13 +957,13 @@ inline void device_scheduler::execute_timers()
 	while (m_basetime >= m_quantum_list.first()->m_expire)
 		m_quantum_allocator.reclaim(m_quantum_list.detach_head());
 
-	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(), m_timer_list->m_expire.as_string()));
+	LOG(("execute_timers: new=%s head->expire=%s\n", m_basetime.as_string(), first_expiring_timer().m_heapexpire.as_string()));
 
 	// now process any timers that are overdue
-	while (m_timer_list->m_expire <= m_basetime)
+	while (first_expiring_timer().m_heapexpire <= m_basetime)
 	{
 		// if this is a one-shot timer, disable it now
-		emu_timer &timer = *m_timer_list;
+		emu_timer &timer = first_expiring_timer();
 		bool was_enabled = timer.m_enabled;
 		if (timer.m_period.is_zero() || timer.m_period.is_never())
 			timer.m_enabled = false;
@@ -982,7 +1062,17 @@ void device_scheduler::dump_timers() const
 {
 	logerror("=============================================\n");
 	logerror("Timer Dump: Time = %15s\n", time().as_string());
-	for (emu_timer *timer = first_timer(); timer != NULL; timer = timer->next())
-		timer->dump();
+
+	// sort a copy of the heap so the timers are listed in expiration order
+	dynamic_array<emu_timer *> sorted(m_timer_heap.count());
+	for (int index = 0; index < m_timer_heap.count(); index++)
+	{
+		int insert;
+		for (insert = index; insert > 0 && timer_heap_before(*m_timer_heap[index], *sorted[insert - 1]); insert--)
+			sorted[insert] = sorted[insert - 1];
+		sorted[insert] = m_timer_heap[index];
+	}
+	for (int index = 0; index < sorted.count(); index++)
+		sorted[index]->dump();
 	logerror("=============================================\n");
 }
@@ -96,8 +96,11 @@ private:
 
 	// internal state
 	running_machine *   m_machine;      // reference to the owning machine
-	emu_timer *         m_next;         // next timer in order in the list
-	emu_timer *         m_prev;         // previous timer in order in the list
+	emu_timer *         m_next;         // next timer in the list of all timers
+	emu_timer *         m_prev;         // previous timer in the list of all timers
+	int                 m_heapindex;    // index of this timer in the scheduler's heap
+	attotime            m_heapexpire;   // expiration time used to order the heap
+	UINT64              m_heapsequence; // insertion sequence, used to break ties in the heap
 	timer_expired_delegate m_callback;  // callback function
 	INT32               m_param;        // integer parameter
 	void *              m_ptr;          // pointer parameter
@@ -174,6 +177,12 @@ private:
 	// timer helpers
 	emu_timer &timer_list_insert(emu_timer &timer);
 	emu_timer &timer_list_remove(emu_timer &timer);
+	void timer_heap_update(emu_timer &timer);
+	void timer_heap_sift_up(int index);
+	void timer_heap_sift_down(int index);
+	void timer_heap_set(int index, emu_timer &timer) { m_timer_heap[index] = &timer; timer.m_heapindex = index; }
+	static bool timer_heap_before(const emu_timer &left, const emu_timer &right);
+	emu_timer &first_expiring_timer() const { return *m_timer_heap[0]; }
 	void execute_timers();
 
 	// internal state
@@ -183,7 +192,9 @@ private:
 	attotime                    m_basetime;                 // global basetime; everything moves forward from here
 
 	// list of active timers
-	emu_timer *                 m_timer_list;               // head of the active list
+	emu_timer *                 m_timer_list;               // head of the list of all timers
+	dynamic_array<emu_timer *>  m_timer_heap;               // binary min-heap of timers, ordered by expiration
+	UINT64                      m_timer_sequence;           // sequence number for the next heap insertion
 	fixed_allocator<emu_timer>  m_timer_allocator;          // allocator for timers
 
 	// other internal states
@@ -60,6 +60,7 @@ screen_device::screen_device(const machine_config &mconfig, const char *tag, dev
 		m_curbitmap(0),
 		m_curtexture(0),
 		m_changed(true),
+		m_dirty(0, -1, 0, -1),
 		m_last_partial_scan(0),
 		m_frame_period(DEFAULT_FRAME_PERIOD.as_attoseconds()),
 		m_scantime(1),
@@ -578,7 +579,14 @@ bool screen_device::update_partial(int scanline)
 		g_profiler.stop();
 
 		// if we modified the bitmap, we have to commit
-		m_changed |= ~flags & UPDATE_HAS_NOT_CHANGED;
+		if (~flags & UPDATE_HAS_NOT_CHANGED)
+		{
+			if (m_dirty.empty())
+				m_dirty = clip;
+			else
+				m_dirty |= clip;
+			m_changed = true;
+		}
 		result = true;
 	}
 
@@ -826,9 +834,15 @@ bool screen_device::update_quads()
 			// if we're not skipping the frame and if the screen actually changed, then update the texture
 			if (!machine().video().skip_this_frame() && m_changed)
 			{
-				m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat());
-				m_curtexture = m_curbitmap;
-				m_curbitmap = 1 - m_curbitmap;
+				// if the redrawn area came out identical to what's displayed, keep displaying
+				// that texture; this only saves the upload, and the frame still counts as
+				// changed so throttling and the UI carry on as normal
+				if (update_dirty_area())
+				{
+					m_texture[m_curbitmap]->set_bitmap(m_bitmap[m_curbitmap], m_visarea, m_bitmap[m_curbitmap].texformat());
+					m_curtexture = m_curbitmap;
+					m_curbitmap = 1 - m_curbitmap;
+				}
 			}
 
 			// create an empty container with a single quad
@@ -840,10 +854,43 @@ bool screen_device::update_quads()
 	// reset the screen changed flags
 	bool result = m_changed;
 	m_changed = false;
+	m_dirty.set(0, -1, 0, -1);
 	return result;
 }
 
 
+//-------------------------------------------------
+//  update_dirty_area - trim the dirty area down
+//  to the rows that differ from the displayed
+//  bitmap; returns false if none do
+//-------------------------------------------------
+
+bool screen_device::update_dirty_area()
+{
+	// if both bitmaps are the same, there's nothing to compare against
+	if (m_curbitmap == m_curtexture)
+	{
+		m_dirty = m_visarea;
+		return true;
+	}
+
+	// only the visible area matters
+	m_dirty &= m_visarea;
+	if (m_dirty.empty())
+		return false;
+
+	// trim identical rows from the top and bottom
+	screen_bitmap &curbitmap = m_bitmap[m_curbitmap];
+	screen_bitmap &lastbitmap = m_bitmap[m_curtexture];
+	size_t rowbytes = m_dirty.width() * curbitmap.bpp() / 8;
+	while (m_dirty.min_y <= m_dirty.max_y && memcmp(curbitmap.raw_pixptr(m_dirty.min_y, m_dirty.min_x), lastbitmap.raw_pixptr(m_dirty.min_y, m_dirty.min_x), rowbytes) == 0)
+		m_dirty.min_y++;
+	while (m_dirty.min_y <= m_dirty.max_y && memcmp(curbitmap.raw_pixptr(m_dirty.max_y, m_dirty.min_x), lastbitmap.raw_pixptr(m_dirty.max_y, m_dirty.min_x), rowbytes) == 0)
+		m_dirty.max_y--;
+	return !m_dirty.empty();
+}
+
+
 //-------------------------------------------------
 //  update_burnin - update the burnin bitmap
 //-------------------------------------------------
@@ -91,6 +91,7 @@ public:
 	bool valid() const { return live().valid(); }
 	palette_t *palette() const { return live().palette(); }
 	const rectangle &cliprect() const { return live().cliprect(); }
+	void *raw_pixptr(INT32 y, INT32 x = 0) const { return live().raw_pixptr(y, x); }
 
 	// operations
 	void set_palette(palette_t *palette) { live().set_palette(palette); }
@@ -232,6 +233,7 @@ private:
 	void realloc_screen_bitmaps();
 	void vblank_begin();
 	void vblank_end();
+	bool update_dirty_area();
 	void finalize_burnin();
 	void load_effect_overlay(const char *filename);
 
@@ -263,6 +265,7 @@ private:
 	UINT8               m_curbitmap;                // current bitmap index
 	UINT8               m_curtexture;               // current texture index
 	bool                m_changed;                  // has this bitmap changed?
+	rectangle           m_dirty;                    // area of this bitmap redrawn with changes
 	INT32               m_last_partial_scan;        // scanline of last partial update
 	bitmap_argb32       m_screen_overlay_bitmap;    // screen overlay bitmap
 	UINT32              m_unique_id;                // unique id for this screen_device
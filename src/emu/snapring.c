@@ -0,0 +1,255 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    snapring.c
+
+    Ring buffer of in-memory delta snapshots.
+
+****************************************************************************
+
+    The most recent snapshot is kept as a full copy of the state. Each
+    older snapshot is reachable through a frame in a fixed-size ring
+    buffer; a frame holds the previous contents of every piece of the
+    state, or every 4k page of a large piece, that changed between the
+    two snapshots. Frames start with a 32-bit record count, followed by
+    the records:
+
+    00..03  Offset of the data within the full state
+    04..07  Length of the data
+    08..    Previous contents
+
+    When the ring fills up, the oldest frames are discarded, which simply
+    makes the oldest snapshots unreachable.
+
+***************************************************************************/
+
+#include "emu.h"
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// granularity at which large pieces of the state are compared
+const UINT32 SNAPSHOT_PAGE_SIZE = 4096;
+
+
+
+//**************************************************************************
+//  SNAPSHOT RING
+//**************************************************************************
+
+//-------------------------------------------------
+//  snapshot_ring - constructor
+//-------------------------------------------------
+
+snapshot_ring::snapshot_ring()
+	: m_valid(false),
+		m_records(0)
+{
+}
+
+
+//-------------------------------------------------
+//  frame_bytes - return the number of bytes
+//  held by the frames in the ring
+//-------------------------------------------------
+
+UINT32 snapshot_ring::frame_bytes() const
+{
+	UINT32 total = 0;
+	for (int index = 0; index < m_frames.count(); index++)
+		total += m_frames[index].m_size;
+	return total;
+}
+
+
+//-------------------------------------------------
+//  allocate - size the full copy and the ring,
+//  discarding any snapshots taken so far
+//-------------------------------------------------
+
+void snapshot_ring::allocate(UINT32 statesize, UINT32 bufsize)
+{
+	m_valid = false;
+	m_state.resize(statesize);
+	m_ring.resize(bufsize);
+	m_frames.resize(0);
+}
+
+
+//-------------------------------------------------
+//  begin - start taking a snapshot
+//-------------------------------------------------
+
+void snapshot_ring::begin()
+{
+	m_scratch.resize(sizeof(UINT32));
+	m_records = 0;
+}
+
+
+//-------------------------------------------------
+//  capture - compare one piece of the live state
+//  with the full copy a page at a time, recording
+//  the old contents of anything that changed
+//-------------------------------------------------
+
+void snapshot_ring::capture(UINT32 offset, const void *data, UINT32 length)
+{
+	// the first snapshot is just a full copy
+	if (!m_valid)
+	{
+		if (length != 0)
+			memcpy(&m_state[offset], data, length);
+		return;
+	}
+
+	for (UINT32 pagestart = 0; pagestart < length; pagestart += SNAPSHOT_PAGE_SIZE)
+	{
+		UINT32 pagelength = MIN(length - pagestart, SNAPSHOT_PAGE_SIZE);
+		const UINT8 *live = reinterpret_cast<const UINT8 *>(data) + pagestart;
+		UINT8 *saved = &m_state[offset + pagestart];
+		if (memcmp(live, saved, pagelength) != 0)
+		{
+			append_undo(offset + pagestart, saved, pagelength);
+			memcpy(saved, live, pagelength);
+			m_records++;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  end - finish taking a snapshot
+//-------------------------------------------------
+
+void snapshot_ring::end()
+{
+	if (!m_valid)
+	{
+		m_valid = true;
+		return;
+	}
+
+	memcpy(&m_scratch[0], &m_records, sizeof(m_records));
+	store_frame();
+}
+
+
+//-------------------------------------------------
+//  rewind - step the full copy back to the
+//  snapshot taken the given number of snapshots
+//  before the most recent one; newer snapshots
+//  are discarded
+//-------------------------------------------------
+
+bool snapshot_ring::rewind(int steps_back)
+{
+	// make sure we can get there
+	if (steps_back < 0 || steps_back >= count())
+		return false;
+
+	// walk the full copy back one frame at a time
+	while (steps_back-- > 0)
+		apply_frame();
+	return true;
+}
+
+
+//-------------------------------------------------
+//  append_undo - append a record to the frame
+//  being built
+//-------------------------------------------------
+
+void snapshot_ring::append_undo(UINT32 offset, const void *data, UINT32 length)
+{
+	UINT32 start = m_scratch.count();
+	m_scratch.resize(start + 2 * sizeof(UINT32) + length, true);
+	memcpy(&m_scratch[start], &offset, sizeof(offset));
+	memcpy(&m_scratch[start + sizeof(UINT32)], &length, sizeof(length));
+	memcpy(&m_scratch[start + 2 * sizeof(UINT32)], data, length);
+}
+
+
+//-------------------------------------------------
+//  store_frame - move the frame just built into
+//  the ring, discarding the oldest frames to make
+//  room
+//-------------------------------------------------
+
+void snapshot_ring::store_frame()
+{
+	UINT32 size = m_scratch.count();
+	UINT32 capacity = m_ring.count();
+
+	// if it can never fit, older snapshots become unreachable
+	if (size > capacity)
+	{
+		m_frames.resize(0);
+		return;
+	}
+
+	// place it right after the newest frame, or at the start of the ring if it doesn't fit there
+	UINT32 start = 0;
+	int count = m_frames.count();
+	if (count > 0)
+	{
+		const frame &newest = m_frames[count - 1];
+		start = newest.m_offset + newest.m_size;
+		if (start + size > capacity)
+		{
+			// wrapping; anything past the newest frame is older and in the way
+			start = 0;
+			int discard = 0;
+			while (discard < count - 1 && m_frames[discard].m_offset >= newest.m_offset)
+				discard++;
+			for (int index = discard; index < count; index++)
+				m_frames[index - discard] = m_frames[index];
+			m_frames.resize(count -= discard, true);
+		}
+	}
+
+	// discard the oldest frames until they no longer overlap
+	int discard = 0;
+	while (discard < count && m_frames[discard].m_offset < start + size && m_frames[discard].m_offset + m_frames[discard].m_size > start)
+		discard++;
+	for (int index = discard; index < count; index++)
+		m_frames[index - discard] = m_frames[index];
+	m_frames.resize(count - discard, true);
+
+	// copy it in and append it
+	memcpy(&m_ring[start], &m_scratch[0], size);
+	frame newframe;
+	newframe.m_offset = start;
+	newframe.m_size = size;
+	m_frames.append(newframe);
+}
+
+
+//-------------------------------------------------
+//  apply_frame - step the full copy back by one
+//  snapshot using the newest frame
+//-------------------------------------------------
+
+void snapshot_ring::apply_frame()
+{
+	int last = m_frames.count() - 1;
+	assert(last >= 0);
+	const frame &newest = m_frames[last];
+	const UINT8 *data = &m_ring[newest.m_offset];
+	UINT32 records;
+	memcpy(&records, data, sizeof(records));
+	data += sizeof(UINT32);
+	while (records-- > 0)
+	{
+		UINT32 offset, length;
+		memcpy(&offset, data, sizeof(offset));
+		memcpy(&length, data + sizeof(UINT32), sizeof(length));
+		memcpy(&m_state[offset], data + 2 * sizeof(UINT32), length);
+		data += 2 * sizeof(UINT32) + length;
+	}
+	m_frames.resize(last, true);
+}
@@ -0,0 +1,76 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    snapring.h
+
+    Ring buffer of in-memory delta snapshots.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __EMU_H__
+#error Dont include this file directly; include emu.h instead.
+#endif
+
+#ifndef __SNAPRING_H__
+#define __SNAPRING_H__
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> snapshot_ring
+
+// keeps the most recent snapshot of a flat state image in full, plus enough
+// of what changed between snapshots to step back to the older ones
+class snapshot_ring
+{
+public:
+	// construction/destruction
+	snapshot_ring();
+
+	// getters
+	bool allocated() const { return m_ring.count() != 0; }
+	int count() const { return m_valid ? m_frames.count() + 1 : 0; }
+	UINT32 frame_bytes() const;
+
+	// setup
+	void allocate(UINT32 statesize, UINT32 bufsize);
+
+	// taking a snapshot: begin, capture every piece of the state, then end
+	void begin();
+	void capture(UINT32 offset, const void *data, UINT32 length);
+	void end();
+
+	// restoring: step back, then copy each piece of the state out
+	bool rewind(int steps_back);
+	const void *state(UINT32 offset) const { return &m_state[offset]; }
+
+private:
+	// internal helpers
+	void append_undo(UINT32 offset, const void *data, UINT32 length);
+	void store_frame();
+	void apply_frame();
+
+	// a frame holds the pages needed to step back from one snapshot to the previous one
+	struct frame
+	{
+		UINT32              m_offset;               // offset of the frame within the ring
+		UINT32              m_size;                 // size of the frame in bytes
+	};
+
+	// internal state
+	bool                    m_valid;                // does m_state hold a snapshot?
+	UINT32                  m_records;              // records in the frame being built
+	dynamic_array<UINT8>    m_state;                // full contents of the most recent snapshot
+	dynamic_array<UINT8>    m_ring;                 // ring buffer holding the frames
+	dynamic_array<UINT8>    m_scratch;              // frame being built
+	dynamic_array<frame>    m_frames;               // frames within the ring, oldest first
+};
+
+
+#endif  /* __SNAPRING_H__ */
@@ -14,6 +14,10 @@
 #include "config.h"
 #include "sound/wavwrite.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 
 
 //**************************************************************************
@@ -30,6 +34,8 @@
 //  CONSTANTS
 //**************************************************************************
 
+// fraction of the narrower of the two Nyquist bands passed by the sinc resampler
+const double SINC_ROLLOFF = 0.9;
 
 
 //**************************************************************************
@@ -53,6 +59,7 @@ sound_stream::sound_stream(device_t &device, int inputs, int outputs, int sample
 		m_next(NULL),
 		m_sample_rate(sample_rate),
 		m_new_sample_rate(0),
+		m_resampler(device.machine().options().sinc_resample() ? RESAMPLER_SINC : RESAMPLER_LINEAR),
 		m_attoseconds_per_sample(0),
 		m_max_samples_per_update(0),
 		m_input(inputs),
@@ -353,6 +360,21 @@ void sound_stream::set_output_gain(int outputnum, float gain)
 }
 
 
+//-------------------------------------------------
+//  set_resampler - select how this stream's
+//  inputs are converted to its sample rate
+//-------------------------------------------------
+
+void sound_stream::set_resampler(resampler_type type)
+{
+	update();
+	m_resampler = type;
+
+	// the sinc filter needs extra latency to see its lookahead samples
+	recompute_sample_rate_data();
+}
+
+
 //-------------------------------------------------
 //  update_with_accounting - do a regular update,
 //  but also do periodic accounting
@@ -424,6 +446,16 @@ void sound_stream::apply_sample_rate_changes()
 	// clear out the buffer
 	for (int outputnum = 0; outputnum < m_output.count(); outputnum++)
 		memset(&m_output[outputnum].m_buffer[0], 0, m_max_samples_per_update * sizeof(m_output[outputnum].m_buffer[0]));
+
+	// streams resampling us through the sinc filter need to check their latency again
+	for (sound_stream *stream = m_device.machine().sound().first_stream(); stream != NULL; stream = stream->next())
+		if (stream->m_resampler == RESAMPLER_SINC)
+			for (int inputnum = 0; inputnum < stream->m_input.count(); inputnum++)
+				if (stream->m_input[inputnum].m_source != NULL && stream->m_input[inputnum].m_source->m_stream == this)
+				{
+					stream->recompute_sample_rate_data();
+					break;
+				}
 }
 
 
@@ -477,6 +509,27 @@ void sound_stream::recompute_sample_rate_data()
 			else if (input.m_source->m_stream->m_sample_rate == m_sample_rate)
 				latency = 0;
 
+			// the sinc filter looks ahead by half its width in source samples, which we
+			// add to the latency, and reads as far behind; the source only keeps one
+			// update's worth of history, so if the whole span doesn't fit, this input
+			// stays on linear interpolation for good
+			input.m_sinc = false;
+			if (m_resampler == RESAMPLER_SINC && latency != 0)
+			{
+				attoseconds_t lookahead = resample_filter::half_taps(input.m_source->m_stream->m_sample_rate, m_sample_rate) * new_attosecs_per_sample;
+				attoseconds_t sinc_latency = MAX(input.m_latency_attoseconds, latency + lookahead);
+				if (sinc_latency + lookahead + new_attosecs_per_sample < update_attoseconds)
+				{
+					latency = sinc_latency;
+					input.m_sinc = true;
+				}
+				else
+				{
+					astring name;
+					logerror("%s: too far from %d Hz for the sinc resampler; using linear\n", input_name(inputnum, name), m_sample_rate);
+				}
+			}
+
 			// we generally don't want to tweak the latency, so we just keep the greatest
 			// one we've computed thus far
 			input.m_latency_attoseconds = MAX(input.m_latency_attoseconds, latency);
@@ -583,8 +636,11 @@ void sound_stream::generate_samples(int samples)
 		if (input.m_source != NULL)
 			input.m_source->m_stream->update();
 
-		// generate the resampled data
+		// generate the resampled data, keeping track of what each input costs
+		osd_ticks_t resample_start = osd_ticks();
 		m_input_array[inputnum] = generate_resampled_data(input, samples);
+		input.m_resample_ticks += osd_ticks() - resample_start;
+		input.m_resample_samples += samples;
 	}
 
 	// loop over all outputs and compute the output pointer
@@ -644,6 +700,51 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 	// compute the stepping fraction
 	UINT32 step = (UINT64(input_stream.m_sample_rate) << FRAC_BITS) / m_sample_rate;
 
+	// band-limited resampling, if this input has the latency for it
+	if (input.m_sinc)
+	{
+		generate_sinc_resampled_data(input, source, basesample, basefrac, step, gain, numsamples);
+		return input.m_resample;
+	}
+
+	// otherwise interpolate linearly
+	resample_linear(dest, source, basefrac, step, gain, numsamples);
+	return input.m_resample;
+}
+
+
+//-------------------------------------------------
+//  generate_sinc_resampled_data - fill the
+//  resample buffer for a given input using the
+//  polyphase filter
+//-------------------------------------------------
+
+void sound_stream::generate_sinc_resampled_data(stream_input &input, stream_sample_t *source, INT32 basesample, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples)
+{
+	sound_stream &input_stream = *input.m_source->m_stream;
+
+	// find the filter for this rate pair, looking it up again if either rate changed
+	resample_filter *filter = input.m_filter;
+	if (filter == NULL || UINT64(filter->m_inrate) * m_sample_rate != UINT64(filter->m_outrate) * input_stream.m_sample_rate)
+		filter = input.m_filter = &m_device.machine().sound().resample_filter(input_stream.m_sample_rate, m_sample_rate);
+
+	// the latency we reserved guarantees the source has every sample the filter
+	// will touch, both behind the first output sample and ahead of the last one
+	assert(basesample - (filter->m_taps / 2 - 1) >= input.m_source->m_stream->m_output_base_sampindex);
+	assert(basesample + INT32((basefrac + UINT64(numsamples - 1) * step) >> FRAC_BITS) + filter->m_taps / 2 < input.m_source->m_stream->m_output_sampindex);
+
+	resample_sinc(*filter, input.m_resample, source, basefrac, step, gain, numsamples);
+}
+
+
+//-------------------------------------------------
+//  resample_linear - fill a buffer from a source
+//  at another rate, point sampling upwards and
+//  summing the energy downwards
+//-------------------------------------------------
+
+void sound_stream::resample_linear(stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples)
+{
 	// if we have equal sample rates, we just need to copy
 	if (step == FRAC_ONE)
 	{
@@ -716,8 +817,112 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 			basefrac &= FRAC_MASK;
 		}
 	}
+}
 
-	return input.m_resample;
+
+//-------------------------------------------------
+//  resample_sinc - fill a buffer from a source
+//  at another rate through a polyphase filter;
+//  the source must extend half the filter's
+//  width either side of the samples used
+//-------------------------------------------------
+
+void sound_stream::resample_sinc(const resample_filter &filter, stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples)
+{
+	// each output sample is the dot product of the nearest phase with the source
+	// samples centered on it
+	int taps = filter.m_taps;
+	source -= taps / 2 - 1;
+	while (numsamples--)
+	{
+		const float *coeff = filter.phase((basefrac + (1 << (FRAC_BITS - SINC_PHASE_BITS - 1))) >> (FRAC_BITS - SINC_PHASE_BITS));
+		stream_sample_t sample;
+
+#ifdef __SSE2__
+		__m128 sum = _mm_setzero_ps();
+		for (int tap = 0; tap < taps; tap += 4)
+		{
+			__m128 src = _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i *)&source[tap]));
+			sum = _mm_add_ps(sum, _mm_mul_ps(src, _mm_loadu_ps(&coeff[tap])));
+		}
+		sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+		sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+		sample = _mm_cvtss_si32(sum);
+#else
+		float sum = 0;
+		for (int tap = 0; tap < taps; tap++)
+			sum += float(source[tap]) * coeff[tap];
+		sample = stream_sample_t(floor(sum + 0.5f));
+#endif
+
+		*dest++ = (sample * gain) >> 8;
+
+		// advance
+		basefrac += step;
+		source += basefrac >> FRAC_BITS;
+		basefrac &= FRAC_MASK;
+	}
+}
+
+
+
+//**************************************************************************
+//  RESAMPLE FILTER
+//**************************************************************************
+
+//-------------------------------------------------
+//  resample_filter - constructor; builds one row
+//  of coefficients per fractional phase
+//-------------------------------------------------
+
+sound_stream::resample_filter::resample_filter(UINT32 inrate, UINT32 outrate)
+	: m_next(NULL),
+		m_inrate(inrate),
+		m_outrate(outrate),
+		m_taps(2 * half_taps(inrate, outrate))
+{
+	// the cutoff is just below the narrower of the two Nyquist bands, in source samples
+	double cutoff = SINC_ROLLOFF * MIN(1.0, double(outrate) / double(inrate));
+	int halftaps = m_taps / 2;
+
+	m_coeffs.resize((SINC_PHASES + 1) * m_taps);
+	for (int phasenum = 0; phasenum <= SINC_PHASES; phasenum++)
+	{
+		float *row = &m_coeffs[phasenum * m_taps];
+		double total = 0;
+
+		// tap 0 sits halftaps - 1 samples before the source sample we are centered on
+		for (int tap = 0; tap < m_taps; tap++)
+		{
+			double x = double(tap - (halftaps - 1)) - double(phasenum) / double(SINC_PHASES);
+			double sinc = (x == 0) ? 1.0 : sin(M_PI * cutoff * x) / (M_PI * cutoff * x);
+			double window = (fabs(x) >= halftaps) ? 0.0 : 0.42 + 0.5 * cos(M_PI * x / halftaps) + 0.08 * cos(2.0 * M_PI * x / halftaps);
+			row[tap] = sinc * window;
+			total += row[tap];
+		}
+
+		// normalize each phase to unity gain so DC passes through unchanged
+		for (int tap = 0; tap < m_taps; tap++)
+			row[tap] /= total;
+	}
+}
+
+
+//-------------------------------------------------
+//  half_taps - return the number of source samples
+//  on either side of center needed for a given
+//  rate pair
+//-------------------------------------------------
+
+int sound_stream::resample_filter::half_taps(UINT32 inrate, UINT32 outrate)
+{
+	// downsampling widens the filter in proportion to the ratio
+	double cutoff = SINC_ROLLOFF * MIN(1.0, double(outrate) / double(inrate));
+	int halftaps = int(ceil(SINC_ZERO_CROSSINGS / cutoff));
+
+	// keep the tap count a multiple of 4 for the vector loop
+	halftaps = (halftaps + 1) & ~1;
+	return MIN(halftaps, SINC_MAX_HALF_TAPS);
 }
 
 
@@ -732,7 +937,11 @@ stream_sample_t *sound_stream::generate_resampled_data(stream_input &input, UINT
 
 sound_stream::stream_input::stream_input()
 	: m_source(NULL),
+		m_filter(NULL),
+		m_sinc(false),
 		m_latency_attoseconds(0),
+		m_resample_ticks(0),
+		m_resample_samples(0),
 		m_gain(0x100),
 		m_user_gain(0x100)
 {
@@ -840,6 +1049,34 @@ sound_stream *sound_manager::stream_alloc(device_t &device, int inputs, int outp
 }
 
 
+//-------------------------------------------------
+//  resample_filter - return the shared sinc
+//  filter for a rate pair, building it on first
+//  use
+//-------------------------------------------------
+
+sound_stream::resample_filter &sound_manager::resample_filter(UINT32 inrate, UINT32 outrate)
+{
+	// reduce to the simplest ratio so equivalent rate pairs share a table
+	UINT32 a = inrate, b = outrate;
+	while (b != 0)
+	{
+		UINT32 t = a % b;
+		a = b;
+		b = t;
+	}
+	inrate /= a;
+	outrate /= a;
+
+	// look for an existing one
+	for (sound_stream::resample_filter *filter = m_filter_list.first(); filter != NULL; filter = filter->next())
+		if (filter->m_inrate == inrate && filter->m_outrate == outrate)
+			return *filter;
+
+	return m_filter_list.append(*global_alloc(sound_stream::resample_filter(inrate, outrate)));
+}
+
+
 //-------------------------------------------------
 //  set_attenuation - set the global volume
 //-------------------------------------------------
@@ -67,6 +67,42 @@ class sound_stream
 		INT16               m_gain;                 // gain to apply to the output
 	};
 
+public:
+	// constants
+	static const int OUTPUT_BUFFER_UPDATES      = 5;
+	static const UINT32 FRAC_BITS               = 22;
+	static const UINT32 FRAC_ONE                = 1 << FRAC_BITS;
+	static const UINT32 FRAC_MASK               = FRAC_ONE - 1;
+	static const int SINC_PHASE_BITS            = 7;
+	static const int SINC_PHASES                = 1 << SINC_PHASE_BITS;
+	static const int SINC_ZERO_CROSSINGS        = 8;
+	static const int SINC_MAX_HALF_TAPS         = 256;
+
+	// polyphase windowed-sinc coefficients for one input/output rate ratio
+	class resample_filter
+	{
+		friend class simple_list<resample_filter>;
+
+	public:
+		// construction/destruction
+		resample_filter(UINT32 inrate, UINT32 outrate);
+
+		// getters
+		resample_filter *next() const { return m_next; }
+		const float *phase(int index) const { return &m_coeffs[index * m_taps]; }
+
+		// helpers
+		static int half_taps(UINT32 inrate, UINT32 outrate);
+
+		// internal state
+		resample_filter *   m_next;                 // next filter in the list
+		UINT32              m_inrate;               // input rate, reduced by the common divisor
+		UINT32              m_outrate;              // output rate, reduced by the common divisor
+		int                 m_taps;                 // taps per phase (always a multiple of 4)
+		dynamic_array<float> m_coeffs;              // SINC_PHASES + 1 rows of m_taps coefficients
+	};
+
+private:
 	// stream input class
 	class stream_input
 	{
@@ -78,21 +114,26 @@ class sound_stream
 		// internal state
 		stream_output *     m_source;               // pointer to the sound_output for this source
 		dynamic_array<stream_sample_t> m_resample;  // buffer for resampling to the stream's sample rate
+		resample_filter *   m_filter;               // sinc filter for the current rate pair, if any
+		bool                m_sinc;                 // resample through the sinc filter?
 		attoseconds_t       m_latency_attoseconds;  // latency between this stream and the input stream
+		osd_ticks_t         m_resample_ticks;       // time spent resampling this input
+		UINT64              m_resample_samples;     // samples resampled for this input
 		INT16               m_gain;                 // gain to apply to this input
 		INT16               m_user_gain;            // user-controlled gain to apply to this input
 	};
 
-	// constants
-	static const int OUTPUT_BUFFER_UPDATES      = 5;
-	static const UINT32 FRAC_BITS               = 22;
-	static const UINT32 FRAC_ONE                = 1 << FRAC_BITS;
-	static const UINT32 FRAC_MASK               = FRAC_ONE - 1;
-
 	// construction/destruction
 	sound_stream(device_t &device, int inputs, int outputs, int sample_rate, void *param = NULL, stream_update_func callback = &sound_stream::device_stream_update_stub);
 
 public:
+	// resampling methods between a stream and its inputs
+	enum resampler_type
+	{
+		RESAMPLER_LINEAR,                           // point sample upwards, sum energy downwards
+		RESAMPLER_SINC                              // band-limited polyphase windowed-sinc
+	};
+
 	// getters
 	sound_stream *next() const { return m_next; }
 	device_t &device() const { return m_device; }
@@ -107,6 +148,10 @@ public:
 	float user_gain(int inputnum) const;
 	float input_gain(int inputnum) const;
 	float output_gain(int outputnum) const;
+	resampler_type resampler() const { return m_resampler; }
+	bool input_sinc_resampled(int inputnum) const { return m_input[inputnum].m_sinc; }
+	osd_ticks_t input_resample_ticks(int inputnum) const { return m_input[inputnum].m_resample_ticks; }
+	UINT64 input_resample_samples(int inputnum) const { return m_input[inputnum].m_resample_samples; }
 
 	// operations
 	void set_input(int inputnum, sound_stream *input_stream, int outputnum = 0, float gain = 1.0f);
@@ -118,6 +163,11 @@ public:
 	void set_user_gain(int inputnum, float gain);
 	void set_input_gain(int inputnum, float gain);
 	void set_output_gain(int outputnum, float gain);
+	void set_resampler(resampler_type type);
+
+	// resampling kernels
+	static void resample_linear(stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples);
+	static void resample_sinc(const resample_filter &filter, stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples);
 
 private:
 	// helpers called by our friends only
@@ -132,6 +182,7 @@ private:
 	void postload();
 	void generate_samples(int samples);
 	stream_sample_t *generate_resampled_data(stream_input &input, UINT32 numsamples);
+	void generate_sinc_resampled_data(stream_input &input, stream_sample_t *source, INT32 basesample, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples);
 
 	// linking information
 	device_t &          m_device;               // owning device
@@ -140,6 +191,7 @@ private:
 	// general information
 	UINT32              m_sample_rate;          // sample rate of this stream
 	UINT32              m_new_sample_rate;      // newly-set sample rate for the stream
+	resampler_type      m_resampler;            // how inputs are converted to our sample rate
 
 	// timing information
 	attoseconds_t       m_attoseconds_per_sample;// number of attoseconds per sample
@@ -220,6 +272,7 @@ private:
 	void config_save(int config_type, xml_data_node *parentnode);
 
 	void update(void *ptr = NULL, INT32 param = 0);
+	sound_stream::resample_filter &resample_filter(UINT32 inrate, UINT32 outrate);
 
 	// internal state
 	running_machine &   m_machine;              // reference to our machine
@@ -238,6 +291,7 @@ private:
 
 	// streams data
 	simple_list<sound_stream> m_stream_list;    // list of streams
+	simple_list<sound_stream::resample_filter> m_filter_list; // sinc filters, one per rate ratio
 	attoseconds_t       m_update_attoseconds;   // attoseconds between global updates
 	attotime            m_last_update;          // last update time
 };
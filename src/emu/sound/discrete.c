@@ -50,16 +50,26 @@ const device_type DISCRETE = &device_creator<discrete_sound_device>;
 
 /*
  * Normally, the discrete core processes 960 samples per update.
- * With the various buffers involved, this on a Core2 is not as
- * performant as processing 240 samples 4 times.
- * The setting most probably depends on CPU and which modules are
- * run and how many tasks are defined.
+ * Tasks step through them in slices, so a task can start on what the
+ * tasks it depends on have already buffered.
+ * Each task's slice size is picked from its measured cost per sample,
+ * aiming for TASK_SLICE_USEC of work between buffer handoffs.
  *
  * Values < 32 exhibit poor performance (too much overhead) while
  * Values > 500 have a slightly worse performace (too much cache misses?).
  */
 
-#define MAX_SAMPLES_PER_TASK_SLICE  (960/4)
+#define MIN_SAMPLES_PER_TASK_SLICE  (32)
+#define MAX_SAMPLES_PER_TASK_SLICE  (480)
+#define TASK_SLICE_USEC             (20)
+
+/*
+ * Handing tasks to the work queue and waiting for them costs roughly
+ * this much per update; below it, running the tasks in group order on
+ * the calling thread is faster.
+ */
+
+#define TASK_DISPATCH_USEC          (50)
 
 /*************************************
  *
@@ -87,13 +97,14 @@ struct output_buffer
 {
 	double                      *node_buf;
 	const double                *source;
-	volatile double             *ptr;
+	double                      *ptr;               /* write position, private to the producing task */
+	volatile INT32              written;            /* samples published to consumers */
 	int                         node_num;
 };
 
 struct input_buffer
 {
-	volatile const double       *ptr;               /* pointer into linked_outbuf.nodebuf */
+	const double                *ptr;               /* pointer into linked_outbuf.nodebuf */
 	output_buffer *             linked_outbuf;      /* what output are we connected to ? */
 	double                      buffer;             /* input[] will point here */
 };
@@ -124,7 +135,7 @@ public:
 
 protected:
 	discrete_task(discrete_device &pdev)
-	: task_group(0), m_device(pdev), m_threadid(-1)
+	: task_group(0), m_device(pdev), m_slice(MAX_SAMPLES_PER_TASK_SLICE), m_cost(0), m_ticks(0), m_ticks_samples(0), m_threadid(-1)
 	{
 		source_list.clear();
 		step_list.clear();
@@ -140,6 +151,12 @@ protected:
 	dynamic_array_t<output_buffer>      m_buffers;
 	discrete_device &                   m_device;
 
+	/* slice size and the measurements it is derived from */
+	int                                 m_slice;
+	double                              m_cost;             /* smoothed osd ticks per sample */
+	osd_ticks_t                         m_ticks;
+	int                                 m_ticks_samples;
+
 private:
 	volatile INT32          m_threadid;
 	volatile int            m_samples;
@@ -231,14 +248,14 @@ void *discrete_task::task_callback(void *param, int threadid)
 
 bool discrete_task::process(void)
 {
-	int samples = MIN(m_samples, MAX_SAMPLES_PER_TASK_SLICE);
+	int samples = MIN(m_samples, m_slice);
 
-	/* check dependencies */
+	/* check dependencies; the locked add makes the published samples visible */
 	for_each(input_buffer *, sn, &source_list)
 	{
 		int avail;
 
-		avail = sn->linked_outbuf->ptr - sn->ptr;
+		avail = atomic_add32(&sn->linked_outbuf->written, 0) - (sn->ptr - sn->linked_outbuf->node_buf);
 		assert_always(avail >= 0, "task_callback: available samples are negative");
 		if (avail < samples)
 			samples = avail;
@@ -246,11 +263,22 @@ bool discrete_task::process(void)
 
 	m_samples -= samples;
 	assert_always(m_samples >=0, "task_callback: task_samples got negative");
-	while (samples > 0)
+	if (samples > 0)
 	{
-		/* step */
-		step_nodes();
-		samples--;
+		osd_ticks_t start = osd_ticks();
+
+		m_ticks_samples += samples;
+		while (samples > 0)
+		{
+			/* step */
+			step_nodes();
+			samples--;
+		}
+		m_ticks += osd_ticks() - start;
+
+		/* publish the whole slice to our consumers at once */
+		for_each(output_buffer *, ob, &m_buffers)
+			atomic_exchange32(&ob->written, ob->ptr - ob->node_buf);
 	}
 	if (m_samples == 0)
 	{
@@ -265,7 +293,10 @@ void discrete_task::prepare_for_queue(int samples)
 	m_samples = samples;
 	/* set up task buffers */
 	for_each(output_buffer *, ob, &m_buffers)
+	{
 		ob->ptr = ob->node_buf;
+		ob->written = 0;
+	}
 
 	/* initialize sources */
 	for_each(input_buffer *, sn, &source_list)
@@ -318,6 +349,7 @@ void discrete_task::check(discrete_task *dest_task)
 							buf.node_buf = auto_alloc_array(m_device.machine(), double,
 									((task_node->sample_rate() + sound_manager::STREAMS_UPDATE_FREQUENCY) / sound_manager::STREAMS_UPDATE_FREQUENCY));
 							buf.ptr = buf.node_buf;
+							buf.written = 0;
 							buf.source = dest_node->m_input[inputnum];
 							buf.node_num = inputnode_num;
 							//buf.node = device->discrete_find_node(inputnode);
@@ -833,6 +865,7 @@ discrete_device::discrete_device(const machine_config &mconfig, device_type type
 		m_indexed_node(NULL),
 		m_disclogfile(NULL),
 		m_queue(NULL),
+		m_parallel_tasks(false),
 		m_profiling(0),
 		m_total_samples(0),
 		m_total_stream_updates(0)
@@ -1041,12 +1074,26 @@ void discrete_device::process(int samples)
 		(*task)->prepare_for_queue(samples);
 	}
 
-	for_each(discrete_task **, task, &task_list)
+	if (m_parallel_tasks)
+	{
+		for_each(discrete_task **, task, &task_list)
+		{
+			/* Fire a work item for each task */
+			osd_work_item_queue(m_queue, discrete_task::task_callback, (void *) &task_list, WORK_ITEM_FLAG_AUTO_RELEASE);
+		}
+		osd_work_queue_wait(m_queue, osd_ticks_per_second()*10);
+	}
+	else
 	{
-		/* Fire a work item for each task */
-		osd_work_item_queue(m_queue, discrete_task::task_callback, (void *) &task_list, WORK_ITEM_FLAG_AUTO_RELEASE);
+		/* tasks only depend on lower groups, so in group order every task runs straight through */
+		for (int group = 0; group < DISCRETE_MAX_TASK_GROUPS; group++)
+			for_each(discrete_task **, task, &task_list)
+				if ((*task)->task_group == group)
+					while ((*task)->process())
+						;
 	}
-	osd_work_queue_wait(m_queue, osd_ticks_per_second()*10);
+
+	update_task_costs(samples);
 
 	if (m_profiling)
 	{
@@ -1055,6 +1102,43 @@ void discrete_device::process(int samples)
 	}
 }
 
+//-------------------------------------------------
+//  update_task_costs - fold this update's timings
+//  into each task's slice size, and decide
+//  whether the next update is worth running in
+//  parallel
+//-------------------------------------------------
+
+void discrete_device::update_task_costs(int samples)
+{
+	double slice_ticks = (double) osd_ticks_per_second() * TASK_SLICE_USEC / 1000000.0;
+	double total = 0, longest = 0;
+
+	for_each(discrete_task **, task, &task_list)
+	{
+		discrete_task *t = *task;
+
+		if (t->m_ticks_samples > 0)
+		{
+			double cost = (double) t->m_ticks / t->m_ticks_samples;
+			t->m_cost = (t->m_cost == 0) ? cost : t->m_cost * 0.9 + cost * 0.1;
+			t->m_ticks = 0;
+			t->m_ticks_samples = 0;
+		}
+
+		/* cheap tasks take bigger slices to amortize the handoffs */
+		if (t->m_cost > 0)
+			t->m_slice = MAX(MIN_SAMPLES_PER_TASK_SLICE, MIN(MAX_SAMPLES_PER_TASK_SLICE, (int) (slice_ticks / t->m_cost)));
+
+		total += t->m_cost * samples;
+		longest = MAX(longest, t->m_cost * samples);
+	}
+
+	/* only the work beside the slowest task can overlap with it */
+	double dispatch_ticks = (double) osd_ticks_per_second() * TASK_DISPATCH_USEC / 1000000.0;
+	m_parallel_tasks = (m_queue != NULL && task_list.count() > 1 && total - longest > dispatch_ticks);
+}
+
 //-------------------------------------------------
 //  sound_stream_update - handle update requests for
 //  our sound stream
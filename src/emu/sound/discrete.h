@@ -4354,6 +4354,7 @@ private:
 	void discrete_sanity_check(const sound_block_list_t &block_list);
 	void display_profiling(void);
 	void init_nodes(const sound_block_list_t &block_list);
+	void update_task_costs(int samples);
 
 	/* internal node tracking */
 	discrete_base_node **   m_indexed_node;
@@ -4366,6 +4367,7 @@ private:
 
 	/* parallel tasks */
 	osd_work_queue *        m_queue;
+	bool                    m_parallel_tasks;   /* did the last measurements favour the work queue? */
 
 	/* profiling */
 	int                     m_profiling;
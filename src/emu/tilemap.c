@@ -9,6 +9,7 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "tilerast.h"
 
 
 //**************************************************************************
@@ -95,236 +96,6 @@ inline bool tilemap_t::gfx_elements_changed()
 }
 
 
-//**************************************************************************
-//  SCANLINE RASTERIZERS
-//**************************************************************************
-
-//-------------------------------------------------
-//  scanline_draw_opaque_null - draw to a NULL
-//  bitmap, setting priority only
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_null(int count, UINT8 *pri, UINT32 pcode)
-{
-	// skip entirely if not changing priority
-	if (pcode == 0xff00)
-		return;
-
-	// update priority across the scanline
-	for (int i = 0; i < count; i++)
-		pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_null - draw to a NULL
-//  bitmap using a mask, setting priority only
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
-{
-	// skip entirely if not changing priority
-	if (pcode == 0xff00)
-		return;
-
-	// update priority across the scanline, checking the mask
-	for (int i = 0; i < count; i++)
-		if ((maskptr[i] & mask) == value)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-}
-
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_ind16 - draw to a 16bpp
-//  indexed bitmap
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode)
-{
-	// special case for no palette offset
-	int pal = pcode >> 16;
-	if (pal == 0)
-	{
-		// use memcpy which should be well-optimized for the platform
-		memcpy(dest, source, count * 2);
-
-		// skip the rest if not changing priority
-		if (pcode == 0xff00)
-			return;
-
-		// update priority across the scanline
-		for (int i = 0; i < count; i++)
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-	}
-
-	// priority case
-	else if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = source[i] + pal;
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = source[i] + pal;
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_ind16 - draw to a 16bpp
-//  indexed bitmap using a mask
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
-{
-	int pal = pcode >> 16;
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = source[i] + pal;
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = source[i] + pal;
-	}
-}
-
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_rgb32 - draw to a 32bpp
-//  RGB bitmap
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = clut[source[i]];
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = clut[source[i]];
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_rgb32 - draw to a 32bpp
-//  RGB bitmap using a mask
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = clut[source[i]];
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = clut[source[i]];
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_opaque_rgb32_alpha - draw to a
-//  32bpp RGB bitmap with alpha blending
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-		{
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-			pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-		}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
-}
-
-
-//-------------------------------------------------
-//  scanline_draw_masked_rgb32_alpha - draw to a
-//  32bpp RGB bitmap using a mask and alpha
-//  blending
-//-------------------------------------------------
-
-inline void tilemap_t::scanline_draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
-{
-	const pen_t *clut = &pens[pcode >> 16];
-
-	// priority case
-	if ((pcode & 0xffff) != 0xff00)
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-			{
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-				pri[i] = (pri[i] & (pcode >> 8)) | pcode;
-			}
-	}
-
-	// no priority case
-	else
-	{
-		for (int i = 0; i < count; i++)
-			if ((maskptr[i] & mask) == value)
-				dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
-	}
-}
-
-
 //**************************************************************************
 //  TILEMAP CREATION AND CONFIGURATION
 //**************************************************************************
@@ -397,6 +168,7 @@ tilemap_t &tilemap_t::init(tilemap_manager &manager, tilemap_get_info_delegate t
 	// allocate transparency mapping
 	m_flagsmap.allocate(m_width, m_height);
 	m_tileflags = NULL;
+	m_tiledirty = NULL;
 	memset(m_pen_to_flags, 0, sizeof(m_pen_to_flags));
 
 	// create the initial mappings
@@ -409,6 +181,7 @@ tilemap_t &tilemap_t::init(tilemap_manager &manager, tilemap_get_info_delegate t
 
 	// allocate transparency mapping data
 	m_tileflags = auto_alloc_array(machine(), UINT8, m_max_logical_index);
+	m_tiledirty = auto_alloc_array_clear(machine(), UINT32, (m_max_logical_index + 31) / 32);
 	for (int group = 0; group < TILEMAP_NUM_GROUPS; group++)
 		map_pens_to_layer(group, 0, 0, TILEMAP_PIXEL_LAYER0);
 
@@ -457,6 +230,7 @@ void tilemap_t::mark_tile_dirty(tilemap_memory_index memindex)
 		if (logindex != INVALID_LOGICAL_INDEX)
 		{
 			m_tileflags[logindex] = TILE_FLAG_DIRTY;
+			m_tiledirty[logindex / 32] |= 1U << (logindex % 32);
 			m_all_tiles_clean = false;
 		}
 	}
@@ -687,6 +461,7 @@ inline void tilemap_t::realize_all_dirty_tiles()
 	if (m_all_tiles_dirty || gfx_elements_changed())
 	{
 		memset(m_tileflags, TILE_FLAG_DIRTY, m_max_logical_index);
+		memset(m_tiledirty, 0xff, (m_max_logical_index + 31) / 32 * sizeof(m_tiledirty[0]));
 		m_all_tiles_dirty = false;
 		m_gfx_used = 0;
 	}
@@ -711,12 +486,8 @@ g_profiler.start(PROFILER_TILEMAP_DRAW);
 	// flush the dirty state to all tiles as appropriate
 	realize_all_dirty_tiles();
 
-	// iterate over rows and columns
-	logical_index logindex = 0;
-	for (int row = 0; row < m_rows; row++)
-		for (int col = 0; col < m_cols; col++, logindex++)
-			if (m_tileflags[logindex] == TILE_FLAG_DIRTY)
-				tile_update(logindex, col, row);
+	// realize every dirty tile
+	realize_dirty_tiles(0, m_cols, 0, m_rows);
 
 	// mark it all clean
 	m_all_tiles_clean = true;
@@ -725,11 +496,93 @@ g_profiler.stop();
 }
 
 
+//-------------------------------------------------
+//  realize_dirty_tiles - update all dirty tiles
+//  within a range of columns and rows (max
+//  values exclusive); tile info is fetched in
+//  order on this thread, then the tiles are
+//  drawn in parallel
+//-------------------------------------------------
+
+void tilemap_t::realize_dirty_tiles(UINT32 mincol, UINT32 maxcol, UINT32 minrow, UINT32 maxrow)
+{
+	// fetch info for each dirty tile, skipping clean ones a word at a time
+	m_realize.resize(0);
+	for (UINT32 row = minrow; row < maxrow; row++)
+		for (UINT32 col = mincol; col < maxcol; )
+		{
+			logical_index logindex = row * m_cols + col;
+			UINT32 bits = m_tiledirty[logindex / 32] >> (logindex % 32);
+			if (bits == 0)
+				col += 32 - logindex % 32;
+			else
+			{
+				if (bits & 1)
+				{
+					realize_entry entry;
+					tile_fetch(logindex, col, row, entry);
+					m_realize.append(entry);
+				}
+				col++;
+			}
+		}
+
+	// small batches aren't worth handing off
+	int count = m_realize.count();
+	osd_work_queue *queue = m_manager->work_queue();
+	if (count <= REALIZE_BATCH_TILES || queue == NULL)
+	{
+		for (int index = 0; index < count; index++)
+			tile_realize(m_realize[index]);
+		return;
+	}
+
+	// otherwise, split them into runs and draw those on the work queue
+	int batches = (count + REALIZE_BATCH_TILES - 1) / REALIZE_BATCH_TILES;
+	m_realize_batch.resize(batches);
+	for (int batchnum = 0; batchnum < batches; batchnum++)
+	{
+		m_realize_batch[batchnum].tilemap = this;
+		m_realize_batch[batchnum].entry = &m_realize[batchnum * REALIZE_BATCH_TILES];
+		m_realize_batch[batchnum].count = MIN(REALIZE_BATCH_TILES, count - batchnum * REALIZE_BATCH_TILES);
+	}
+	osd_work_item_queue_multiple(queue, realize_batch_callback, batches, &m_realize_batch[0], sizeof(m_realize_batch[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+	while (!osd_work_queue_wait(queue, osd_ticks_per_second() * 10)) ;
+}
+
+
+//-------------------------------------------------
+//  realize_batch_callback - work item callback to
+//  draw a run of fetched tiles
+//-------------------------------------------------
+
+void *tilemap_t::realize_batch_callback(void *param, int threadid)
+{
+	realize_batch &batch = *reinterpret_cast<realize_batch *>(param);
+	for (int index = 0; index < batch.count; index++)
+		batch.tilemap->tile_realize(batch.entry[index]);
+	return NULL;
+}
+
+
 //-------------------------------------------------
 //  tile_update - update a single dirty tile
 //-------------------------------------------------
 
 void tilemap_t::tile_update(logical_index logindex, UINT32 col, UINT32 row)
+{
+	realize_entry entry;
+	tile_fetch(logindex, col, row, entry);
+	tile_realize(entry);
+}
+
+
+//-------------------------------------------------
+//  tile_fetch - call the get info callback for a
+//  dirty tile and capture what it returned
+//-------------------------------------------------
+
+void tilemap_t::tile_fetch(logical_index logindex, UINT32 col, UINT32 row, realize_entry &entry)
 {
 g_profiler.start(PROFILER_TILEMAP_UPDATE);
 
@@ -737,18 +590,20 @@ g_profiler.start(PROFILER_TILEMAP_UPDATE);
 	tilemap_memory_index memindex = m_logical_to_memory[logindex];
 	m_tile_get_info(*this, m_tileinfo, memindex);
 
-	// apply the global tilemap flip to the returned flip flags
-	UINT32 flags = m_tileinfo.flags ^ (m_attributes & 0x03);
-
-	// draw the tile, using either direct or transparent
-	UINT32 x0 = m_tilewidth * col;
-	UINT32 y0 = m_tileheight * row;
-	m_tileflags[logindex] = tile_draw(m_tileinfo.pen_data + m_pen_data_offset, x0, y0,
-		m_tileinfo.palette_base, m_tileinfo.category, m_tileinfo.group, flags, m_tileinfo.pen_mask);
-
-	// if mask data is specified, apply it
-	if ((flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && m_tileinfo.mask_data != NULL)
-		m_tileflags[logindex] = tile_apply_bitmask(m_tileinfo.mask_data, x0, y0, m_tileinfo.category, flags);
+	// capture everything needed to draw the tile, applying the global tilemap flip to the flip flags
+	entry.logindex = logindex;
+	entry.x0 = m_tilewidth * col;
+	entry.y0 = m_tileheight * row;
+	entry.pen_data = m_tileinfo.pen_data + m_pen_data_offset;
+	entry.mask_data = m_tileinfo.mask_data;
+	entry.palette_base = m_tileinfo.palette_base;
+	entry.category = m_tileinfo.category;
+	entry.group = m_tileinfo.group;
+	entry.flags = m_tileinfo.flags ^ (m_attributes & 0x03);
+	entry.pen_mask = m_tileinfo.pen_mask;
+
+	// the tile is no longer dirty as far as fetching goes
+	m_tiledirty[logindex / 32] &= ~(1U << (logindex % 32));
 
 	// track which gfx have been used for this tilemap
 	if (m_tileinfo.gfxnum != 0xff && (m_gfx_used & (1 << m_tileinfo.gfxnum)) == 0)
@@ -761,6 +616,26 @@ g_profiler.stop();
 }
 
 
+//-------------------------------------------------
+//  tile_realize - draw a fetched tile into the
+//  pixmap and flagsmap; this touches only the
+//  tile's own pixels and flags, so distinct tiles
+//  may be realized concurrently
+//-------------------------------------------------
+
+void tilemap_t::tile_realize(const realize_entry &entry)
+{
+	// draw the tile, using either direct or transparent
+	UINT8 tileflags = tile_draw(entry.pen_data, entry.x0, entry.y0,
+		entry.palette_base, entry.category, entry.group, entry.flags, entry.pen_mask);
+
+	// if mask data is specified, apply it
+	if ((entry.flags & (TILE_FORCE_LAYER0 | TILE_FORCE_LAYER1 | TILE_FORCE_LAYER2)) == 0 && entry.mask_data != NULL)
+		tileflags = tile_apply_bitmask(entry.mask_data, entry.x0, entry.y0, entry.category, entry.flags);
+	m_tileflags[entry.logindex] = tileflags;
+}
+
+
 //-------------------------------------------------
 //  tile_draw - draw a single tile to the
 //  tilemap's internal pixmap, using the pen as
@@ -1131,6 +1006,9 @@ void tilemap_t::draw_instance(_BitmapClass &dest, const blit_parameters &blit, i
 	int mincol = x1 / m_tilewidth;
 	int maxcol = (x2 + m_tilewidth - 1) / m_tilewidth;
 
+	// realize the dirty tiles we're about to draw up front, so they can be drawn in parallel
+	realize_dirty_tiles(mincol, maxcol, y1 / m_tileheight, (y2 - 1) / m_tileheight + 1);
+
 	// set up row counter
 	int y = y1;
 	int nexty = m_tileheight * (y1 / m_tileheight) + m_tileheight;
@@ -1194,13 +1072,13 @@ void tilemap_t::draw_instance(_BitmapClass &dest, const blit_parameters &blit, i
 					for (int cury = y; cury < nexty; cury++)
 					{
 						if (dest_baseaddr == NULL)
-							scanline_draw_opaque_null(x_end - x_start, pmap0, blit.tilemap_priority_code);
+							tilemap_scanline<true>::draw_opaque_null(x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 2)
-							scanline_draw_opaque_ind16(reinterpret_cast<UINT16 *>(dest0), source0, x_end - x_start, pmap0, blit.tilemap_priority_code);
+							tilemap_scanline<true>::draw_opaque_ind16(reinterpret_cast<UINT16 *>(dest0), source0, x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4 && blit.alpha >= 0xff)
-							scanline_draw_opaque_rgb32(reinterpret_cast<UINT32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
+							tilemap_scanline<true>::draw_opaque_rgb32(reinterpret_cast<UINT32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4)
-							scanline_draw_opaque_rgb32_alpha(reinterpret_cast<UINT32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
+							tilemap_scanline<true>::draw_opaque_rgb32_alpha(reinterpret_cast<UINT32 *>(dest0), source0, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
 
 						dest0 += dest_rowpixels;
 						source0 += m_pixmap.rowpixels();
@@ -1215,13 +1093,13 @@ void tilemap_t::draw_instance(_BitmapClass &dest, const blit_parameters &blit, i
 					for (int cury = y; cury < nexty; cury++)
 					{
 						if (dest_baseaddr == NULL)
-							scanline_draw_masked_null(mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
+							tilemap_scanline<true>::draw_masked_null(mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 2)
-							scanline_draw_masked_ind16(reinterpret_cast<UINT16 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
+							tilemap_scanline<true>::draw_masked_ind16(reinterpret_cast<UINT16 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4 && blit.alpha >= 0xff)
-							scanline_draw_masked_rgb32(reinterpret_cast<UINT32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
+							tilemap_scanline<true>::draw_masked_rgb32(reinterpret_cast<UINT32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code);
 						else if (sizeof(*dest0) == 4)
-							scanline_draw_masked_rgb32_alpha(reinterpret_cast<UINT32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
+							tilemap_scanline<true>::draw_masked_rgb32_alpha(reinterpret_cast<UINT32 *>(dest0), source0, mask0, blit.mask, blit.value, x_end - x_start, clut, pmap0, blit.tilemap_priority_code, blit.alpha);
 
 						dest0 += dest_rowpixels;
 						source0 += m_pixmap.rowpixels();
@@ -1471,8 +1349,20 @@ void tilemap_t::draw_debug(bitmap_rgb32 &dest, UINT32 scrollx, UINT32 scrolly)
 
 tilemap_manager::tilemap_manager(running_machine &machine)
 	: m_machine(machine),
-		m_instance(0)
+		m_instance(0),
+		m_work_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ))
+{
+}
+
+
+//-------------------------------------------------
+//  ~tilemap_manager - destructor
+//-------------------------------------------------
+
+tilemap_manager::~tilemap_manager()
 {
+	if (m_work_queue != NULL)
+		osd_work_queue_free(m_work_queue);
 }
 
 
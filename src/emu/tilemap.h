@@ -478,6 +478,9 @@ class tilemap_t
 	// invalid logical index
 	static const logical_index INVALID_LOGICAL_INDEX = (logical_index)~0;
 
+	// most tiles drawn by a single work item when realizing tiles in parallel
+	static const int REALIZE_BATCH_TILES = 64;
+
 	// maximum index in each array
 	static const int MAX_PEN_TO_FLAGS = 256;
 
@@ -567,6 +570,28 @@ private:
 		MASKED
 	};
 
+	// a dirty tile whose info has been fetched, waiting to be drawn
+	struct realize_entry
+	{
+		logical_index       logindex;
+		UINT32              x0, y0;
+		const UINT8 *       pen_data;
+		const UINT8 *       mask_data;
+		pen_t               palette_base;
+		UINT8               category;
+		UINT8               group;
+		UINT8               flags;
+		UINT8               pen_mask;
+	};
+
+	// a run of fetched tiles drawn by one work item
+	struct realize_batch
+	{
+		tilemap_t *         tilemap;
+		const realize_entry *entry;
+		int                 count;
+	};
+
 	// blitting parameters for rendering
 	struct blit_parameters
 	{
@@ -583,16 +608,6 @@ private:
 	INT32 effective_colscroll(int index, UINT32 screen_height);
 	bool gfx_elements_changed();
 
-	// inline scanline rasterizers
-	void scanline_draw_opaque_null(int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode);
-	void scanline_draw_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-	void scanline_draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
-
 	// internal helpers
 	void postload();
 	void mappings_create();
@@ -601,7 +616,11 @@ private:
 
 	// internal drawing
 	void pixmap_update();
+	void realize_dirty_tiles(UINT32 mincol, UINT32 maxcol, UINT32 minrow, UINT32 maxrow);
 	void tile_update(logical_index logindex, UINT32 col, UINT32 row);
+	void tile_fetch(logical_index logindex, UINT32 col, UINT32 row, realize_entry &entry);
+	void tile_realize(const realize_entry &entry);
+	static void *realize_batch_callback(void *param, int threadid);
 	UINT8 tile_draw(const UINT8 *pendata, UINT32 x0, UINT32 y0, UINT32 palette_base, UINT8 category, UINT8 group, UINT8 flags, UINT8 pen_mask);
 	UINT8 tile_apply_bitmask(const UINT8 *maskdata, UINT32 x0, UINT32 y0, UINT8 category, UINT8 flags);
 	void configure_blit_parameters(blit_parameters &blit, bitmap_ind8 &priority_bitmap, const rectangle &cliprect, UINT32 flags, UINT8 priority, UINT8 priority_mask);
@@ -665,6 +684,9 @@ private:
 	// transparency mapping
 	bitmap_ind8                 m_flagsmap;             // per-pixel flags
 	UINT8 *                     m_tileflags;            // per-tile flags
+	UINT32 *                    m_tiledirty;            // bitset of dirty tiles by logical index
+	dynamic_array<realize_entry> m_realize;             // tiles fetched for the current realize pass
+	dynamic_array<realize_batch> m_realize_batch;       // work item parameters for the current pass
 	UINT8                       m_pen_to_flags[MAX_PEN_TO_FLAGS * TILEMAP_NUM_GROUPS]; // mapping of pens to flags
 };
 
@@ -679,9 +701,11 @@ class tilemap_manager
 public:
 	// construction/destuction
 	tilemap_manager(running_machine &machine);
+	~tilemap_manager();
 
 	// getters
 	running_machine &machine() const { return m_machine; }
+	osd_work_queue *work_queue() const { return m_work_queue; }
 
 	// tilemap creation
 	tilemap_t &create(tilemap_get_info_delegate tile_get_info, tilemap_mapper_delegate mapper, int tilewidth, int tileheight, int cols, int rows, tilemap_t *allocated = NULL);
@@ -703,6 +727,7 @@ private:
 	running_machine &       m_machine;
 	simple_list<tilemap_t>  m_tilemap_list;
 	int                     m_instance;
+	osd_work_queue *        m_work_queue;           // queue for realizing tiles in parallel
 };
 
 
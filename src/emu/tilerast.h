@@ -0,0 +1,342 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    tilerast.h
+
+    Scanline rasterizers for the tilemap system.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __TILERAST_H__
+#define __TILERAST_H__
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> tilemap_scanline
+
+// draws one row of a tilemap run; _UseSSE2 picks the vector loops when the
+// build has them, and the scalar loops alone otherwise
+template<bool _UseSSE2>
+class tilemap_scanline
+{
+public:
+	static void draw_opaque_null(int count, UINT8 *pri, UINT32 pcode);
+	static void draw_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode);
+	static void draw_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode);
+	static void draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode);
+	static void draw_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode);
+	static void draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode);
+	static void draw_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
+	static void draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha);
+
+private:
+	static void priority_opaque(UINT8 *pri, int count, UINT32 pcode);
+	static void priority_masked(UINT8 *pri, const UINT8 *maskptr, int mask, int value, int count, UINT32 pcode);
+};
+
+
+
+//**************************************************************************
+//  SCANLINE RASTERIZERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  priority_opaque - apply a priority
+//  code across a run of the priority bitmap
+//-------------------------------------------------
+
+template<bool _UseSSE2>
+inline void tilemap_scanline<_UseSSE2>::priority_opaque(UINT8 *pri, int count, UINT32 pcode)
+{
+	UINT8 andmask = pcode >> 8;
+	UINT8 ormask = pcode;
+	int i = 0;
+
+#ifdef __SSE2__
+	if (_UseSSE2)
+	{
+		// 16 pixels at a time
+		const __m128i vand = _mm_set1_epi8(andmask);
+		const __m128i vor = _mm_set1_epi8(ormask);
+		for ( ; i + 16 <= count; i += 16)
+		{
+			__m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pri[i]));
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(&pri[i]), _mm_or_si128(_mm_and_si128(p, vand), vor));
+		}
+	}
+#endif
+
+	for ( ; i < count; i++)
+		pri[i] = (pri[i] & andmask) | ormask;
+}
+
+
+//-------------------------------------------------
+//  priority_masked - apply a priority
+//  code to the pixels in a run whose flags match
+//-------------------------------------------------
+
+template<bool _UseSSE2>
+inline void tilemap_scanline<_UseSSE2>::priority_masked(UINT8 *pri, const UINT8 *maskptr, int mask, int value, int count, UINT32 pcode)
+{
+	UINT8 andmask = pcode >> 8;
+	UINT8 ormask = pcode;
+	int i = 0;
+
+#ifdef __SSE2__
+	if (_UseSSE2)
+	{
+		// 16 pixels at a time, selecting the updated value where the flags match
+		const __m128i vand = _mm_set1_epi8(andmask);
+		const __m128i vor = _mm_set1_epi8(ormask);
+		const __m128i vmask = _mm_set1_epi8(mask);
+		const __m128i vvalue = _mm_set1_epi8(value);
+		for ( ; i + 16 <= count; i += 16)
+		{
+			__m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&pri[i]));
+			__m128i m = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&maskptr[i])), vmask), vvalue);
+			__m128i np = _mm_or_si128(_mm_and_si128(p, vand), vor);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(&pri[i]), _mm_or_si128(_mm_and_si128(m, np), _mm_andnot_si128(m, p)));
+		}
+	}
+#endif
+
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			pri[i] = (pri[i] & andmask) | ormask;
+}
+
+
+//-------------------------------------------------
+//  draw_opaque_null - draw to a NULL
+//  bitmap, setting priority only
+//-------------------------------------------------
+
+template<bool _UseSSE2>
+inline void tilemap_scanline<_UseSSE2>::draw_opaque_null(int count, UINT8 *pri, UINT32 pcode)
+{
+	// skip entirely if not changing priority
+	if (pcode == 0xff00)
+		return;
+
+	// update priority across the scanline
+	priority_opaque(pri, count, pcode);
+}
+
+
+//-------------------------------------------------
+//  draw_masked_null - draw to a NULL
+//  bitmap using a mask, setting priority only
+//-------------------------------------------------
+
+template<bool _UseSSE2>
+inline void tilemap_scanline<_UseSSE2>::draw_masked_null(const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
+{
+	// skip entirely if not changing priority
+	if (pcode == 0xff00)
+		return;
+
+	// update priority across the scanline, checking the mask
+	priority_masked(pri, maskptr, mask, value, count, pcode);
+}
+
+
+//-------------------------------------------------
+//  draw_opaque_ind16 - draw to a 16bpp
+//  indexed bitmap
+//-------------------------------------------------
+
+template<bool _UseSSE2>
+inline void tilemap_scanline<_UseSSE2>::draw_opaque_ind16(UINT16 *dest, const UINT16 *source, int count, UINT8 *pri, UINT32 pcode)
+{
+	// special case for no palette offset
+	int pal = pcode >> 16;
+	if (pal == 0)
+	{
+		// use memcpy which should be well-optimized for the platform
+		memcpy(dest, source, count * 2);
+	}
+
+	// otherwise, add the palette offset
+	else
+	{
+		int i = 0;
+#ifdef __SSE2__
+		if (_UseSSE2)
+		{
+			const __m128i vpal = _mm_set1_epi16(pal);
+			for ( ; i + 8 <= count; i += 8)
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i]), _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[i])), vpal));
+		}
+#endif
+		for ( ; i < count; i++)
+			dest[i] = source[i] + pal;
+	}
+
+	// update priority across the scanline
+	if ((pcode & 0xffff) != 0xff00)
+		priority_opaque(pri, count, pcode);
+}
+
+
+//-------------------------------------------------
+//  draw_masked_ind16 - draw to a 16bpp
+//  indexed bitmap using a mask
+//-------------------------------------------------
+
+template<bool _UseSSE2>
+inline void tilemap_scanline<_UseSSE2>::draw_masked_ind16(UINT16 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, UINT8 *pri, UINT32 pcode)
+{
+	int pal = pcode >> 16;
+	int i = 0;
+
+#ifdef __SSE2__
+	if (_UseSSE2)
+	{
+		// 8 pixels at a time, widening the byte flag comparison to select words
+		const __m128i vpal = _mm_set1_epi16(pal);
+		const __m128i vmask = _mm_set1_epi8(mask);
+		const __m128i vvalue = _mm_set1_epi8(value);
+		for ( ; i + 8 <= count; i += 8)
+		{
+			__m128i m = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(&maskptr[i])), vmask), vvalue);
+			m = _mm_unpacklo_epi8(m, m);
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&dest[i]));
+			__m128i s = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&source[i])), vpal);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i]), _mm_or_si128(_mm_and_si128(m, s), _mm_andnot_si128(m, d)));
+		}
+	}
+#endif
+
+	for ( ; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			dest[i] = source[i] + pal;
+
+	// update priority across the scanline
+	if ((pcode & 0xffff) != 0xff00)
+		priority_masked(pri, maskptr, mask, value, count, pcode);
+}
+
+
+//-------------------------------------------------
+//  draw_opaque_rgb32 - draw to a 32bpp
+//  RGB bitmap
+//-------------------------------------------------
+
+template<bool _UseSSE2>
+inline void tilemap_scanline<_UseSSE2>::draw_opaque_rgb32(UINT32 *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode)
+{
+	const pen_t *clut = &pens[pcode >> 16];
+
+	// look up 4 pixels at a time to overlap the loads
+	int i = 0;
+	for ( ; i + 4 <= count; i += 4)
+	{
+		UINT32 p0 = clut[source[i + 0]], p1 = clut[source[i + 1]];
+		UINT32 p2 = clut[source[i + 2]], p3 = clut[source[i + 3]];
+		dest[i + 0] = p0;
+		dest[i + 1] = p1;
+		dest[i + 2] = p2;
+		dest[i + 3] = p3;
+	}
+	for ( ; i < count; i++)
+		dest[i] = clut[source[i]];
+
+	// update priority across the scanline
+	if ((pcode & 0xffff) != 0xff00)
+		priority_opaque(pri, count, pcode);
+}
+
+
+//-------------------------------------------------
+//  draw_masked_rgb32 - draw to a 32bpp
+//  RGB bitmap using a mask
+//-------------------------------------------------
+
+template<bool _UseSSE2>
+inline void tilemap_scanline<_UseSSE2>::draw_masked_rgb32(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode)
+{
+	const pen_t *clut = &pens[pcode >> 16];
+
+	for (int i = 0; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			dest[i] = clut[source[i]];
+
+	// update priority across the scanline
+	if ((pcode & 0xffff) != 0xff00)
+		priority_masked(pri, maskptr, mask, value, count, pcode);
+}
+
+
+//-------------------------------------------------
+//  draw_opaque_rgb32_alpha - draw to a
+//  32bpp RGB bitmap with alpha blending
+//-------------------------------------------------
+
+template<bool _UseSSE2>
+inline void tilemap_scanline<_UseSSE2>::draw_opaque_rgb32_alpha(UINT32 *dest, const UINT16 *source, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
+{
+	const pen_t *clut = &pens[pcode >> 16];
+	int i = 0;
+
+#ifdef __SSE2__
+	if (_UseSSE2)
+	{
+		// 4 pixels at a time; this matches alpha_blend_r32 exactly, since
+		// s * alpha + d * (256 - alpha) never exceeds 16 bits per channel
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i salpha = _mm_set1_epi16(alpha);
+		const __m128i dalpha = _mm_set1_epi16(256 - alpha);
+		const __m128i rgbmask = _mm_set1_epi32(0x00ffffff);
+		for ( ; i + 4 <= count; i += 4)
+		{
+			__m128i s = _mm_set_epi32(clut[source[i + 3]], clut[source[i + 2]], clut[source[i + 1]], clut[source[i + 0]]);
+			__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&dest[i]));
+			__m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), salpha), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), dalpha)), 8);
+			__m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), salpha), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), dalpha)), 8);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(&dest[i]), _mm_and_si128(_mm_packus_epi16(lo, hi), rgbmask));
+		}
+	}
+#endif
+
+	for ( ; i < count; i++)
+		dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+
+	// update priority across the scanline
+	if ((pcode & 0xffff) != 0xff00)
+		priority_opaque(pri, count, pcode);
+}
+
+
+//-------------------------------------------------
+//  draw_masked_rgb32_alpha - draw to a
+//  32bpp RGB bitmap using a mask and alpha
+//  blending
+//-------------------------------------------------
+
+template<bool _UseSSE2>
+inline void tilemap_scanline<_UseSSE2>::draw_masked_rgb32_alpha(UINT32 *dest, const UINT16 *source, const UINT8 *maskptr, int mask, int value, int count, const pen_t *pens, UINT8 *pri, UINT32 pcode, UINT8 alpha)
+{
+	const pen_t *clut = &pens[pcode >> 16];
+
+	for (int i = 0; i < count; i++)
+		if ((maskptr[i] & mask) == value)
+			dest[i] = alpha_blend_r32(dest[i], clut[source[i]], alpha);
+
+	// update priority across the scanline
+	if ((pcode & 0xffff) != 0xff00)
+		priority_masked(pri, maskptr, mask, value, count, pcode);
+}
+
+
+#endif  /* __TILERAST_H__ */
@@ -1490,6 +1490,10 @@ static UINT32 handler_ingame(running_machine &machine, render_container *contain
 		return ui_set_handler(handler_load_save, LOADSAVE_LOAD);
 	}
 
+	/* handle a rewind request; this leaves us paused on the earlier frame */
+	if (ui_input_pressed(machine, IPT_UI_REWIND_SINGLE))
+		machine.schedule_rewind();
+
 	/* handle a save snapshot request */
 	if (ui_input_pressed(machine, IPT_UI_SNAPSHOT))
 		machine.video().save_active_screen_snapshots();
@@ -104,7 +104,15 @@ video_manager::video_manager(running_machine &machine)
 		m_avifile(NULL),
 		m_movie_frame_period(attotime::zero),
 		m_movie_next_frame_time(attotime::zero),
-		m_movie_frame(0)
+		m_movie_frame(0),
+		m_movie_queue(NULL),
+		m_movie_slot(0),
+		m_movie_drop(machine.options().movie_drop()),
+		m_movie_error(false),
+		m_movie_owed(0),
+		m_movie_dropped(0),
+		m_movie_waits(0),
+		m_movie_wait_ticks(0)
 {
 	// request a callback upon exiting
 	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(video_manager::exit), this));
@@ -367,6 +375,21 @@ void video_manager::begin_recording(const char *name, movie_format format)
 	// reset the state
 	m_movie_frame = 0;
 	m_movie_next_frame_time = machine().time();
+	m_movie_slot = 0;
+	m_movie_error = false;
+	m_movie_owed = 0;
+	m_movie_dropped = 0;
+	m_movie_waits = 0;
+	m_movie_wait_ticks = 0;
+
+	// frames are encoded in the background, in order, on a single thread
+	if (m_movie_queue == NULL)
+		m_movie_queue = osd_work_queue_alloc(0);
+	for (int slot = 0; slot < MOVIE_QUEUE_DEPTH; slot++)
+	{
+		m_movie_frames[slot].m_manager = this;
+		m_movie_frames[slot].m_item = NULL;
+	}
 
 	// start up an AVI recording
 	if (format == MF_AVI)
@@ -454,6 +477,32 @@ void video_manager::begin_recording(const char *name, movie_format format)
 
 void video_manager::end_recording()
 {
+	// let the encoder catch up before closing anything
+	if (m_movie_queue != NULL)
+	{
+		while (!osd_work_queue_wait(m_movie_queue, osd_ticks_per_second() * 10)) ;
+		for (int slot = 0; slot < MOVIE_QUEUE_DEPTH; slot++)
+			if (m_movie_frames[slot].m_item != NULL)
+			{
+				osd_work_item_release(m_movie_frames[slot].m_item);
+				m_movie_frames[slot].m_item = NULL;
+			}
+
+		// frames dropped since the last one queued are still owed; with the
+		// encoder idle, write them as copies of that last frame
+		if (m_movie_owed != 0)
+		{
+			movie_frame &last = m_movie_frames[(m_movie_slot + MOVIE_QUEUE_DEPTH - 1) % MOVIE_QUEUE_DEPTH];
+			last.m_number = m_movie_frame - m_movie_owed;
+			last.m_repeat = m_movie_owed;
+			m_movie_owed = 0;
+			encode_frame(last);
+		}
+	}
+	if (m_movie_frame != 0)
+		mame_printf_verbose("Movie: %d frames, %d waited for the encoder (%d ms total), %d repeated\n", m_movie_frame, m_movie_waits,
+				(int)(m_movie_wait_ticks * 1000 / osd_ticks_per_second()), m_movie_dropped);
+
 	// close the file if it exists
 	if (m_avifile != NULL)
 	{
@@ -484,14 +533,19 @@ void video_manager::add_sound_to_recording(const INT16 *sound, int numsamples)
 	// only record if we have a file
 	if (m_avifile != NULL)
 	{
+		// stop if the encoder ran into trouble
+		if (m_movie_error)
+			return end_recording();
+
 		g_profiler.start(PROFILER_MOVIE_REC);
 
-		// write the next frame
-		avi_error avierr = avi_append_sound_samples(m_avifile, 0, sound + 0, numsamples, 1);
-		if (avierr == AVIERR_NONE)
-			avierr = avi_append_sound_samples(m_avifile, 1, sound + 1, numsamples, 1);
-		if (avierr != AVIERR_NONE)
-			end_recording();
+		// hand a copy of the samples to the encoder; it keeps them in order with the frames
+		movie_sound *block = global_alloc(movie_sound);
+		block->m_manager = this;
+		block->m_samples = global_alloc_array(INT16, numsamples * 2);
+		block->m_numsamples = numsamples;
+		memcpy(block->m_samples, sound, numsamples * 2 * sizeof(INT16));
+		osd_work_item_queue(m_movie_queue, encode_sound_static, block, WORK_ITEM_FLAG_AUTO_RELEASE);
 
 		g_profiler.stop();
 	}
@@ -507,6 +561,8 @@ void video_manager::exit()
 {
 	// stop recording any movie
 	end_recording();
+	if (m_movie_queue != NULL)
+		osd_work_queue_free(m_movie_queue);
 
 	// free all the graphics elements
 	for (int i = 0; i < MAX_GFX_ELEMENTS; i++)
@@ -1051,7 +1107,7 @@ void video_manager::create_snapshot_bitmap(screen_device *screen)
 	// render the screen there
 	render_primitive_list &primlist = m_snap_target->get_primitives();
 	primlist.acquire_lock();
-	software_renderer<UINT32, 0,0,0, 16,8,0, false, true>::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels());
+	software_renderer<UINT32, 0,0,0, 16,8,0, false, true>::draw_primitives(primlist, &m_snap_bitmap.pix32(0), width, height, m_snap_bitmap.rowpixels(), machine().render().work_queue());
 	primlist.release_lock();
 }
 
@@ -1195,25 +1251,107 @@ void video_manager::record_frame()
 	if (m_mngfile == NULL && m_avifile == NULL)
 		return;
 
+	// stop if the encoder ran into trouble
+	if (m_movie_error)
+		return end_recording();
+
 	// start the profiler and get the current time
 	g_profiler.start(PROFILER_MOVIE_REC);
 	attotime curtime = machine().time();
 
+	// figure out how many copies of this frame we need to hit the right time
+	int repeat = 0;
+	while (m_movie_next_frame_time <= curtime)
+	{
+		m_movie_next_frame_time += m_movie_frame_period;
+		repeat++;
+	}
+	if (repeat == 0)
+	{
+		g_profiler.stop();
+		return;
+	}
+
 	// create the bitmap
 	create_snapshot_bitmap(NULL);
 
-	// loop until we hit the right time
-	while (m_movie_next_frame_time <= curtime)
+	// wait for the next frame in the pool to be free, or repeat the previous one if we can't wait
+	movie_frame &frame = m_movie_frames[m_movie_slot];
+	if (frame.m_item != NULL)
+	{
+		if (!osd_work_item_wait(frame.m_item, 0))
+		{
+			if (m_movie_drop && m_movie_frame != 0)
+			{
+				m_movie_owed += repeat;
+				m_movie_dropped += repeat;
+				m_movie_frame += repeat;
+				g_profiler.stop();
+				return;
+			}
+
+			osd_ticks_t start = osd_ticks();
+			while (!osd_work_item_wait(frame.m_item, osd_ticks_per_second() * 10)) ;
+			m_movie_waits++;
+			m_movie_wait_ticks += osd_ticks() - start;
+		}
+		osd_work_item_release(frame.m_item);
+		frame.m_item = NULL;
+	}
+
+	// copy the snapshot and hand it to the encoder
+	if (frame.m_bitmap.width() != m_snap_bitmap.width() || frame.m_bitmap.height() != m_snap_bitmap.height())
+		frame.m_bitmap.allocate(m_snap_bitmap.width(), m_snap_bitmap.height());
+	for (int y = 0; y < m_snap_bitmap.height(); y++)
+		memcpy(&frame.m_bitmap.pix32(y), &m_snap_bitmap.pix32(y), m_snap_bitmap.width() * sizeof(UINT32));
+
+	// the first copy carries any frames we repeated rather than waiting for
+	frame.m_number = m_movie_frame - m_movie_owed;
+	frame.m_repeat = repeat + m_movie_owed;
+	m_movie_frame += repeat;
+	m_movie_owed = 0;
+	frame.m_item = osd_work_item_queue(m_movie_queue, encode_frame_static, &frame, 0);
+	m_movie_slot = (m_movie_slot + 1) % MOVIE_QUEUE_DEPTH;
+
+	g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  encode_frame_static - work item callback to
+//  encode a movie frame
+//-------------------------------------------------
+
+void *video_manager::encode_frame_static(void *param, int threadid)
+{
+	movie_frame &frame = *reinterpret_cast<movie_frame *>(param);
+	frame.m_manager->encode_frame(frame);
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  encode_frame - write a movie frame to the
+//  file; called on the encoding thread
+//-------------------------------------------------
+
+void video_manager::encode_frame(movie_frame &frame)
+{
+	// once there's an error, don't bother
+	if (m_movie_error)
+		return;
+
+	for (int copy = 0; copy < frame.m_repeat; copy++)
 	{
 		// handle an AVI recording
 		if (m_avifile != NULL)
 		{
 			// write the next frame
-			avi_error avierr = avi_append_video_frame(m_avifile, m_snap_bitmap);
+			avi_error avierr = avi_append_video_frame(m_avifile, frame.m_bitmap);
 			if (avierr != AVIERR_NONE)
 			{
-				g_profiler.stop();
-				return end_recording();
+				m_movie_error = true;
+				return;
 			}
 		}
 
@@ -1222,7 +1360,7 @@ void video_manager::record_frame()
 		{
 			// set up the text fields in the movie info
 			png_info pnginfo = { 0 };
-			if (m_movie_frame == 0)
+			if (frame.m_number + copy == 0)
 			{
 				astring text1(emulator_info::get_appname(), " ", build_version);
 				astring text2(machine().system().manufacturer, " ", machine().system().description);
@@ -1230,22 +1368,50 @@ void video_manager::record_frame()
 				png_add_text(&pnginfo, "System", text2);
 			}
 
-			// write the next frame
-			const rgb_t *palette = (machine().palette != NULL) ? palette_entry_list_adjusted(machine().palette) : NULL;
-			png_error error = mng_capture_frame(*m_mngfile, &pnginfo, m_snap_bitmap, machine().total_colors(), palette);
+			// write the next frame; RGB bitmaps don't need the palette
+			png_error error = mng_capture_frame(*m_mngfile, &pnginfo, frame.m_bitmap, 0, NULL);
 			png_free(&pnginfo);
 			if (error != PNGERR_NONE)
 			{
-				g_profiler.stop();
-				return end_recording();
+				m_movie_error = true;
+				return;
 			}
 		}
-
-		// advance time
-		m_movie_next_frame_time += m_movie_frame_period;
-		m_movie_frame++;
 	}
-	g_profiler.stop();
+}
+
+
+//-------------------------------------------------
+//  encode_sound_static - work item callback to
+//  write a block of movie sound
+//-------------------------------------------------
+
+void *video_manager::encode_sound_static(void *param, int threadid)
+{
+	movie_sound *sound = reinterpret_cast<movie_sound *>(param);
+	sound->m_manager->encode_sound(*sound);
+	global_free(sound->m_samples);
+	global_free(sound);
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  encode_sound - write a block of movie sound
+//  to the file; called on the encoding thread
+//-------------------------------------------------
+
+void video_manager::encode_sound(movie_sound &sound)
+{
+	// once there's an error, don't bother
+	if (m_movie_error || m_avifile == NULL)
+		return;
+
+	avi_error avierr = avi_append_sound_samples(m_avifile, 0, sound.m_samples + 0, sound.m_numsamples, 1);
+	if (avierr == AVIERR_NONE)
+		avierr = avi_append_sound_samples(m_avifile, 1, sound.m_samples + 1, sound.m_numsamples, 1);
+	if (avierr != AVIERR_NONE)
+		m_movie_error = true;
 }
 
 
@@ -64,6 +64,9 @@ public:
 	bool throttled() const { return m_throttle; }
 	bool fastforward() const { return m_fastforward; }
 	bool is_recording() const { return (m_mngfile != NULL || m_avifile != NULL); }
+	UINT32 movie_frames_dropped() const { return m_movie_dropped; }
+	UINT32 movie_frames_waited() const { return m_movie_waits; }
+	osd_ticks_t movie_wait_ticks() const { return m_movie_wait_ticks; }
 
 	// setters
 	void set_speed_factor(int speed) { m_speed = speed; }
@@ -113,6 +116,14 @@ private:
 	file_error open_next(emu_file &file, const char *extension);
 	void record_frame();
 
+	// background movie encoding helpers
+	class movie_frame;
+	class movie_sound;
+	static void *encode_frame_static(void *param, int threadid);
+	static void *encode_sound_static(void *param, int threadid);
+	void encode_frame(movie_frame &frame);
+	void encode_sound(movie_sound &sound);
+
 	// internal state
 	running_machine &   m_machine;                  // reference to our machine
 
@@ -166,6 +177,38 @@ private:
 	attotime            m_movie_next_frame_time;    // time of next frame
 	UINT32              m_movie_frame;              // current movie frame number
 
+	// a copy of a snapshot waiting to be encoded
+	class movie_frame
+	{
+	public:
+		video_manager *     m_manager;                  // pointer back to the manager
+		bitmap_rgb32        m_bitmap;                   // copy of the snapshot bitmap
+		UINT32              m_number;                   // movie frame number of the first copy
+		int                 m_repeat;                   // number of copies to write
+		osd_work_item *     m_item;                     // work item encoding this frame; NULL if free
+	};
+
+	// a block of sound samples waiting to be written
+	class movie_sound
+	{
+	public:
+		video_manager *     m_manager;                  // pointer back to the manager
+		INT16 *             m_samples;                  // interleaved stereo samples
+		int                 m_numsamples;               // number of samples per channel
+	};
+
+	// background movie encoding
+	static const int    MOVIE_QUEUE_DEPTH = 4;
+	osd_work_queue *    m_movie_queue;              // queue for encoding, processed in order
+	movie_frame         m_movie_frames[MOVIE_QUEUE_DEPTH]; // pool of frames, used round-robin
+	int                 m_movie_slot;               // next frame in the pool to fill
+	bool                m_movie_drop;               // repeat frames rather than wait for the encoder
+	volatile bool       m_movie_error;              // set by the encoder on failure
+	int                 m_movie_owed;               // copies of dropped frames to add to the next one
+	UINT32              m_movie_dropped;            // frames replaced by repeats because the encoder was busy
+	UINT32              m_movie_waits;              // frames that had to wait for the encoder
+	osd_ticks_t         m_movie_wait_ticks;         // total time spent waiting for the encoder
+
 	static const UINT8      s_skiptable[FRAMESKIP_LEVELS][FRAMESKIP_LEVELS];
 
 	static const attoseconds_t ATTOSECONDS_PER_SPEED_UPDATE = ATTOSECONDS_PER_SECOND / 4;
@@ -11,6 +11,7 @@
 #include <stdlib.h>
 
 #include "aviio.h"
+#include "pixrow.h"
 
 
 /***************************************************************************
@@ -2325,7 +2326,21 @@ static avi_error rgb32_compress_to_rgb(avi_stream *stream, const bitmap_rgb32 &b
 		const UINT32 *source = &bitmap.pix32(y);
 		UINT8 *dest = data + (stream->height - 1 - y) * stream->width * 3;
 
-		for (x = 0; x < width && dest < dataend; x++)
+		/* pack 4 pixels into 3 little-endian DWORDs of BGR triplets at a time */
+		for (x = 0; x + 4 <= width && dest + 12 <= dataend; x += 4)
+		{
+			UINT32 pix0 = source[0], pix1 = source[1], pix2 = source[2], pix3 = source[3];
+			UINT32 packed[3];
+			packed[0] = LITTLE_ENDIANIZE_INT32((pix0 & 0xffffff) | (pix1 << 24));
+			packed[1] = LITTLE_ENDIANIZE_INT32(((pix1 >> 8) & 0xffff) | (pix2 << 16));
+			packed[2] = LITTLE_ENDIANIZE_INT32(((pix2 >> 16) & 0xff) | (pix3 << 8));
+			memcpy(dest, packed, 12);
+			source += 4;
+			dest += 12;
+		}
+
+		/* then the leftovers */
+		for ( ; x < width && dest < dataend; x++)
 		{
 			UINT32 pix = *source++;
 			*dest++ = RGB_BLUE(pix);
@@ -2384,11 +2399,7 @@ static avi_error yuv_decompress_to_yuy16(avi_stream *stream, const UINT8 *data,
 
 			case FORMAT_VYUY:
 			case FORMAT_YUY2:
-				for (x = 0; x < stream->width && source < dataend; x++)
-				{
-					UINT16 pix = *source++;
-					*dest++ = (pix >> 8) | (pix << 8);
-				}
+				pixel_row<true>::swap_yuy16(dest, source, MIN(stream->width, dataend - source));
 				break;
 		}
 	}
@@ -2423,11 +2434,7 @@ static avi_error yuy16_compress_to_yuy(avi_stream *stream, const bitmap_yuy16 &b
 
 			case FORMAT_VYUY:
 			case FORMAT_YUY2:
-				for (x = 0; x < stream->width && dest < dataend; x++)
-				{
-					UINT16 pix = *source++;
-					*dest++ = (pix >> 8) | (pix << 8);
-				}
+				pixel_row<true>::swap_yuy16(dest, source, MIN(stream->width, dataend - dest));
 				break;
 		}
 	}
@@ -2714,14 +2721,7 @@ static avi_error huffyuv_decompress_to_yuy16(avi_stream *stream, const UINT8 *da
 
 			/* for gradient, we then add in the previous row */
 			if ((huffyuv->predictor & ~HUFFYUV_PREDICT_DECORR) == HUFFYUV_PREDICT_GRADIENT && y >= prevlines)
-				for (x = 0; x < stream->width; x++)
-				{
-					UINT16 curpix = dest[x];
-					UINT16 prevpix = prevrow[x];
-					UINT8 ysum = (curpix >> 8) + (prevpix >> 8);
-					UINT8 csum = curpix + prevpix;
-					dest[x] = (ysum << 8) | csum;
-				}
+				pixel_row<true>::add_yuy16(dest, prevrow, stream->width);
 		}
 
 		/* median predict on rows > 0 */
@@ -53,6 +53,9 @@ const int ECC_Q_OFFSET = ECC_P_OFFSET + 2 * ECC_P_NUM_BYTES;
 const int ECC_Q_NUM_BYTES = 52;     // 2 lots of 52
 const int ECC_Q_COMP = 43;          // 43 bytes each
 
+const UINT32 CACHE_BYTES = 512 * 1024;  // memory for decompressed hunks
+const UINT32 READAHEAD_HUNKS = 4;       // hunks to decode ahead of streaming reads
+
 
 
 /***************************************************************************
@@ -243,6 +246,9 @@ cdrom_file *cdrom_open(chd_file *chd)
 	/* fill in the data */
 	file->chd = chd;
 
+	/* keep a few hunks around, and decode ahead while streaming audio/video data */
+	chd->set_cache(CACHE_BYTES, READAHEAD_HUNKS);
+
 	/* read the CD-ROM metadata */
 	err = cdrom_parse_metadata(chd, &file->cdtoc);
 	if (err != CHDERR_NONE)
@@ -173,8 +173,10 @@ inline void chd_file::file_read(UINT64 offset, void *dest, UINT32 length)
 		throw CHDERR_NOT_OPEN;
 
 	// seek and read
+	osd_lock_acquire(m_lock);
 	core_fseek(m_file, offset, SEEK_SET);
 	UINT32 count = core_fread(m_file, dest, length);
+	osd_lock_release(m_lock);
 	if (count != length)
 		throw CHDERR_READ_ERROR;
 }
@@ -192,8 +194,10 @@ inline void chd_file::file_write(UINT64 offset, const void *source, UINT32 lengt
 		throw CHDERR_NOT_OPEN;
 
 	// seek and write
+	osd_lock_acquire(m_lock);
 	core_fseek(m_file, offset, SEEK_SET);
 	UINT32 count = core_fwrite(m_file, source, length);
+	osd_lock_release(m_lock);
 	if (count != length)
 		throw CHDERR_WRITE_ERROR;
 }
@@ -268,7 +272,11 @@ inline UINT8 chd_file::bits_for_value(UINT64 value)
 
 chd_file::chd_file()
 	: m_file(NULL),
-		m_owns_file(false)
+		m_owns_file(false),
+		m_cache_limit(0),
+		m_readahead(0),
+		m_readahead_queue(NULL),
+		m_lock(osd_lock_alloc())
 {
 	// reset state
 	memset(m_decompressor, 0, sizeof(m_decompressor));
@@ -284,6 +292,11 @@ chd_file::~chd_file()
 {
 	// close any open files
 	close();
+
+	// free the read-ahead queue and lock
+	if (m_readahead_queue != NULL)
+		osd_work_queue_free(m_readahead_queue);
+	osd_lock_free(m_lock);
 }
 
 
@@ -668,6 +681,9 @@ chd_error chd_file::open(core_file &file, bool writeable, chd_file *parent)
 
 void chd_file::close()
 {
+	// wait for any read-ahead in progress
+	cache_flush();
+
 	// reset file characteristics
 	if (m_owns_file && m_file != NULL)
 		core_fclose(m_file);
@@ -710,7 +726,9 @@ void chd_file::close()
 
 	// reset caching
 	m_cache.reset();
-	m_cachehunk = ~0;
+	m_cache_entry.reset();
+	m_cache_clock = 0;
+	m_cache_lasthunk = ~0;
 }
 
 
@@ -719,6 +737,15 @@ void chd_file::close()
 //-------------------------------------------------
 
 chd_error chd_file::read_hunk(UINT32 hunknum, void *buffer)
+{
+	// the file and codecs may be shared with a read-ahead thread
+	osd_lock_acquire(m_lock);
+	chd_error err = read_hunk_locked(hunknum, buffer);
+	osd_lock_release(m_lock);
+	return err;
+}
+
+chd_error chd_file::read_hunk_locked(UINT32 hunknum, void *buffer)
 {
 	// wrap this for clean reporting
 	try
@@ -898,14 +925,16 @@ chd_error chd_file::write_hunk(UINT32 hunknum, const void *buffer)
 			be_write(rawmap, rawentry, 4);
 			file_write(m_mapoffset + hunknum * 4, rawmap, 4);
 
-			// update the cached hunk if we just wrote it
-			if (hunknum == m_cachehunk && buffer != m_cache)
-				memcpy(m_cache, buffer, m_hunkbytes);
 		}
 
 		// otherwise, just overwrite
 		else
 			file_write(UINT64(rawentry) * UINT64(m_hunkbytes), buffer, m_hunkbytes);
+
+		// update the cached hunk if we just wrote it
+		cache_entry *entry = cache_find(hunknum);
+		if (entry != NULL && entry->m_data != buffer)
+			memcpy(entry->m_data, buffer, m_hunkbytes);
 		return CHDERR_NONE;
 	}
 
@@ -956,22 +985,19 @@ chd_error chd_file::read_bytes(UINT64 offset, void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just read directly from disk unless it's the cached hunk
+		// if it's a full block, just read directly from disk unless it's cached
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && cache_find(curhunk) == NULL)
 			err = read_hunk(curhunk, dest);
 
 		// otherwise, read from the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
-			{
-				err = read_hunk(curhunk, m_cache);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
-			}
-			memcpy(dest, &m_cache[startoffs], endoffs + 1 - startoffs);
+			cache_entry *entry = cache_load(curhunk, err);
+			if (entry == NULL)
+				return err;
+			memcpy(dest, &entry->m_data[startoffs], endoffs + 1 - startoffs);
+			cache_readahead(curhunk);
 		}
 
 		// handle errors and advance
@@ -1000,23 +1026,19 @@ chd_error chd_file::write_bytes(UINT64 offset, const void *buffer, UINT32 bytes)
 		UINT32 startoffs = (curhunk == first_hunk) ? (offset % m_hunkbytes) : 0;
 		UINT32 endoffs = (curhunk == last_hunk) ? ((offset + bytes - 1) % m_hunkbytes) : (m_hunkbytes - 1);
 
-		// if it's a full block, just write directly to disk unless it's the cached hunk
+		// if it's a full block, just write directly to disk; write_hunk keeps the cache current
 		chd_error err = CHDERR_NONE;
-		if (startoffs == 0 && endoffs == m_hunkbytes - 1 && curhunk != m_cachehunk)
+		if (startoffs == 0 && endoffs == m_hunkbytes - 1)
 			err = write_hunk(curhunk, source);
 
 		// otherwise, write from the cache
 		else
 		{
-			if (curhunk != m_cachehunk)
-			{
-				err = read_hunk(curhunk, m_cache);
-				if (err != CHDERR_NONE)
-					return err;
-				m_cachehunk = curhunk;
-			}
-			memcpy(&m_cache[startoffs], source, endoffs + 1 - startoffs);
-			err = write_hunk(curhunk, m_cache);
+			cache_entry *entry = cache_load(curhunk, err);
+			if (entry == NULL)
+				return err;
+			memcpy(&entry->m_data[startoffs], source, endoffs + 1 - startoffs);
+			err = write_hunk(curhunk, entry->m_data);
 		}
 
 		// handle errors and advance
@@ -1344,6 +1366,29 @@ chd_error chd_file::codec_configure(chd_codec_type codec, int param, void *confi
 }
 
 
+//-------------------------------------------------
+//  set_cache - configure how much memory to
+//  spend caching decompressed hunks, and how
+//  many hunks to decode ahead of sequential reads
+//-------------------------------------------------
+
+void chd_file::set_cache(UINT32 maxbytes, UINT32 readahead)
+{
+	// wait for anything in flight before changing things
+	cache_flush();
+	m_cache_limit = maxbytes;
+	m_readahead = readahead;
+
+	// read-ahead happens on a background I/O queue
+	if (m_readahead != 0 && m_readahead_queue == NULL)
+		m_readahead_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
+
+	// if we're already open, reallocate now
+	if (m_hunkbytes != 0)
+		cache_allocate();
+}
+
+
 //-------------------------------------------------
 //  error_string - return an error string for
 //  the given CHD error
@@ -2079,9 +2124,228 @@ void chd_file::create_open_common()
 	else
 		file_read(m_mapoffset, m_rawmap, m_rawmap.count());
 
-	// allocate the temporary compressed buffer and a buffer for caching
+	// allocate the temporary compressed buffer and the hunk cache
 	m_compressed.resize(m_hunkbytes);
-	m_cache.resize(m_hunkbytes);
+	cache_allocate();
+}
+
+
+//-------------------------------------------------
+//  cache_allocate - size the hunk cache from the
+//  configured limit; there is always room for at
+//  least one hunk plus any read-ahead
+//-------------------------------------------------
+
+void chd_file::cache_allocate()
+{
+	cache_flush();
+
+	// figure out how many hunks we can hold
+	UINT32 entries = (m_hunkbytes == 0) ? 0 : m_cache_limit / m_hunkbytes;
+	if (m_readahead_queue == NULL || m_readahead == 0)
+		entries = MAX(entries, 1);
+	else
+		entries = MAX(entries, m_readahead + 2);
+
+	// allocate and reset the entries
+	m_cache.resize(entries * m_hunkbytes);
+	m_cache_entry.resize(entries);
+	for (UINT32 entrynum = 0; entrynum < entries; entrynum++)
+	{
+		cache_entry &entry = m_cache_entry[entrynum];
+		entry.m_chd = this;
+		entry.m_hunknum = ~0;
+		entry.m_lastuse = 0;
+		entry.m_data = m_cache + entrynum * m_hunkbytes;
+		entry.m_osd = NULL;
+		entry.m_err = CHDERR_NONE;
+	}
+	m_cache_clock = 0;
+	m_cache_lasthunk = ~0;
+}
+
+
+//-------------------------------------------------
+//  cache_flush - wait for any read-ahead that is
+//  still in progress
+//-------------------------------------------------
+
+void chd_file::cache_flush()
+{
+	for (int entrynum = 0; entrynum < m_cache_entry.count(); entrynum++)
+		cache_complete(m_cache_entry[entrynum], 100 * osd_ticks_per_second());
+}
+
+
+//-------------------------------------------------
+//  cache_complete - retire the read-ahead of an
+//  entry if it finishes within the timeout;
+//  returns false if it is still pending
+//-------------------------------------------------
+
+bool chd_file::cache_complete(cache_entry &entry, osd_ticks_t timeout)
+{
+	if (entry.m_osd == NULL)
+		return true;
+	if (!osd_work_item_wait(entry.m_osd, timeout))
+		return false;
+	osd_work_item_release(entry.m_osd);
+	entry.m_osd = NULL;
+
+	// a failed read-ahead leaves nothing worth keeping
+	if (entry.m_err != CHDERR_NONE)
+		entry.m_hunknum = ~0;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  cache_reap - retire all read-aheads that have
+//  already finished, returning how many are
+//  still pending
+//-------------------------------------------------
+
+UINT32 chd_file::cache_reap()
+{
+	UINT32 pending = 0;
+	for (int entrynum = 0; entrynum < m_cache_entry.count(); entrynum++)
+		if (!cache_complete(m_cache_entry[entrynum], 0))
+			pending++;
+	return pending;
+}
+
+
+//-------------------------------------------------
+//  cache_find - return the cache entry holding
+//  the given hunk, or NULL if it isn't cached
+//-------------------------------------------------
+
+chd_file::cache_entry *chd_file::cache_find(UINT32 hunknum)
+{
+	for (int entrynum = 0; entrynum < m_cache_entry.count(); entrynum++)
+		if (m_cache_entry[entrynum].m_hunknum == hunknum)
+			return &m_cache_entry[entrynum];
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  cache_load - return the cache entry for the
+//  given hunk, reading it if necessary or
+//  waiting for read-ahead to finish with it
+//-------------------------------------------------
+
+chd_file::cache_entry *chd_file::cache_load(UINT32 hunknum, chd_error &err)
+{
+	err = CHDERR_NONE;
+	cache_entry *entry = cache_find(hunknum);
+
+	// if we have it, make sure any read-ahead is finished
+	if (entry != NULL)
+	{
+		if (entry->m_osd != NULL)
+		{
+			cache_complete(*entry, 100 * osd_ticks_per_second());
+			if (entry->m_err != CHDERR_NONE)
+			{
+				err = entry->m_err;
+				return NULL;
+			}
+		}
+	}
+
+	// otherwise, evict the oldest entry and read into it
+	else
+	{
+		entry = &cache_victim();
+		entry->m_hunknum = ~0;
+		err = read_hunk(hunknum, entry->m_data);
+		if (err != CHDERR_NONE)
+			return NULL;
+		entry->m_hunknum = hunknum;
+	}
+
+	entry->m_lastuse = ++m_cache_clock;
+	return entry;
+}
+
+
+//-------------------------------------------------
+//  cache_victim - return the least recently used
+//  cache entry that isn't being read ahead; if
+//  every entry is, wait for the oldest
+//-------------------------------------------------
+
+chd_file::cache_entry &chd_file::cache_victim()
+{
+	cache_reap();
+
+	cache_entry *best = NULL;
+	cache_entry *oldest = NULL;
+	for (int entrynum = 0; entrynum < m_cache_entry.count(); entrynum++)
+	{
+		cache_entry &entry = m_cache_entry[entrynum];
+		if (oldest == NULL || UINT32(m_cache_clock - entry.m_lastuse) > UINT32(m_cache_clock - oldest->m_lastuse))
+			oldest = &entry;
+		if (entry.m_osd != NULL)
+			continue;
+		if (entry.m_hunknum == ~0)
+			return entry;
+		if (best == NULL || UINT32(m_cache_clock - entry.m_lastuse) > UINT32(m_cache_clock - best->m_lastuse))
+			best = &entry;
+	}
+	if (best != NULL)
+		return *best;
+
+	// everything is in flight; the oldest read-ahead is the least useful
+	cache_complete(*oldest, 100 * osd_ticks_per_second());
+	return *oldest;
+}
+
+
+//-------------------------------------------------
+//  cache_readahead - note a read of the given
+//  hunk, and if reads are sequential start
+//  decoding the next few hunks in the background
+//-------------------------------------------------
+
+void chd_file::cache_readahead(UINT32 hunknum)
+{
+	// only for read-only files, and only when reading sequentially
+	if (m_readahead != 0 && m_readahead_queue != NULL && !m_allow_writes && hunknum == m_cache_lasthunk + 1)
+	{
+		// never let read-ahead claim more than all but two entries, so the
+		// hunk just read and one other always stay available
+		UINT32 pending = cache_reap();
+		UINT32 maxpending = MIN(m_readahead, m_cache_entry.count() - 2);
+		for (UINT32 ahead = hunknum + 1; ahead <= hunknum + m_readahead && ahead < m_hunkcount && pending < maxpending; ahead++)
+			if (cache_find(ahead) == NULL)
+			{
+				cache_entry &entry = cache_victim();
+				entry.m_hunknum = ahead;
+				entry.m_lastuse = ++m_cache_clock;
+				entry.m_err = CHDERR_NONE;
+				entry.m_osd = osd_work_item_queue(m_readahead_queue, async_readahead_static, &entry, 0);
+				if (entry.m_osd == NULL)
+					entry.m_hunknum = ~0;
+				else
+					pending++;
+			}
+	}
+	m_cache_lasthunk = hunknum;
+}
+
+
+//-------------------------------------------------
+//  async_readahead_static - decode a hunk on the
+//  read-ahead thread
+//-------------------------------------------------
+
+void *chd_file::async_readahead_static(void *param, int threadid)
+{
+	cache_entry *entry = reinterpret_cast<cache_entry *>(param);
+	entry->m_err = entry->m_chd->read_hunk(entry->m_hunknum, entry->m_data);
+	return NULL;
 }
 
 
@@ -2313,11 +2577,15 @@ chd_file_compressor::chd_file_compressor()
 		m_read_done_offset(0),
 		m_read_error(false),
 		m_work_queue(NULL),
-		m_write_hunk(0)
+		m_write_hunk(0),
+		m_read_ticks(0),
+		m_hash_ticks(0),
+		m_write_ticks(0)
 {
 	// zap arrays
 	memset(m_work_item, 0, sizeof(m_work_item));
 	memset(m_codecs, 0, sizeof(m_codecs));
+	memset(m_codec_ticks, 0, sizeof(m_codec_ticks));
 
 	// allocate work queues
 	m_read_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_IO);
@@ -2384,6 +2652,24 @@ void chd_file_compressor::compress_begin()
 
 	// reset write state
 	m_write_hunk = 0;
+
+	// reset statistics
+	m_read_ticks = m_hash_ticks = m_write_ticks = 0;
+	memset(m_codec_ticks, 0, sizeof(m_codec_ticks));
+}
+
+
+//-------------------------------------------------
+//  codec_ticks - return the total time spent
+//  compressing across all threads
+//-------------------------------------------------
+
+osd_ticks_t chd_file_compressor::codec_ticks() const
+{
+	osd_ticks_t total = 0;
+	for (int threadid = 0; threadid < ARRAY_LENGTH(m_codec_ticks); threadid++)
+		total += m_codec_ticks[threadid];
+	return total;
 }
 
 
@@ -2425,6 +2711,7 @@ chd_error chd_file_compressor::compress_continue(double &progress, double &ratio
 	}
 
 	// flush out any finished items
+	osd_ticks_t write_start = osd_ticks();
 	while (m_work_item[m_write_hunk % WORK_BUFFER_HUNKS].m_status == WS_COMPLETE)
 	{
 		work_item &item = m_work_item[m_write_hunk % WORK_BUFFER_HUNKS];
@@ -2511,13 +2798,21 @@ chd_error chd_file_compressor::compress_continue(double &progress, double &ratio
 			{
 				osd_work_queue_wait(m_read_queue, 30 * osd_ticks_per_second());
 				if (!compressed())
+				{
+					m_write_ticks += osd_ticks() - write_start;
 					return CHDERR_NONE;
+				}
 				set_raw_sha1(m_compsha1.finish());
-				return compress_v5_map();
+				chd_error err = compress_v5_map();
+				m_write_ticks += osd_ticks() - write_start;
+				return err;
 			}
 		}
 	}
 
+	if (!m_walking_parent)
+		m_write_ticks += osd_ticks() - write_start;
+
 	// update progress and ratio
 	if (m_walking_parent)
 		progress = double(m_read_done_offset) / double(logical_bytes());
@@ -2577,6 +2872,7 @@ void chd_file_compressor::async_compress_hunk(work_item &item, int threadid)
 	// use our thread's codec
 	assert(threadid < ARRAY_LENGTH(m_codecs));
 	item.m_codecs = m_codecs[threadid];
+	osd_ticks_t start = osd_ticks();
 
 	// compute CRC-16 and SHA-1 hashes
 	item.m_hash[0].m_crc16 = crc16_creator::simple(item.m_data, hunk_bytes());
@@ -2587,6 +2883,7 @@ void chd_file_compressor::async_compress_hunk(work_item &item, int threadid)
 	if (m_current_map.find(item.m_hash[0].m_crc16, item.m_hash[0].m_sha1) == hashmap::NOT_FOUND &&
 		m_parent_map.find(item.m_hash[0].m_crc16, item.m_hash[0].m_sha1) == hashmap::NOT_FOUND)
 		item.m_compression = item.m_codecs->find_best_compressor(item.m_data, item.m_compressed, item.m_complen);
+	m_codec_ticks[threadid] += osd_ticks() - start;
 
 	// mark us complete
 	item.m_status = WS_COMPLETE;
@@ -2637,7 +2934,11 @@ void chd_file_compressor::async_read()
 
 		// otherwise, call the virtual function
 		else
+		{
+			osd_ticks_t start = osd_ticks();
 			read_data(dest, m_read_done_offset, numbytes);
+			m_read_ticks += osd_ticks() - start;
+		}
 
 		// spawn off work for each hunk
 		for (UINT64 curoffs = m_read_done_offset; curoffs < end_offset; curoffs += hunk_bytes())
@@ -2653,8 +2954,10 @@ void chd_file_compressor::async_read()
 		// continue the running SHA-1
 		if (!m_walking_parent)
 		{
+			osd_ticks_t start = osd_ticks();
 			if (compressed())
 				m_compsha1.append(dest, numbytes);
+			m_hash_ticks += osd_ticks() - start;
 			m_total_in += numbytes;
 		}
 
@@ -362,6 +362,9 @@ public:
 	// codec interfaces
 	chd_error codec_configure(chd_codec_type codec, int param, void *config);
 
+	// cache configuration
+	void set_cache(UINT32 maxbytes, UINT32 readahead = 0);
+
 	// static helpers
 	static const char *error_string(chd_error err);
 
@@ -369,6 +372,17 @@ private:
 	struct metadata_entry;
 	struct metadata_hash;
 
+	// an entry in the hunk cache
+	struct cache_entry
+	{
+		chd_file *          m_chd;              // pointer back to the owning file
+		UINT32              m_hunknum;          // hunk held here, or ~0 if none
+		UINT32              m_lastuse;          // LRU stamp
+		UINT8 *             m_data;             // the decompressed hunk
+		osd_work_item *     m_osd;              // pending read-ahead, if any
+		chd_error           m_err;              // result of the read-ahead
+	};
+
 	// inline helpers
 	UINT64 be_read(const UINT8 *base, int numbytes);
 	void be_write(UINT8 *base, UINT64 value, int numbytes);
@@ -397,6 +411,16 @@ private:
 	void metadata_set_previous_next(UINT64 prevoffset, UINT64 nextoffset);
 	void metadata_update_hash();
 	static int CLIB_DECL metadata_hash_compare(const void *elem1, const void *elem2);
+	chd_error read_hunk_locked(UINT32 hunknum, void *buffer);
+	void cache_allocate();
+	void cache_flush();
+	bool cache_complete(cache_entry &entry, osd_ticks_t timeout);
+	UINT32 cache_reap();
+	cache_entry *cache_find(UINT32 hunknum);
+	cache_entry *cache_load(UINT32 hunknum, chd_error &err);
+	cache_entry &cache_victim();
+	void cache_readahead(UINT32 hunknum);
+	static void *async_readahead_static(void *param, int threadid);
 
 	// file characteristics
 	core_file *             m_file;             // handle to the open core file
@@ -433,8 +457,14 @@ private:
 	dynamic_buffer          m_compressed;       // temporary buffer for compressed data
 
 	// caching
-	dynamic_buffer          m_cache;            // single-hunk cache for partial reads/writes
-	UINT32                  m_cachehunk;        // which hunk is in the cache?
+	UINT32                  m_cache_limit;      // maximum bytes to spend on cached hunks
+	UINT32                  m_readahead;        // hunks to decode ahead of sequential reads
+	dynamic_buffer          m_cache;            // hunk cache for partial reads/writes
+	dynamic_array<cache_entry> m_cache_entry;   // state of each cached hunk
+	UINT32                  m_cache_clock;      // LRU clock
+	UINT32                  m_cache_lasthunk;   // last hunk read through the cache
+	osd_work_queue *        m_readahead_queue;  // queue for decoding ahead
+	osd_lock *              m_lock;             // serializes file and codec access
 };
 
 
@@ -452,6 +482,14 @@ public:
 	void compress_begin();
 	chd_error compress_continue(double &progress, double &ratio);
 
+	// pipeline statistics; codec time is summed over all worker threads
+	UINT64 total_in() const { return m_total_in; }
+	UINT64 total_out() const { return m_total_out; }
+	osd_ticks_t read_ticks() const { return m_read_ticks; }
+	osd_ticks_t hash_ticks() const { return m_hash_ticks; }
+	osd_ticks_t codec_ticks() const;
+	osd_ticks_t write_ticks() const { return m_write_ticks; }
+
 protected:
 	// required override: read more data
 	virtual UINT32 read_data(void *dest, UINT64 offset, UINT32 length) = 0;
@@ -562,6 +600,12 @@ private:
 
 	// output state
 	UINT32                  m_write_hunk;       // next hunk to write
+
+	// statistics
+	osd_ticks_t             m_read_ticks;       // time spent reading source data
+	osd_ticks_t             m_hash_ticks;       // time spent on the running SHA-1
+	osd_ticks_t             m_codec_ticks[WORK_MAX_THREADS]; // time spent compressing, per thread
+	osd_ticks_t             m_write_ticks;      // time spent writing output
 };
 
 
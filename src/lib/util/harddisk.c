@@ -65,6 +65,9 @@ hard_disk_file *hard_disk_open(chd_file *chd)
 	file->info.heads = heads;
 	file->info.sectors = sectors;
 	file->info.sectorbytes = sectorbytes;
+
+	/* cache enough hunks that FAT and directory reads don't keep evicting each other */
+	chd->set_cache(256 * 1024);
 	return file;
 }
 
@@ -0,0 +1,253 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    pixrow.h
+
+    Row kernels shared by the PNG and AVI code. Each comes in an SSE2
+    form and a plain form, selected by the template parameter, so that
+    the two can be compared and timed against each other.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __PIXROW_H__
+#define __PIXROW_H__
+
+#include "osdcore.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+/***************************************************************************
+    TYPE DEFINITIONS
+***************************************************************************/
+
+/* row kernels; _UseSSE2 has no effect in builds without SSE2 */
+template<bool _UseSSE2>
+class pixel_row
+{
+public:
+	/* PNG unfilters */
+	static void unfilter_up(const UINT8 *src, UINT8 *dst, const UINT8 *dstprev, int rowbytes);
+	static void unfilter_paeth(const UINT8 *src, UINT8 *dst, const UINT8 *dstprev, int bpp, int rowbytes);
+
+	/* YUY16 rows */
+	static void swap_yuy16(UINT16 *dest, const UINT16 *source, int count);
+	static void add_yuy16(UINT16 *dest, const UINT16 *source, int count);
+
+private:
+#ifdef __SSE2__
+	template<int _Bpp> static void unfilter_paeth_sse2(const UINT8 *src, UINT8 *dst, const UINT8 *dstprev, int rowbytes);
+#endif
+};
+
+
+
+/***************************************************************************
+    INLINE FUNCTIONS
+***************************************************************************/
+
+/*-------------------------------------------------
+    add_bytes_4 - add 4 pairs of bytes at once,
+    without carries between them
+-------------------------------------------------*/
+
+inline UINT32 add_bytes_4(UINT32 a, UINT32 b)
+{
+	return ((a & 0x7f7f7f7f) + (b & 0x7f7f7f7f)) ^ ((a ^ b) & 0x80808080);
+}
+
+
+/*-------------------------------------------------
+    unfilter_up - unfilter a row with the pixel
+    above; dstprev must not be NULL
+-------------------------------------------------*/
+
+template<bool _UseSSE2>
+inline void pixel_row<_UseSSE2>::unfilter_up(const UINT8 *src, UINT8 *dst, const UINT8 *dstprev, int rowbytes)
+{
+	int x = 0;
+
+#ifdef __SSE2__
+	/* 16 bytes at a time */
+	if (_UseSSE2)
+		for ( ; x + 16 <= rowbytes; x += 16)
+			_mm_storeu_si128((__m128i *)&dst[x], _mm_add_epi8(_mm_loadu_si128((const __m128i *)&src[x]), _mm_loadu_si128((const __m128i *)&dstprev[x])));
+#endif
+
+	/* otherwise 4 bytes at a time in a register */
+	for ( ; x + 4 <= rowbytes; x += 4)
+	{
+		UINT32 cur, above;
+		memcpy(&cur, &src[x], 4);
+		memcpy(&above, &dstprev[x], 4);
+		cur = add_bytes_4(cur, above);
+		memcpy(&dst[x], &cur, 4);
+	}
+	for ( ; x < rowbytes; x++)
+		dst[x] = src[x] + dstprev[x];
+}
+
+
+#ifdef __SSE2__
+/*-------------------------------------------------
+    unfilter_paeth_sse2 - unfilter a row of 3 or
+    4 byte pixels with the Paeth predictor, one
+    pixel at a time in 16-bit lanes
+-------------------------------------------------*/
+
+template<bool _UseSSE2> template<int _Bpp>
+inline void pixel_row<_UseSSE2>::unfilter_paeth_sse2(const UINT8 *src, UINT8 *dst, const UINT8 *dstprev, int rowbytes)
+{
+	__m128i zero = _mm_setzero_si128();
+	__m128i a = zero, c = zero;
+
+	for (int x = 0; x < rowbytes; x += _Bpp)
+	{
+		/* fetch the pixel above and the filtered value; 3 byte pixels are
+		   assembled in a register, since a partial copy would stall the load */
+		UINT32 above, filtered;
+		if (_Bpp == 4)
+		{
+			memcpy(&above, &dstprev[x], 4);
+			memcpy(&filtered, &src[x], 4);
+		}
+		else
+		{
+			above = dstprev[x] | (dstprev[x + 1] << 8) | (dstprev[x + 2] << 16);
+			filtered = src[x] | (src[x + 1] << 8) | (src[x + 2] << 16);
+		}
+		__m128i b = _mm_unpacklo_epi8(_mm_cvtsi32_si128(above), zero);
+		__m128i delta = _mm_cvtsi32_si128(filtered);
+
+		/* pa = |b - c|, pb = |a - c|, pc = |a + b - 2c| */
+		__m128i pa = _mm_sub_epi16(b, c);
+		__m128i pb = _mm_sub_epi16(a, c);
+		__m128i pc = _mm_add_epi16(pa, pb);
+		pa = _mm_max_epi16(pa, _mm_sub_epi16(zero, pa));
+		pb = _mm_max_epi16(pb, _mm_sub_epi16(zero, pb));
+		pc = _mm_max_epi16(pc, _mm_sub_epi16(zero, pc));
+
+		/* pick a if pa is smallest, else b if pb <= pc, else c */
+		__m128i pickc = _mm_cmplt_epi16(pc, _mm_min_epi16(pa, pb));
+		__m128i bc = _mm_or_si128(_mm_and_si128(pickc, c), _mm_andnot_si128(pickc, b));
+		__m128i picka = _mm_and_si128(_mm_cmpgt_epi16(pb, _mm_sub_epi16(pa, _mm_set1_epi16(1))), _mm_cmpgt_epi16(pc, _mm_sub_epi16(pa, _mm_set1_epi16(1))));
+		__m128i pred = _mm_or_si128(_mm_and_si128(picka, a), _mm_andnot_si128(picka, bc));
+
+		/* add in the delta and store */
+		__m128i result = _mm_add_epi8(_mm_packus_epi16(pred, pred), delta);
+		UINT32 temp = _mm_cvtsi128_si32(result);
+		memcpy(&dst[x], &temp, _Bpp);
+
+		/* this pixel is the next one's left, the one above is the next above-left */
+		a = _mm_unpacklo_epi8(result, zero);
+		c = b;
+	}
+}
+#endif
+
+
+/*-------------------------------------------------
+    unfilter_paeth - unfilter a row with the Paeth
+    predictor; dstprev may be NULL for the first
+    row
+-------------------------------------------------*/
+
+template<bool _UseSSE2>
+inline void pixel_row<_UseSSE2>::unfilter_paeth(const UINT8 *src, UINT8 *dst, const UINT8 *dstprev, int bpp, int rowbytes)
+{
+#ifdef __SSE2__
+	/* 3 and 4 byte pixels have vector forms, with the pixel size fixed */
+	if (_UseSSE2 && dstprev != NULL && bpp == 3)
+		return unfilter_paeth_sse2<3>(src, dst, dstprev, rowbytes);
+	if (_UseSSE2 && dstprev != NULL && bpp == 4)
+		return unfilter_paeth_sse2<4>(src, dst, dstprev, rowbytes);
+#endif
+
+	for (int x = 0; x < rowbytes; x++)
+	{
+		INT32 pa = (x < bpp) ? 0 : dst[x - bpp];
+		INT32 pc = (x < bpp || dstprev == NULL) ? 0 : dstprev[x - bpp];
+		INT32 pb = (dstprev == NULL) ? 0 : dstprev[x];
+		INT32 prediction = pa + pb - pc;
+		INT32 da = abs(prediction - pa);
+		INT32 db = abs(prediction - pb);
+		INT32 dc = abs(prediction - pc);
+		if (da <= db && da <= dc)
+			dst[x] = src[x] + pa;
+		else if (db <= dc)
+			dst[x] = src[x] + pb;
+		else
+			dst[x] = src[x] + pc;
+	}
+}
+
+
+/*-------------------------------------------------
+    swap_yuy16 - swap the bytes of each 16-bit
+    YUY pixel in a row
+-------------------------------------------------*/
+
+template<bool _UseSSE2>
+inline void pixel_row<_UseSSE2>::swap_yuy16(UINT16 *dest, const UINT16 *source, int count)
+{
+	int x = 0;
+
+#ifdef __SSE2__
+	/* 8 pixels at a time */
+	if (_UseSSE2)
+		for ( ; x + 8 <= count; x += 8)
+		{
+			__m128i pix = _mm_loadu_si128((const __m128i *)&source[x]);
+			_mm_storeu_si128((__m128i *)&dest[x], _mm_or_si128(_mm_srli_epi16(pix, 8), _mm_slli_epi16(pix, 8)));
+		}
+#endif
+
+	for ( ; x < count; x++)
+	{
+		UINT16 pix = source[x];
+		dest[x] = (pix >> 8) | (pix << 8);
+	}
+}
+
+
+/*-------------------------------------------------
+    add_yuy16 - add the Y and Cb/Cr bytes of one
+    row of 16-bit YUY pixels to another,
+    independently and modulo 256
+-------------------------------------------------*/
+
+template<bool _UseSSE2>
+inline void pixel_row<_UseSSE2>::add_yuy16(UINT16 *dest, const UINT16 *source, int count)
+{
+	int x = 0;
+
+#ifdef __SSE2__
+	/* 8 pixels at a time */
+	if (_UseSSE2)
+		for ( ; x + 8 <= count; x += 8)
+		{
+			__m128i cur = _mm_loadu_si128((const __m128i *)&dest[x]);
+			__m128i prev = _mm_loadu_si128((const __m128i *)&source[x]);
+			_mm_storeu_si128((__m128i *)&dest[x], _mm_add_epi8(cur, prev));
+		}
+#endif
+
+	for ( ; x < count; x++)
+	{
+		UINT16 curpix = dest[x];
+		UINT16 prevpix = source[x];
+		UINT8 ysum = (curpix >> 8) + (prevpix >> 8);
+		UINT8 csum = curpix + prevpix;
+		dest[x] = (ysum << 8) | csum;
+	}
+}
+
+
+#endif  /* __PIXROW_H__ */
@@ -13,6 +13,7 @@
 
 #include <zlib.h>
 #include "png.h"
+#include "pixrow.h"
 
 #include <new>
 
@@ -352,7 +353,21 @@ static png_error unfilter_row(int type, UINT8 *src, UINT8 *dst, UINT8 *dstprev,
 		case PNG_PF_Sub:
 			for (x = 0; x < bpp; x++)
 				*dst++ = *src++;
-			for (x = bpp; x < rowbytes; x++, dst++)
+			x = bpp;
+
+			/* 4-byte pixels can be done a whole pixel at a time */
+			if (bpp == 4)
+			{
+				UINT32 prev, cur;
+				memcpy(&prev, &dst[-4], 4);
+				for ( ; x + 4 <= rowbytes; x += 4, src += 4, dst += 4)
+				{
+					memcpy(&cur, src, 4);
+					prev = add_bytes_4(cur, prev);
+					memcpy(dst, &prev, 4);
+				}
+			}
+			for ( ; x < rowbytes; x++, dst++)
 				*dst = *src++ + dst[-bpp];
 			break;
 
@@ -360,8 +375,7 @@ static png_error unfilter_row(int type, UINT8 *src, UINT8 *dst, UINT8 *dstprev,
 		case PNG_PF_Up:
 			if (dstprev == NULL)
 				return unfilter_row(PNG_PF_None, src, dst, dstprev, bpp, rowbytes);
-			for (x = 0; x < rowbytes; x++, dst++)
-				*dst = *src++ + *dstprev++;
+			pixel_row<true>::unfilter_up(src, dst, dstprev, rowbytes);
 			break;
 
 		/* AVERAGE = average of pixel above and previous pixel */
@@ -384,22 +398,7 @@ static png_error unfilter_row(int type, UINT8 *src, UINT8 *dst, UINT8 *dstprev,
 
 		/* PAETH = special filter */
 		case PNG_PF_Paeth:
-			for (x = 0; x < rowbytes; x++)
-			{
-				INT32 pa = (x < bpp) ? 0 : dst[-bpp];
-				INT32 pc = (x < bpp || dstprev == NULL) ? 0 : dstprev[-bpp];
-				INT32 pb = (dstprev == NULL) ? 0 : *dstprev++;
-				INT32 prediction = pa + pb - pc;
-				INT32 da = abs(prediction - pa);
-				INT32 db = abs(prediction - pb);
-				INT32 dc = abs(prediction - pc);
-				if (da <= db && da <= dc)
-					*dst++ = *src++ + pa;
-				else if (db <= dc)
-					*dst++ = *src++ + pb;
-				else
-					*dst++ = *src++ + pc;
-			}
+			pixel_row<true>::unfilter_paeth(src, dst, dstprev, bpp, rowbytes);
 			break;
 
 		/* unknown filter type */
@@ -968,7 +967,22 @@ static png_error convert_bitmap_to_image_rgb(png_info *pnginfo, const bitmap_t &
 		else if (bitmap.format() == BITMAP_FORMAT_RGB32)
 		{
 			UINT32 *src32 = reinterpret_cast<UINT32 *>(bitmap.raw_pixptr(y));
-			for (x = 0; x < pnginfo->width; x++)
+
+			/* pack 4 pixels into 3 big-endian DWORDs of RGB triplets at a time */
+			for (x = 0; x + 4 <= pnginfo->width; x += 4)
+			{
+				UINT32 pix0 = src32[0], pix1 = src32[1], pix2 = src32[2], pix3 = src32[3];
+				UINT32 packed[3];
+				packed[0] = BIG_ENDIANIZE_INT32((pix0 << 8) | ((pix1 >> 16) & 0xff));
+				packed[1] = BIG_ENDIANIZE_INT32((pix1 << 16) | ((pix2 >> 8) & 0xffff));
+				packed[2] = BIG_ENDIANIZE_INT32((pix2 << 24) | (pix3 & 0xffffff));
+				memcpy(dst, packed, 12);
+				src32 += 4;
+				dst += 12;
+			}
+
+			/* then the leftovers */
+			for ( ; x < pnginfo->width; x++)
 			{
 				UINT32 raw = *src32++;
 				*dst++ = RGB_RED(raw);
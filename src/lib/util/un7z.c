@@ -168,6 +168,10 @@ void FileOutStream_CreateVTable(CFileOutStream *p)
 
 static _7z_file *_7z_cache[_7Z_CACHE_SIZE];
 
+/* protects the cache while it is shared between threads (e.g. when auditing) */
+static osd_lock *_7z_cache_lock;
+static int _7z_cache_lock_users;
+
 /***************************************************************************
     FUNCTION PROTOTYPES
 ***************************************************************************/
@@ -291,6 +295,7 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 	*_7z = NULL;
 
 	/* see if we are in the cache, and reopen if so */
+	if (_7z_cache_lock != NULL) osd_lock_acquire(_7z_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 	{
 		_7z_file *cached = _7z_cache[cachenum];
@@ -300,9 +305,11 @@ _7z_error _7z_file_open(const char *filename, _7z_file **_7z)
 		{
 			*_7z = cached;
 			_7z_cache[cachenum] = NULL;
+			if (_7z_cache_lock != NULL) osd_lock_release(_7z_cache_lock);
 			return _7ZERR_NONE;
 		}
 	}
+	if (_7z_cache_lock != NULL) osd_lock_release(_7z_cache_lock);
 
 	/* allocate memory for the _7z_file structure */
 	new_7z = (_7z_file *)malloc(sizeof(*new_7z));
@@ -386,6 +393,7 @@ void _7z_file_close(_7z_file *_7z)
 	_7z->archiveStream.file._7z_osdfile = NULL;
 
 	/* find the first NULL entry in the cache */
+	if (_7z_cache_lock != NULL) osd_lock_acquire(_7z_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 		if (_7z_cache[cachenum] == NULL)
 			break;
@@ -398,6 +406,35 @@ void _7z_file_close(_7z_file *_7z)
 	if (cachenum != 0)
 		memmove(&_7z_cache[1], &_7z_cache[0], cachenum * sizeof(_7z_cache[0]));
 	_7z_cache[0] = _7z;
+	if (_7z_cache_lock != NULL) osd_lock_release(_7z_cache_lock);
+}
+
+
+/*-------------------------------------------------
+    _7z_file_cache_share - allocate the lock
+    that allows several threads to use the _7Z
+    file cache at once
+-------------------------------------------------*/
+
+void _7z_file_cache_share(void)
+{
+	if (_7z_cache_lock_users++ == 0)
+		_7z_cache_lock = osd_lock_alloc();
+}
+
+
+/*-------------------------------------------------
+    _7z_file_cache_unshare - free the lock once
+    the last user of a shared cache is done
+-------------------------------------------------*/
+
+void _7z_file_cache_unshare(void)
+{
+	if (--_7z_cache_lock_users == 0)
+	{
+		osd_lock_free(_7z_cache_lock);
+		_7z_cache_lock = NULL;
+	}
 }
 
 
@@ -411,12 +448,14 @@ void _7z_file_cache_clear(void)
 	int cachenum;
 
 	/* clear call cache entries */
+	if (_7z_cache_lock != NULL) osd_lock_acquire(_7z_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(_7z_cache); cachenum++)
 		if (_7z_cache[cachenum] != NULL)
 		{
 			free__7z_file(_7z_cache[cachenum]);
 			_7z_cache[cachenum] = NULL;
 		}
+	if (_7z_cache_lock != NULL) osd_lock_release(_7z_cache_lock);
 }
 
 
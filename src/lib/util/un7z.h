@@ -130,6 +130,10 @@ void _7z_file_close(_7z_file *_7z);
 /* clear out all open _7Z files from the cache */
 void _7z_file_cache_clear(void);
 
+/* allow several threads to use the cache at once; calls must be paired and made from a single thread */
+void _7z_file_cache_share(void);
+void _7z_file_cache_unshare(void);
+
 
 /* ----- contained file access ----- */
 
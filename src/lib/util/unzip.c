@@ -95,6 +95,10 @@ INLINE UINT32 read_dword(UINT8 *buf)
 
 static zip_file *zip_cache[ZIP_CACHE_SIZE];
 
+/* protects the cache while it is shared between threads (e.g. when auditing) */
+static osd_lock *zip_cache_lock;
+static int zip_cache_lock_users;
+
 
 
 /***************************************************************************
@@ -135,6 +139,7 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 	*zip = NULL;
 
 	/* see if we are in the cache, and reopen if so */
+	if (zip_cache_lock != NULL) osd_lock_acquire(zip_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 	{
 		zip_file *cached = zip_cache[cachenum];
@@ -144,9 +149,11 @@ zip_error zip_file_open(const char *filename, zip_file **zip)
 		{
 			*zip = cached;
 			zip_cache[cachenum] = NULL;
+			if (zip_cache_lock != NULL) osd_lock_release(zip_cache_lock);
 			return ZIPERR_NONE;
 		}
 	}
+	if (zip_cache_lock != NULL) osd_lock_release(zip_cache_lock);
 
 	/* allocate memory for the zip_file structure */
 	newzip = (zip_file *)malloc(sizeof(*newzip));
@@ -223,6 +230,7 @@ void zip_file_close(zip_file *zip)
 	zip->file = NULL;
 
 	/* find the first NULL entry in the cache */
+	if (zip_cache_lock != NULL) osd_lock_acquire(zip_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 		if (zip_cache[cachenum] == NULL)
 			break;
@@ -235,6 +243,35 @@ void zip_file_close(zip_file *zip)
 	if (cachenum != 0)
 		memmove(&zip_cache[1], &zip_cache[0], cachenum * sizeof(zip_cache[0]));
 	zip_cache[0] = zip;
+	if (zip_cache_lock != NULL) osd_lock_release(zip_cache_lock);
+}
+
+
+/*-------------------------------------------------
+    zip_file_cache_share - allocate the lock
+    that allows several threads to use the ZIP
+    file cache at once
+-------------------------------------------------*/
+
+void zip_file_cache_share(void)
+{
+	if (zip_cache_lock_users++ == 0)
+		zip_cache_lock = osd_lock_alloc();
+}
+
+
+/*-------------------------------------------------
+    zip_file_cache_unshare - free the lock once
+    the last user of a shared cache is done
+-------------------------------------------------*/
+
+void zip_file_cache_unshare(void)
+{
+	if (--zip_cache_lock_users == 0)
+	{
+		osd_lock_free(zip_cache_lock);
+		zip_cache_lock = NULL;
+	}
 }
 
 
@@ -248,12 +285,14 @@ void zip_file_cache_clear(void)
 	int cachenum;
 
 	/* clear call cache entries */
+	if (zip_cache_lock != NULL) osd_lock_acquire(zip_cache_lock);
 	for (cachenum = 0; cachenum < ARRAY_LENGTH(zip_cache); cachenum++)
 		if (zip_cache[cachenum] != NULL)
 		{
 			free_zip_file(zip_cache[cachenum]);
 			zip_cache[cachenum] = NULL;
 		}
+	if (zip_cache_lock != NULL) osd_lock_release(zip_cache_lock);
 }
 
 
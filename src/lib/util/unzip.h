@@ -122,6 +122,10 @@ void zip_file_close(zip_file *zip);
 /* clear out all open ZIP files from the cache */
 void zip_file_cache_clear(void);
 
+/* allow several threads to use the cache at once; calls must be paired and made from a single thread */
+void zip_file_cache_share(void);
+void zip_file_cache_unshare(void);
+
 
 /* ----- contained file access ----- */
 
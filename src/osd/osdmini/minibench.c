@@ -0,0 +1,236 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+//============================================================
+//
+//  minibench.c - Synthetic benchmarks for mini OSD
+//
+//============================================================
+
+#include "emu.h"
+#include "osdmini.h"
+
+
+//============================================================
+//  CONSTANTS
+//============================================================
+
+// each configuration runs for at least this many frames and this long
+static const int BENCH_MIN_FRAMES = 60;
+static const double BENCH_MIN_SECONDS = 0.25;
+
+// number of distinct tiles in each graphics set
+static const int BENCH_TILES = 1024;
+
+// kinds of destination bitmap
+enum
+{
+	BENCH_IND16,
+	BENCH_RGB32
+};
+
+// 8x8 and 16x16 packed 4bpp tiles
+static const gfx_layout bench_layout_8x8 =
+{
+	8,8,
+	BENCH_TILES,
+	4,
+	{ STEP4(0,1) },
+	{ STEP8(0,4) },
+	{ STEP8(0,4*8) },
+	8*8*4
+};
+
+static const gfx_layout bench_layout_16x16 =
+{
+	16,16,
+	BENCH_TILES,
+	4,
+	{ STEP4(0,1) },
+	{ STEP16(0,4) },
+	{ STEP16(0,4*16) },
+	16*16*4
+};
+
+
+//============================================================
+//  TYPE DEFINITIONS
+//============================================================
+
+// one standard way of drawing a tilemap
+struct tilemap_bench_config
+{
+	const char *    name;           // name reported in the log
+	int             tilesize;       // 8 or 16
+	int             bitmap;         // BENCH_IND16 or BENCH_RGB32
+	UINT32          flags;          // TILEMAP_DRAW_* flags
+	UINT8           priority;       // priority code to write, or 0 for none
+	int             scrollrows;     // number of independently scrolled rows
+	bool            dirty;          // mark every tile dirty each frame
+};
+
+static const tilemap_bench_config s_tilemap_configs[] =
+{
+	{ "8x8_opaque_ind16",       8,  BENCH_IND16, TILEMAP_DRAW_OPAQUE,                           0, 1,   false },
+	{ "8x8_transpen_ind16_pri", 8,  BENCH_IND16, 0,                                             1, 1,   false },
+	{ "8x8_rowscroll_ind16",    8,  BENCH_IND16, 0,                                             0, 256, false },
+	{ "8x8_dirty_ind16",        8,  BENCH_IND16, TILEMAP_DRAW_OPAQUE,                           0, 1,   true },
+	{ "16x16_opaque_rgb32",     16, BENCH_RGB32, TILEMAP_DRAW_OPAQUE,                           0, 1,   false },
+	{ "16x16_transpen_rgb32",   16, BENCH_RGB32, 0,                                             1, 1,   false },
+	{ "16x16_alpha_rgb32",      16, BENCH_RGB32, TILEMAP_DRAW_OPAQUE | TILEMAP_DRAW_ALPHA(0x80), 0, 1,   false },
+};
+
+
+// owns the graphics and tilemaps used by the benchmark
+class tilemap_benchmark
+{
+public:
+	tilemap_benchmark(running_machine &machine, screen_device &screen);
+	virtual ~tilemap_benchmark() { }
+
+	TILE_GET_INFO_MEMBER(get_tile_info_8x8);
+	TILE_GET_INFO_MEMBER(get_tile_info_16x16);
+
+	double run(const tilemap_bench_config &config);
+
+private:
+	running_machine &   m_machine;
+	screen_device &     m_screen;
+	gfx_element *       m_gfx_8x8;
+	gfx_element *       m_gfx_16x16;
+	tilemap_t *         m_tilemap_8x8;
+	tilemap_t *         m_tilemap_16x16;
+	bitmap_ind16        m_bitmap_ind16;
+	bitmap_rgb32        m_bitmap_rgb32;
+};
+
+
+//============================================================
+//  tilemap_benchmark - constructor
+//============================================================
+
+tilemap_benchmark::tilemap_benchmark(running_machine &machine, screen_device &screen)
+	: m_machine(machine),
+		m_screen(screen),
+		m_bitmap_ind16(screen.width(), screen.height()),
+		m_bitmap_rgb32(screen.width(), screen.height())
+{
+	// fill the tile data with a fixed pseudo-random pattern; about one
+	// pixel in sixteen comes out as pen 0, which is the transparent pen
+	UINT32 bytes = BENCH_TILES * 16 * 16 * 4 / 8;
+	UINT8 *tiledata = auto_alloc_array(machine, UINT8, bytes);
+	UINT32 seed = 12345;
+	for (UINT32 byte = 0; byte < bytes; byte++)
+	{
+		seed = seed * 1103515245 + 12345;
+		tiledata[byte] = seed >> 16;
+	}
+	m_gfx_8x8 = auto_alloc(machine, gfx_element(machine, bench_layout_8x8, tiledata, 16, 0));
+	m_gfx_16x16 = auto_alloc(machine, gfx_element(machine, bench_layout_16x16, tiledata, 16, 0));
+
+	// 512x256 and 512x512 pixel maps, so that every frame wraps
+	m_tilemap_8x8 = &machine.tilemap().create(tilemap_get_info_delegate(FUNC(tilemap_benchmark::get_tile_info_8x8), this), TILEMAP_SCAN_ROWS, 8, 8, 64, 32);
+	m_tilemap_16x16 = &machine.tilemap().create(tilemap_get_info_delegate(FUNC(tilemap_benchmark::get_tile_info_16x16), this), TILEMAP_SCAN_ROWS, 16, 16, 32, 32);
+	m_tilemap_8x8->set_transparent_pen(0);
+	m_tilemap_16x16->set_transparent_pen(0);
+
+	// RGB32 drawing looks colors up in the bitmap's own palette
+	palette_t *palette = palette_alloc(256, 1);
+	for (int index = 0; index < 256; index++)
+	{
+		seed = seed * 1103515245 + 12345;
+		palette_entry_set_color(palette, index, MAKE_RGB(seed >> 24, seed >> 16, seed >> 8));
+	}
+	m_bitmap_rgb32.set_palette(palette);
+	palette_deref(palette);
+}
+
+
+//============================================================
+//  get_tile_info_8x8/16x16 - scatter the tiles
+//  and colors across the map
+//============================================================
+
+TILE_GET_INFO_MEMBER(tilemap_benchmark::get_tile_info_8x8)
+{
+	tileinfo.set(m_machine, *m_gfx_8x8, tile_index * 37, (tile_index >> 3) & 15, 0);
+}
+
+TILE_GET_INFO_MEMBER(tilemap_benchmark::get_tile_info_16x16)
+{
+	tileinfo.set(m_machine, *m_gfx_16x16, tile_index * 37, (tile_index >> 3) & 15, 0);
+}
+
+
+//============================================================
+//  run - draw one configuration repeatedly and
+//  return the rate in millions of pixels per
+//  second
+//============================================================
+
+double tilemap_benchmark::run(const tilemap_bench_config &config)
+{
+	tilemap_t &tilemap = (config.tilesize == 8) ? *m_tilemap_8x8 : *m_tilemap_16x16;
+	const rectangle &cliprect = m_bitmap_ind16.cliprect();
+
+	// set up scrolling, and make sure every tile is realized before timing
+	tilemap.set_scroll_rows(config.scrollrows);
+	tilemap.mark_all_dirty();
+	if (config.bitmap == BENCH_IND16)
+		tilemap.draw(m_screen, m_bitmap_ind16, cliprect, config.flags, config.priority);
+	else
+		tilemap.draw(m_screen, m_bitmap_rgb32, cliprect, config.flags, config.priority);
+
+	// draw frames, moving the scroll position so alignment varies
+	osd_ticks_t start = osd_ticks();
+	osd_ticks_t mintime = (osd_ticks_t)(BENCH_MIN_SECONDS * (double)osd_ticks_per_second());
+	int frames;
+	for (frames = 0; frames < BENCH_MIN_FRAMES || osd_ticks() - start < mintime; frames++)
+	{
+		for (int row = 0; row < config.scrollrows; row++)
+			tilemap.set_scrollx(row, frames * 3 + row);
+		tilemap.set_scrolly(0, frames * 2);
+		if (config.dirty)
+			tilemap.mark_all_dirty();
+
+		if (config.bitmap == BENCH_IND16)
+			tilemap.draw(m_screen, m_bitmap_ind16, cliprect, config.flags, config.priority);
+		else
+			tilemap.draw(m_screen, m_bitmap_rgb32, cliprect, config.flags, config.priority);
+	}
+	double seconds = (double)(osd_ticks() - start) / (double)osd_ticks_per_second();
+
+	// leave the tilemap the way we found it for the next configuration
+	tilemap.set_scroll_rows(1);
+	return (double)frames * (double)(cliprect.width() * cliprect.height()) / seconds / 1000000.0;
+}
+
+
+//============================================================
+//  mini_bench_tilemaps - draw each standard
+//  tilemap configuration and append its rate
+//  to the benchmark line
+//============================================================
+
+void mini_bench_tilemaps(running_machine &machine, astring &line)
+{
+	// we draw at the size of the screen, since priority goes into its bitmap
+	if (machine.primary_screen == NULL)
+	{
+		mame_printf_error("Skipping the tilemap benchmark because %s has no screen\n", machine.system().name);
+		return;
+	}
+
+	// emulation is over and the devices are stopped, so the screen no longer
+	// knows its machine; briefly reopen state registration for our tilemaps
+	machine.save().allow_registration(true);
+	tilemap_benchmark *bench = auto_alloc(machine, tilemap_benchmark(machine, *machine.primary_screen));
+	machine.save().allow_registration(false);
+
+	for (int confignum = 0; confignum < ARRAY_LENGTH(s_tilemap_configs); confignum++)
+	{
+		const tilemap_bench_config &config = s_tilemap_configs[confignum];
+		double rate = bench->run(config);
+		line.catprintf("\ttilemap:%s=%.3f", config.name, rate);
+		mame_printf_info("tilemap %s: %.2f million pixels per second\n", config.name, rate);
+	}
+}
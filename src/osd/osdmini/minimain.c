@@ -33,6 +33,21 @@ enum
 };
 
 
+//============================================================
+//  OPTIONS
+//============================================================
+
+const options_entry mini_options::s_option_entries[] =
+{
+	// benchmarking options
+	{ NULL,                                   NULL,       OPTION_HEADER,     "BENCHMARKING OPTIONS" },
+	{ MINIOPTION_BENCH,                       "0",        OPTION_INTEGER,    "benchmark for the given number of emulated seconds; implies -nosound -nothrottle and skips rendering; the system name may be a wildcard to benchmark several systems in turn" },
+	{ MINIOPTION_BENCHLOG,                    "bench.log", OPTION_STRING,    "file to append one line of machine-readable benchmark results per system to" },
+	{ MINIOPTION_BENCHTILEMAP,                "0",        OPTION_BOOLEAN,    "when benchmarking, also draw a set of standard tilemap configurations at the end and report millions of pixels per second for each" },
+	{ NULL }
+};
+
+
 //============================================================
 //  GLOBALS
 //============================================================
@@ -52,6 +67,7 @@ static UINT8 keyboard_state[KEY_TOTAL];
 //============================================================
 
 static INT32 keyboard_get_state(void *device_internal, void *item_internal);
+static int run_benchmark_list(int argc, char *argv[], mini_options &options);
 
 
 //============================================================
@@ -60,20 +76,85 @@ static INT32 keyboard_get_state(void *device_internal, void *item_internal);
 
 int main(int argc, char *argv[])
 {
+	// when benchmarking, a wildcard system name selects a list of systems
+	{
+		mini_options options;
+		astring option_errors;
+		options.parse_command_line(argc, argv, option_errors);
+		if (options.bench() > 0 && *options.command() == 0 && strpbrk(options.system_name(), "*?") != NULL)
+			return run_benchmark_list(argc, argv, options);
+	}
+
 	// cli_frontend does the heavy lifting; if we have osd-specific options, we
 	// create a derivative of cli_options and add our own
-	cli_options options;
+	mini_options options;
 	mini_osd_interface osd;
 	cli_frontend frontend(options, osd);
 	return frontend.execute(argc, argv);
 }
 
 
+//============================================================
+//  run_benchmark_list
+//============================================================
+
+static int run_benchmark_list(int argc, char *argv[], mini_options &options)
+{
+	// find the argument holding the wildcard so we can substitute each system name
+	const char *pattern = options.system_name();
+	int patternarg;
+	for (patternarg = 1; patternarg < argc; patternarg++)
+		if (strcmp(argv[patternarg], pattern) == 0)
+			break;
+	if (patternarg == argc)
+		return MAMERR_INVALID_CONFIG;
+
+	// make a private copy of the arguments
+	dynamic_array<char *> args(argc + 1);
+	for (int argnum = 0; argnum < argc; argnum++)
+		args[argnum] = argv[argnum];
+	args[argc] = NULL;
+
+	// run each matching system with a fresh set of options; report the first failure
+	int result = MAMERR_NONE;
+	driver_enumerator drivlist(options, pattern);
+	while (drivlist.next())
+	{
+		// skip the empty driver and anything that can't run on its own
+		if (&drivlist.driver() == &GAME_NAME(___empty) || (drivlist.driver().flags & GAME_NO_STANDALONE) != 0)
+			continue;
+
+		args[patternarg] = const_cast<char *>(drivlist.driver().name);
+		mini_options sysoptions;
+		mini_osd_interface osd;
+		cli_frontend frontend(sysoptions, osd);
+		int sysresult = frontend.execute(argc, args);
+		if (result == MAMERR_NONE)
+			result = sysresult;
+	}
+	return result;
+}
+
+
+//============================================================
+//  mini_options
+//============================================================
+
+mini_options::mini_options()
+{
+	add_entries(s_option_entries);
+}
+
+
 //============================================================
 //  constructor
 //============================================================
 
 mini_osd_interface::mini_osd_interface()
+	: m_bench(0),
+		m_bench_start_ticks(0),
+		m_bench_start_time(attotime::zero),
+		m_bench_frames(0)
 {
 }
 
@@ -96,6 +177,23 @@ void mini_osd_interface::init(running_machine &machine)
 	// call our parent
 	osd_interface::init(machine);
 
+	// if we are benchmarking, turn off everything that isn't emulation
+	mini_options &options = downcast<mini_options &>(machine.options());
+	m_bench = options.bench();
+	m_bench_frames = 0;
+	if (m_bench > 0)
+	{
+		astring error_string;
+		options.set_value(OPTION_THROTTLE, false, OPTION_PRIORITY_MAXIMUM, error_string);
+		options.set_value(OPTION_SOUND, false, OPTION_PRIORITY_MAXIMUM, error_string);
+		options.set_value(OPTION_SECONDS_TO_RUN, m_bench, OPTION_PRIORITY_MAXIMUM, error_string);
+		assert(!error_string);
+
+		// collect profiler data if it was compiled in, and report it when we're done
+		g_profiler.enable(true);
+		machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(mini_osd_interface::bench_exit), this));
+	}
+
 	// initialize the video system by allocating a rendering target
 	our_target = machine.render().target_alloc();
 
@@ -131,6 +229,17 @@ void mini_osd_interface::init(running_machine &machine)
 
 void mini_osd_interface::update(bool skip_redraw)
 {
+	// when benchmarking, just count frames; timing starts with the first one
+	if (m_bench > 0)
+	{
+		if (m_bench_frames++ == 0)
+		{
+			m_bench_start_ticks = osd_ticks();
+			m_bench_start_time = machine().time();
+		}
+		return;
+	}
+
 	// get the minimum width/height for the current layout
 	int minwidth, minheight;
 	our_target->compute_minimum_size(minwidth, minheight);
@@ -153,6 +262,75 @@ void mini_osd_interface::update(bool skip_redraw)
 }
 
 
+//============================================================
+//  bench_exit
+//============================================================
+
+void mini_osd_interface::bench_exit()
+{
+	// compute the overall rates over the frames we produced
+	double wall = (double)(osd_ticks() - m_bench_start_ticks) / (double)osd_ticks_per_second();
+	double emulated = (machine().time() - m_bench_start_time).as_double();
+	UINT64 frames = (m_bench_frames > 0) ? m_bench_frames - 1 : 0;
+	if (wall <= 0)
+		wall = 1.0 / (double)osd_ticks_per_second();
+
+	// build one line of tab-separated name=value pairs
+	astring line;
+	line.printf("system=%s\temulated=%.6f\twall=%.6f\tspeed=%.6f\tfps=%.3f", machine().system().name, emulated, wall, emulated / wall, (double)frames / wall);
+
+	// append each non-empty profiler bucket as a percentage of the total
+	UINT64 total = 0;
+	for (profile_type curtype = PROFILER_DEVICE_FIRST; curtype < PROFILER_TOTAL; curtype++)
+		total += g_profiler.data(curtype);
+	if (total != 0)
+	{
+		device_iterator iter(machine().root_device());
+		for (profile_type curtype = PROFILER_DEVICE_FIRST; curtype < PROFILER_TOTAL; curtype++)
+		{
+			UINT64 computed = g_profiler.data(curtype);
+			if (computed == 0)
+				continue;
+			if (curtype <= PROFILER_DEVICE_MAX)
+				line.catprintf("\tprofile:%s=%.3f", iter.byindex(curtype - PROFILER_DEVICE_FIRST)->tag(), (double)computed * 100.0 / (double)total);
+			else
+				line.catprintf("\tprofile:%s=%.3f", g_profiler.type_name(curtype), (double)computed * 100.0 / (double)total);
+		}
+	}
+	g_profiler.enable(false);
+
+	// append the rate at which each route between streams was resampled; the
+	// devices are stopped by now, so stick to their tags
+	for (sound_stream *stream = machine().sound().first_stream(); stream != NULL; stream = stream->next())
+		for (int inputnum = 0; inputnum < stream->input_count(); inputnum++)
+		{
+			device_t *source = stream->input_source_device(inputnum);
+			osd_ticks_t ticks = stream->input_resample_ticks(inputnum);
+			if (source == NULL || ticks == 0)
+				continue;
+			double rate = (double)stream->input_resample_samples(inputnum) * (double)osd_ticks_per_second() / (double)ticks / 1000000.0;
+			line.catprintf("\troute:%s.%d>%s.%d=%.3f", source->tag(), stream->input_source_outputnum(inputnum), stream->device().tag(), inputnum, rate);
+			mame_printf_info("route '%s' output %d to '%s' input %d (%s): %.2f million samples per second\n", source->tag(), stream->input_source_outputnum(inputnum),
+					stream->device().tag(), inputnum, stream->input_sinc_resampled(inputnum) ? "sinc" : "linear", rate);
+		}
+
+	// optionally follow up with the synthetic tilemap benchmark
+	if (downcast<mini_options &>(machine().options()).bench_tilemap())
+		mini_bench_tilemaps(machine(), line);
+
+	// append it to the log
+	FILE *logfile = fopen(downcast<mini_options &>(machine().options()).bench_log(), "a");
+	if (logfile != NULL)
+	{
+		fprintf(logfile, "%s\n", line.cstr());
+		fclose(logfile);
+	}
+	else
+		mame_printf_error("Unable to open benchmark log '%s'\n", downcast<mini_options &>(machine().options()).bench_log());
+	mame_printf_info("%s: %.2f emulated seconds per second, %.2f frames per second\n", machine().system().name, emulated / wall, (double)frames / wall);
+}
+
+
 //============================================================
 //  update_audio_stream
 //============================================================
@@ -10,6 +10,14 @@
 #include <stdlib.h>
 
 
+//============================================================
+//  GLOBAL VARIABLES
+//============================================================
+
+// accepted for compatibility with the tools; work is always done inline
+int osd_num_processors = 0;
+
+
 //============================================================
 //  TYPE DEFINITIONS
 //============================================================
@@ -8,12 +8,39 @@
 
 #include "options.h"
 #include "osdepend.h"
+#include "clifront.h"
+
+
+//============================================================
+//  CONSTANTS
+//============================================================
+
+#define MINIOPTION_BENCH                "bench"
+#define MINIOPTION_BENCHLOG             "benchlog"
+#define MINIOPTION_BENCHTILEMAP         "benchtilemap"
+
 
 
 //============================================================
 //  TYPE DEFINITIONS
 //============================================================
 
+class mini_options : public cli_options
+{
+public:
+	// construction/destruction
+	mini_options();
+
+	// benchmarking options
+	int bench() const { return int_value(MINIOPTION_BENCH); }
+	const char *bench_log() const { return value(MINIOPTION_BENCHLOG); }
+	bool bench_tilemap() const { return bool_value(MINIOPTION_BENCHTILEMAP); }
+
+private:
+	static const options_entry s_option_entries[];
+};
+
+
 class mini_osd_interface : public osd_interface
 {
 public:
@@ -38,6 +65,13 @@ public:
 
 private:
 	static void osd_exit(running_machine &machine);
+	void bench_exit();
+
+	// benchmarking state
+	int                 m_bench;            // number of emulated seconds to benchmark, or 0
+	osd_ticks_t         m_bench_start_ticks; // host ticks when the first frame was produced
+	attotime            m_bench_start_time; // emulated time when the first frame was produced
+	UINT64              m_bench_frames;     // number of frames produced since then
 };
 
 
@@ -60,6 +94,9 @@ extern int osd_num_processors;
 // use if you want to print something with the verbose flag
 void CLIB_DECL mame_printf_verbose(const char *text, ...) ATTR_PRINTF(1,2);
 
+// defined in minibench.c
+void mini_bench_tilemaps(running_machine &machine, astring &line);
+
 // use this to ping the watchdog
 void winmain_watchdog_ping(void);
 void winmain_dump_stack();
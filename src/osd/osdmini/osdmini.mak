@@ -68,7 +68,8 @@ OSDCOREOBJS = \
 #-------------------------------------------------
 
 OSDOBJS = \
-	$(MINIOBJ)/minimain.o
+	$(MINIOBJ)/minimain.o \
+	$(MINIOBJ)/minibench.o
 
 
 
@@ -386,6 +386,7 @@ OSDOBJS = \
 	$(SDLOBJ)/sdlmain.o \
 	$(SDLOBJ)/input.o \
 	$(SDLOBJ)/sound.o  \
+	$(SDLOBJ)/sdlaudio.o \
 	$(SDLOBJ)/video.o \
 	$(SDLOBJ)/drawsdl.o \
 	$(SDLOBJ)/window.o \
@@ -0,0 +1,268 @@
+//============================================================
+//
+//  sdlaudio.c - SDL audio ring buffer and latency control
+//
+//  Copyright (c) 1996-2010, Nicola Salmoria and the MAME Team.
+//  Visit http://mamedev.org for licensing and usage restrictions.
+//
+//  SDLMAME by Olivier Galibert and R. Belmont
+//
+//============================================================
+
+// MAME headers
+#include "emu.h"
+
+#include "sdlaudio.h"
+
+//============================================================
+//  PARAMETERS
+//============================================================
+
+// latency controller: updates without an underflow before the target depth
+// shrinks by one callback's worth, how quickly the fill error is smoothed, and
+// the largest rate correction applied to the incoming audio
+#define LATENCY_RELAX_UPDATES   250
+#define FILL_ERROR_SMOOTHING    0.05
+#define MAX_RATE_CORRECTION     0.005
+
+//============================================================
+//  sdl_audio_ring - constructor
+//============================================================
+
+sdl_audio_ring::sdl_audio_ring()
+	: m_buffer(NULL),
+		m_size(0),
+		m_write(0),
+		m_read(0),
+		m_sample_rate(0),
+		m_xfer_samples(0),
+		m_started(false),
+		m_target(0),
+		m_min_target(0),
+		m_max_target(0),
+		m_quiet_updates(0),
+		m_seen_underflows(0),
+		m_fill_error(0),
+		m_resample_pos(0),
+		m_overflows(0),
+		m_underflows(0)
+{
+	m_last_frame[0] = m_last_frame[1] = 0;
+}
+
+//============================================================
+//  allocate - size the ring for the given rate,
+//  callback size and -audio_latency setting
+//============================================================
+
+void sdl_audio_ring::allocate(int sample_rate, int xfer_samples, int audio_latency)
+{
+	release();
+	m_sample_rate = sample_rate;
+	m_xfer_samples = xfer_samples;
+	m_started = false;
+
+	// the configured latency is the most we'll queue; the controller starts there
+	// and works down toward a couple of callbacks plus one update's worth
+	m_min_target = (2 * xfer_samples + sample_rate / 50) * FRAME_BYTES;
+	m_max_target = sample_rate * FRAME_BYTES * audio_latency / (2 * MAX_AUDIO_LATENCY);
+	m_max_target = MAX(m_max_target, m_min_target) & ~(FRAME_BYTES - 1);
+	m_target = m_max_target;
+	m_quiet_updates = 0;
+	m_seen_underflows = m_underflows;
+	m_fill_error = 0;
+
+	// the first block starts on its own first frame
+	m_resample_pos = 1 << 16;
+	m_last_frame[0] = m_last_frame[1] = 0;
+
+	// compute the buffer size, with room for the deepest target and a spare update
+	m_size = 1024;
+	while (m_size < 2 * m_max_target)
+		m_size <<= 1;
+
+	m_buffer = global_alloc_array_clear(INT8, m_size);
+	m_write = 0;
+	m_read = 0;
+}
+
+//============================================================
+//  release - free the ring
+//============================================================
+
+void sdl_audio_ring::release()
+{
+	if (m_buffer != NULL)
+		global_free(m_buffer);
+	m_buffer = NULL;
+	m_resample.reset();
+}
+
+//============================================================
+//  fill - bytes queued but not yet played
+//============================================================
+
+UINT32 sdl_audio_ring::fill()
+{
+	// the locked adds act as barriers, so the data behind each position is visible
+	return UINT32(atomic_add32(&m_write, 0)) - UINT32(atomic_add32(&m_read, 0));
+}
+
+//============================================================
+//  update_latency_controller - adjust the target
+//  depth and the smoothed fill error
+//============================================================
+
+void sdl_audio_ring::update_latency_controller(UINT32 fill)
+{
+	// any underflow since the last update means we're running too close; back off
+	int underflows = m_underflows;
+	if (underflows != m_seen_underflows)
+	{
+		m_seen_underflows = underflows;
+		m_target = MIN(m_target + m_xfer_samples * FRAME_BYTES, m_max_target);
+		m_quiet_updates = 0;
+	}
+
+	// after a long stretch without trouble, creep back toward the minimum
+	else if (++m_quiet_updates >= LATENCY_RELAX_UPDATES)
+	{
+		if (m_target > m_min_target)
+			m_target = MAX(m_target - m_xfer_samples * FRAME_BYTES, m_min_target);
+		m_quiet_updates = 0;
+	}
+
+	double error = (double(fill) - double(m_target)) / FRAME_BYTES;
+	m_fill_error += (error - m_fill_error) * FILL_ERROR_SMOOTHING;
+}
+
+//============================================================
+//  resample_frames - stretch or squeeze a block
+//  very slightly so the fill tracks the target
+//============================================================
+
+int sdl_audio_ring::resample_frames(const INT16 *data, int frames, int attenuation)
+{
+	if (frames <= 0)
+		return 0;
+
+	// aim to remove the smoothed error over about a second, within a small bound
+	double correction = -m_fill_error / m_sample_rate;
+	correction = MAX(-MAX_RATE_CORRECTION, MIN(MAX_RATE_CORRECTION, correction));
+	if (!m_started)
+		correction = 0;
+	UINT32 step = UINT32(65536.0 / (1.0 + correction) + 0.5);
+
+	// apply the attenuation as we go
+	int level = (int) (pow(10.0, (float) attenuation / 20.0) * 128.0);
+	int maxframes = int(frames * (1.0 + MAX_RATE_CORRECTION)) + 2;
+	if (m_resample.count() < maxframes * 2)
+		m_resample.resize(maxframes * 2);
+	INT16 *dest = m_resample;
+
+	// linearly interpolate in 16.16 fixed point; position 0 is the last frame of
+	// the previous block and position N is frame N - 1 of this one, so the
+	// phase runs on smoothly from one block into the next
+	UINT32 pos = m_resample_pos;
+	int outframes = 0;
+	for ( ; (pos >> 16) < UINT32(frames); pos += step, outframes++)
+	{
+		int index = pos >> 16;
+		int frac = pos & 0xffff;
+		for (int channel = 0; channel < 2; channel++)
+		{
+			INT32 prev = (index == 0) ? m_last_frame[channel] : data[(index - 1) * 2 + channel];
+			INT32 next = data[index * 2 + channel];
+			INT32 sample = prev + (((next - prev) * (frac >> 1)) >> 15);
+			*dest++ = (sample * level) >> 7; /* / 128 */
+		}
+	}
+
+	// carry the position and the last frame into the next block
+	m_resample_pos = pos - (frames << 16);
+	m_last_frame[0] = data[(frames - 1) * 2 + 0];
+	m_last_frame[1] = data[(frames - 1) * 2 + 1];
+	return outframes;
+}
+
+//============================================================
+//  copy_sample_data
+//============================================================
+
+void sdl_audio_ring::copy_sample_data(const INT16 *data, UINT32 bytes_to_copy)
+{
+	UINT32 write = m_write;
+	UINT32 offset = write & (m_size - 1);
+
+	// copy the first chunk, then whatever wrapped around
+	UINT32 length1 = MIN(bytes_to_copy, m_size - offset);
+	memcpy(&m_buffer[offset], data, length1);
+	if (bytes_to_copy > length1)
+		memcpy(m_buffer, (const UINT8 *)data + length1, bytes_to_copy - length1);
+
+	// publish the new data to the audio thread
+	atomic_exchange32(&m_write, INT32(write + bytes_to_copy));
+}
+
+//============================================================
+//  write - resample a block into the ring,
+//  dropping it if there isn't room
+//============================================================
+
+bool sdl_audio_ring::write(const INT16 *data, int frames, int attenuation)
+{
+	// let the controller see how we're doing, then nudge this block's length
+	UINT32 fill = this->fill();
+	if (m_started)
+		update_latency_controller(fill);
+	UINT32 bytes_this_frame = resample_frames(data, frames, attenuation) * FRAME_BYTES;
+
+	// if there's no room for this block, skip it
+	if (fill + bytes_this_frame > m_size)
+	{
+		m_overflows++;
+		return false;
+	}
+
+	copy_sample_data(m_resample, bytes_this_frame);
+
+	// start playing once the initial depth has built up
+	if (!m_started && fill + bytes_this_frame >= m_target)
+	{
+		m_started = true;
+		return true;
+	}
+	return false;
+}
+
+//============================================================
+//  read - fill an SDL callback's buffer
+//============================================================
+
+void sdl_audio_ring::read(UINT8 *stream, int len, bool enabled)
+{
+	UINT32 read = m_read;
+	UINT32 avail = UINT32(atomic_add32(&m_write, 0)) - read;
+
+	// play whatever we have; running dry pads with silence and lets the controller know
+	UINT32 bytes = MIN(avail, UINT32(len)) & ~(FRAME_BYTES - 1);
+	if (bytes < UINT32(len))
+		m_underflows++;
+
+	UINT32 offset = read & (m_size - 1);
+	UINT32 len1 = MIN(bytes, m_size - offset);
+	if (enabled)
+	{
+		memcpy(stream, m_buffer + offset, len1);
+		if (bytes > len1)
+			memcpy(stream + len1, m_buffer, bytes - len1);
+		memset(stream + bytes, 0, len - bytes);
+	}
+	else
+	{
+		memset(stream, 0, len);
+	}
+
+	// hand the space back to the producer
+	atomic_exchange32(&m_read, INT32(read + bytes));
+}
@@ -0,0 +1,94 @@
+//============================================================
+//
+//  sdlaudio.h - SDL audio ring buffer and latency control
+//
+//  Copyright (c) 1996-2010, Nicola Salmoria and the MAME Team.
+//  Visit http://mamedev.org for licensing and usage restrictions.
+//
+//  SDLMAME by Olivier Galibert and R. Belmont
+//
+//============================================================
+
+#ifndef __SDLAUDIO__
+#define __SDLAUDIO__
+
+//============================================================
+//  CONSTANTS
+//============================================================
+
+// maximum audio latency
+#define MAX_AUDIO_LATENCY       5
+
+
+//============================================================
+//  TYPE DEFINITIONS
+//============================================================
+
+// single-producer/single-consumer ring of stereo 16-bit frames between the
+// emulation and the SDL audio callback; the producer side steers its depth
+// by stretching or squeezing each block very slightly
+class sdl_audio_ring
+{
+public:
+	// bytes per stereo 16-bit frame
+	static const int FRAME_BYTES = 2 * sizeof(INT16);
+
+	// construction/destruction
+	sdl_audio_ring();
+	~sdl_audio_ring() { release(); }
+
+	// getters
+	bool allocated() const { return m_buffer != NULL; }
+	bool started() const { return m_started; }
+	UINT32 fill();
+	UINT32 size() const { return m_size; }
+	UINT32 target() const { return m_target; }
+	int overflows() const { return m_overflows; }
+	int underflows() const { return m_underflows; }
+
+	// setup
+	void allocate(int sample_rate, int xfer_samples, int audio_latency);
+	void release();
+
+	// producer side; returns true once, when enough has built up to start playing
+	bool write(const INT16 *data, int frames, int attenuation);
+
+	// consumer side, called from the audio thread
+	void read(UINT8 *stream, int len, bool enabled);
+
+private:
+	// internal helpers
+	void update_latency_controller(UINT32 fill);
+	int resample_frames(const INT16 *data, int frames, int attenuation);
+	void copy_sample_data(const INT16 *data, UINT32 bytes_to_copy);
+
+	// the ring; each position counts bytes ever written or read and is only
+	// changed by its own side
+	INT8 *              m_buffer;
+	UINT32              m_size;                 // always a power of two
+	volatile INT32      m_write;
+	volatile INT32      m_read;
+
+	// latency controller state, owned by the producer
+	int                 m_sample_rate;
+	int                 m_xfer_samples;
+	bool                m_started;              // has playback been started?
+	UINT32              m_target;               // fill we steer toward, in bytes
+	UINT32              m_min_target;
+	UINT32              m_max_target;
+	int                 m_quiet_updates;
+	int                 m_seen_underflows;
+	double              m_fill_error;           // smoothed fill - target, in frames
+
+	// resampler state, carried from one block to the next
+	UINT32              m_resample_pos;         // 16.16 position; 0 is the previous block's last frame
+	INT16               m_last_frame[2];        // last frame of the previous block
+	dynamic_array<INT16> m_resample;
+
+	// over/underflow counts; underflows are counted on the audio thread
+	int                 m_overflows;
+	volatile int        m_underflows;
+};
+
+
+#endif  /* __SDLAUDIO__ */
@@ -11,13 +11,10 @@
 
 #if defined(SDLMAME_NOASM)
 
-/* must be exported
- * FIXME: NOASM should be taken care of in sdlsync.c
+/* FIXME: NOASM should be taken care of in sdlsync.c
  *        This is not really a sound solution.
  */
 
-int osd_num_processors = 0;
-
 #include "../osdmini/miniwork.c"
 
 #else
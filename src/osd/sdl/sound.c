@@ -18,6 +18,7 @@
 
 #include "osdepend.h"
 #include "osdsdl.h"
+#include "sdlaudio.h"
 
 //============================================================
 //  DEBUGGING
@@ -33,11 +34,6 @@
 #define SDL_XFER_SAMPLES    (512)
 
 static int sdl_xfer_samples = SDL_XFER_SAMPLES;
-static int stream_in_initialized = 0;
-static int stream_loop = 0;
-
-// maximum audio latency
-#define MAX_AUDIO_LATENCY       5
 
 //============================================================
 //  LOCAL VARIABLES
@@ -46,17 +42,9 @@ static int stream_loop = 0;
 static int              attenuation = 0;
 
 static int              initialized_audio = 0;
-static int              buf_locked;
-
-static INT8             *stream_buffer;
-static volatile INT32   stream_playpos;
 
-static UINT32           stream_buffer_size;
-static UINT32           stream_buffer_in;
-
-// buffer over/underflow counts
-static int              buffer_underflows;
-static int              buffer_overflows;
+// ring between the emulation and the audio callback, with its latency controller
+static sdl_audio_ring   stream_ring;
 
 // debugging
 static FILE *sound_log;
@@ -71,7 +59,7 @@ static int snd_enabled;
 
 static int          sdl_init(running_machine &machine);
 static void         sdl_kill(running_machine &machine);
-static int          sdl_create_buffers(void);
+static int          sdl_create_buffers(running_machine &machine, int audio_latency);
 static void         sdl_destroy_buffers(void);
 static void         sdl_cleanup_audio(running_machine &machine);
 static void         SDLCALL sdl_callback(void *userdata, Uint8 *stream, int len);
@@ -117,146 +105,17 @@ static void sdl_cleanup_audio(running_machine &machine)
 	sdl_destroy_buffers();
 
 	// print out over/underflow stats
-	if (buffer_overflows || buffer_underflows)
-		mame_printf_verbose("Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+	if (stream_ring.overflows() || stream_ring.underflows())
+		mame_printf_verbose("Sound buffer: overflows=%d underflows=%d\n", stream_ring.overflows(), stream_ring.underflows());
+	mame_printf_verbose("Sound buffer: settled at %u ms latency\n", stream_ring.target() * 1000 / UINT32(machine.sample_rate() * sdl_audio_ring::FRAME_BYTES));
 
 	if (LOG_SOUND)
 	{
-		fprintf(sound_log, "Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+		fprintf(sound_log, "Sound buffer: overflows=%d underflows=%d\n", stream_ring.overflows(), stream_ring.underflows());
 		fclose(sound_log);
 	}
 }
 
-//============================================================
-//  lock_buffer
-//============================================================
-static int lock_buffer(running_machine &machine, long offset, long size, void **buffer1, long *length1, void **buffer2, long *length2)
-{
-	volatile long pstart, pend, lstart, lend;
-
-	if (!buf_locked)
-	{
-		if (machine.video().throttled())
-		{
-			pstart = stream_playpos;
-			pend = (pstart + sdl_xfer_samples);
-			lstart = offset;
-			lend = lstart+size;
-			while (((pstart >= lstart) && (pstart <= lend)) ||
-					((pend >= lstart) && (pend <= lend)))
-			{
-				pstart = stream_playpos;
-				pend = pstart + sdl_xfer_samples;
-			}
-		}
-
-		SDL_LockAudio();
-		buf_locked++;
-	}
-
-	// init lengths
-	*length1 = *length2 = 0;
-
-	if ((offset + size) > stream_buffer_size)
-	{
-		// 2-piece case
-		*length1 = stream_buffer_size - offset;
-		*buffer1 = &stream_buffer[offset];
-		*length2 = size - *length1;
-		*buffer2 = stream_buffer;
-	}
-	else
-	{
-		// normal 1-piece case
-		*length1 = size;
-		*buffer1 = &stream_buffer[offset];
-	}
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "locking %ld bytes at offset %ld (total %d, playpos %d): len1 %ld len2 %ld\n",
-			size, offset, stream_buffer_size, stream_playpos, *length1, *length2);
-
-	return 0;
-}
-
-//============================================================
-//  unlock_buffer
-//============================================================
-static void unlock_buffer(void)
-{
-	buf_locked--;
-	if (!buf_locked)
-		SDL_UnlockAudio();
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "unlocking\n");
-
-}
-
-//============================================================
-//  Apply attenuation
-//============================================================
-
-static void att_memcpy(void *dest, const INT16 *data, int bytes_to_copy)
-{
-	int level= (int) (pow(10.0, (float) attenuation / 20.0) * 128.0);
-	INT16 *d = (INT16 *) dest;
-	int count = bytes_to_copy/2;
-	while (count>0)
-	{
-		*d++ = (*data++ * level) >> 7; /* / 128 */
-		count--;
-	}
-}
-
-//============================================================
-//  copy_sample_data
-//============================================================
-
-static void copy_sample_data(running_machine &machine, const INT16 *data, int bytes_to_copy)
-{
-	void *buffer1, *buffer2 = (void *)NULL;
-	long length1, length2;
-	int cur_bytes;
-
-	// attempt to lock the stream buffer
-	if (lock_buffer(machine, stream_buffer_in, bytes_to_copy, &buffer1, &length1, &buffer2, &length2) < 0)
-	{
-		buffer_underflows++;
-		return;
-	}
-
-	// adjust the input pointer
-	stream_buffer_in += bytes_to_copy;
-	if (stream_buffer_in >= stream_buffer_size)
-	{
-		stream_buffer_in -= stream_buffer_size;
-		stream_loop = 1;
-
-		if (LOG_SOUND)
-			fprintf(sound_log, "stream_loop set to 1 (stream_buffer_in looped)\n");
-	}
-
-	// copy the first chunk
-	cur_bytes = (bytes_to_copy > length1) ? length1 : bytes_to_copy;
-	att_memcpy(buffer1, data, cur_bytes);
-
-	// adjust for the number of bytes
-	bytes_to_copy -= cur_bytes;
-	data = (INT16 *)((UINT8 *)data + cur_bytes);
-
-	// copy the second chunk
-	if (bytes_to_copy != 0)
-	{
-		cur_bytes = (bytes_to_copy > length2) ? length2 : bytes_to_copy;
-		att_memcpy(buffer2, data, cur_bytes);
-	}
-
-	// unlock
-	unlock_buffer();
-}
-
-
 //============================================================
 //  update_audio_stream
 //============================================================
@@ -264,76 +123,22 @@ static void copy_sample_data(running_machine &machine, const INT16 *data, int by
 void sdl_osd_interface::update_audio_stream(const INT16 *buffer, int samples_this_frame)
 {
 	// if nothing to do, don't do it
-	if (machine().sample_rate() != 0 && stream_buffer)
+	if (machine().sample_rate() != 0 && stream_ring.allocated())
 	{
-		int bytes_this_frame = samples_this_frame * sizeof(INT16) * 2;
-		int play_position, write_position, stream_in;
-		int orig_write; // used in LOG
+		int overflows = stream_ring.overflows();
 
-		play_position = stream_playpos;
-
-		write_position = stream_playpos + ((machine().sample_rate() / 50) * sizeof(INT16) * 2);
-		orig_write = write_position;
-
-		if (!stream_in_initialized)
-		{
-			stream_in = stream_buffer_in = (write_position + stream_buffer_size) / 2;
-
-			if (LOG_SOUND)
-			{
-				fprintf(sound_log, "stream_in = %d\n", (int)stream_in);
-				fprintf(sound_log, "stream_playpos = %d\n", (int)stream_playpos);
-				fprintf(sound_log, "write_position = %d\n", (int)write_position);
-			}
-			// start playing
+		// the ring resamples the block and tells us when enough has built up to start
+		if (stream_ring.write(buffer, samples_this_frame, attenuation))
 			SDL_PauseAudio(0);
 
-			stream_in_initialized = 1;
-		}
-		else
-		{
-			// normalize the stream in position
-			stream_in = stream_buffer_in;
-			if (stream_in < write_position && stream_loop == 1)
-				stream_in += stream_buffer_size;
-
-			// now we should have, in order:
-			//    <------pp---wp---si--------------->
-
-			// if we're between play and write positions, then bump forward, but only in full chunks
-			while (stream_in < write_position)
-			{
-				if (LOG_SOUND)
-					fprintf(sound_log, "Underflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
-
-				buffer_underflows++;
-				stream_in += bytes_this_frame;
-			}
-
-			// if we're going to overlap the play position, just skip this chunk
-			if (stream_in + bytes_this_frame > play_position + stream_buffer_size)
-			{
-				if (LOG_SOUND)
-					fprintf(sound_log, "Overflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
-
-				buffer_overflows++;
-				return;
-			}
-		}
-
-		if (stream_in >= stream_buffer_size)
+		if (LOG_SOUND)
 		{
-			stream_in -= stream_buffer_size;
-			stream_loop = 1;
-
-			if (LOG_SOUND)
-				fprintf(sound_log, "stream_loop set to 1 (stream_in looped)\n");
-
+			if (stream_ring.overflows() != overflows)
+				fprintf(sound_log, "Overflow: fill=%u target=%u frames=%d\n", stream_ring.fill(), stream_ring.target(), samples_this_frame);
+			else
+				fprintf(sound_log, "wrote %d frames (total %u, fill %u, target %u)\n",
+					samples_this_frame, stream_ring.size(), stream_ring.fill(), stream_ring.target());
 		}
-
-		// now we know where to copy; let's do it
-		stream_buffer_in = stream_in;
-		copy_sample_data(machine(), buffer, bytes_this_frame);
 	}
 }
 
@@ -359,60 +164,12 @@ void sdl_osd_interface::set_mastervolume(int _attenuation)
 //============================================================
 static void sdl_callback(void *userdata, Uint8 *stream, int len)
 {
-	int len1, len2, sb_in;
+	int underflows = stream_ring.underflows();
 
-	sb_in = stream_buffer_in;
-	if (stream_loop)
-		sb_in += stream_buffer_size;
+	stream_ring.read(stream, len, snd_enabled);
 
-	if (sb_in < (stream_playpos+len))
-	{
-		if (LOG_SOUND)
-			fprintf(sound_log, "Underflow at sdl_callback: SPP=%d SBI=%d(%d) Len=%d\n", (int)stream_playpos, (int)sb_in, (int)stream_buffer_in, (int)len);
-
-		return;
-	}
-	else if ((stream_playpos+len) > stream_buffer_size)
-	{
-		len1 = stream_buffer_size - stream_playpos;
-		len2 = len - len1;
-	}
-	else
-	{
-		len1 = len;
-		len2 = 0;
-	}
-
-	if (snd_enabled)
-	{
-		memcpy(stream, stream_buffer + stream_playpos, len1);
-		memset(stream_buffer + stream_playpos, 0, len1); // no longer needed
-		if (len2)
-		{
-			memcpy(stream+len1, stream_buffer, len2);
-			memset(stream_buffer, 0, len2); // no longer needed
-		}
-
-	}
-	else
-	{
-		memset(stream, 0, len);
-	}
-
-	// move the play cursor
-	stream_playpos += len1 + len2;
-	if (stream_playpos >= stream_buffer_size)
-	{
-		stream_playpos -= stream_buffer_size;
-		stream_loop = 0;
-
-		if (LOG_SOUND)
-			fprintf(sound_log, "stream_loop set to 0 (stream_playpos looped)\n");
-	}
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "callback: xfer len1 %d len2 %d, playpos %d\n",
-				len1, len2, stream_playpos);
+	if (LOG_SOUND && stream_ring.underflows() != underflows)
+		fprintf(sound_log, "Underflow at sdl_callback: Len=%d\n", len);
 }
 
 
@@ -442,8 +199,6 @@ static int sdl_init(running_machine &machine)
 	initialized_audio = 0;
 
 	sdl_xfer_samples = SDL_XFER_SAMPLES;
-	stream_in_initialized = 0;
-	stream_loop = 0;
 
 	// set up the audio specs
 	aspec.freq = machine.sample_rate();
@@ -476,14 +231,8 @@ static int sdl_init(running_machine &machine)
 		audio_latency = 1;
 	}
 
-	// compute the buffer sizes
-	stream_buffer_size = machine.sample_rate() * 2 * sizeof(INT16) * audio_latency / MAX_AUDIO_LATENCY;
-	stream_buffer_size = (stream_buffer_size / 1024) * 1024;
-	if (stream_buffer_size < 1024)
-		stream_buffer_size = 1024;
-
 	// create the buffers
-	if (sdl_create_buffers())
+	if (sdl_create_buffers(machine, audio_latency))
 		goto cant_create_buffers;
 
 	mame_printf_verbose("Audio: End initialization\n");
@@ -519,13 +268,11 @@ static void sdl_kill(running_machine &machine)
 //  dsound_create_buffers
 //============================================================
 
-static int sdl_create_buffers(void)
+static int sdl_create_buffers(running_machine &machine, int audio_latency)
 {
-	mame_printf_verbose("sdl_create_buffers: creating stream buffer of %u bytes\n", stream_buffer_size);
+	stream_ring.allocate(machine.sample_rate(), sdl_xfer_samples, audio_latency);
 
-	stream_buffer = global_alloc_array_clear(INT8, stream_buffer_size);
-	stream_playpos = 0;
-	buf_locked = 0;
+	mame_printf_verbose("sdl_create_buffers: creating stream buffer of %u bytes\n", stream_ring.size());
 	return 0;
 }
 
@@ -538,7 +285,5 @@ static int sdl_create_buffers(void)
 static void sdl_destroy_buffers(void)
 {
 	// release the buffer
-	if (stream_buffer)
-		global_free(stream_buffer);
-	stream_buffer = NULL;
+	stream_ring.release();
 }
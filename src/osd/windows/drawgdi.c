@@ -181,7 +181,7 @@ static int drawgdi_window_draw(win_window_info *window, HDC dc, int update)
 
 	// draw the primitives to the bitmap
 	window->primlist->acquire_lock();
-	software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(*window->primlist, gdi->bmdata, width, height, pitch);
+	software_renderer<UINT32, 0,0,0, 16,8,0>::draw_primitives(*window->primlist, gdi->bmdata, width, height, pitch, window->machine().render().work_queue());
 	window->primlist->release_lock();
 
 	// fill in bitmap-specific info
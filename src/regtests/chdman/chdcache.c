@@ -0,0 +1,166 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    CHD hunk cache regression test
+
+    Reads a CHD through the hunk cache with a variety of cache sizes,
+    read-ahead depths and access patterns, and checks every byte against
+    an uncached read of the same hunks.
+
+****************************************************************************/
+
+#include "osdcore.h"
+#include "chd.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// cache configurations to try, as (hunks, read-ahead) pairs; a size of
+// zero hunks lets the cache pick its own minimum
+static const UINT32 s_configs[][2] =
+{
+	{ 0, 0 },
+	{ 0, 1 },
+	{ 0, 4 },
+	{ 3, 0 },
+	{ 6, 4 },
+	{ 16, 8 },
+};
+
+// hunks to read in order, mixing short sequential runs with jumps; ~0
+// marks the end; only part of each hunk is read, since whole hunks
+// bypass the cache
+static const UINT32 s_jumps[] = { 0, 1, 50, 51, 2, 3, 52, 53, 54, 4, 100, 101, 102, 103, 104, 105, 106, 107, 5, 6, 7, 8, 9, 10, 11, 12, ~0U };
+
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  check_read - read a range through the cache
+//  and compare it against the reference data
+//-------------------------------------------------
+
+static bool check_read(chd_file &chd, const UINT8 *reference, UINT64 offset, UINT32 length, dynamic_buffer &buffer)
+{
+	buffer.resize(length);
+	chd_error err = chd.read_bytes(offset, buffer, length);
+	if (err != CHDERR_NONE)
+	{
+		fprintf(stderr, "read of %d bytes at offset %d failed: %s\n", length, (int)offset, chd_file::error_string(err));
+		return false;
+	}
+	if (memcmp(buffer, &reference[offset], length) != 0)
+	{
+		fprintf(stderr, "data mismatch reading %d bytes at offset %d\n", length, (int)offset);
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  run_patterns - read the file with one cache
+//  configuration
+//-------------------------------------------------
+
+static bool run_patterns(chd_file &chd, const UINT8 *reference, UINT32 hunks, UINT32 readahead)
+{
+	UINT32 hunkbytes = chd.hunk_bytes();
+	UINT32 hunkcount = chd.hunk_count();
+	UINT32 partoffs = hunkbytes / 4;
+	UINT32 partbytes = hunkbytes / 2;
+	dynamic_buffer buffer;
+	bool success = true;
+
+	chd.set_cache(hunks * hunkbytes, readahead);
+
+	// jumping back and forth between sequential runs
+	for (int index = 0; s_jumps[index] != ~0; index++)
+		if (s_jumps[index] < hunkcount)
+			success &= check_read(chd, reference, UINT64(s_jumps[index]) * hunkbytes + partoffs, partbytes, buffer);
+
+	// a straight sequential pass, in reads that straddle hunks
+	UINT32 stride = hunkbytes / 3 + 1;
+	for (UINT64 offset = 0; offset + stride <= UINT64(hunkcount) * hunkbytes; offset += stride)
+		success &= check_read(chd, reference, offset, stride, buffer);
+
+	// pseudo-random single hunks and short runs
+	UINT32 seed = 12345;
+	for (int iteration = 0; iteration < 1000; iteration++)
+	{
+		seed = seed * 1103515245 + 12345;
+		UINT32 hunknum = (seed >> 8) % hunkcount;
+		UINT32 run = 1 + ((seed >> 4) & 3);
+		for ( ; run > 0 && hunknum < hunkcount; run--, hunknum++)
+			success &= check_read(chd, reference, UINT64(hunknum) * hunkbytes + partoffs, partbytes, buffer);
+	}
+
+	if (!success)
+		fprintf(stderr, "failed with a %d hunk cache and %d hunks of read-ahead\n", hunks, readahead);
+	return success;
+}
+
+
+//-------------------------------------------------
+//  main - main entry point
+//-------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: chdcache <file.chd> [...]\n");
+		return 1;
+	}
+
+	bool success = true;
+	for (int argnum = 1; argnum < argc; argnum++)
+	{
+		chd_file chd;
+		chd_error err = chd.open(argv[argnum]);
+		if (err != CHDERR_NONE)
+		{
+			fprintf(stderr, "%s: unable to open: %s\n", argv[argnum], chd_file::error_string(err));
+			success = false;
+			continue;
+		}
+
+		// decode every hunk directly as the reference
+		UINT32 hunkbytes = chd.hunk_bytes();
+		UINT32 hunkcount = chd.hunk_count();
+		dynamic_buffer reference(UINT64(hunkcount) * hunkbytes);
+		for (UINT32 hunknum = 0; hunknum < hunkcount; hunknum++)
+		{
+			err = chd.read_hunk(hunknum, &reference[hunknum * hunkbytes]);
+			if (err != CHDERR_NONE)
+			{
+				fprintf(stderr, "%s: unable to read hunk %d: %s\n", argv[argnum], hunknum, chd_file::error_string(err));
+				success = false;
+				break;
+			}
+		}
+		if (err != CHDERR_NONE)
+			continue;
+
+		for (int confignum = 0; confignum < ARRAY_LENGTH(s_configs); confignum++)
+			if (!run_patterns(chd, reference, s_configs[confignum][0], s_configs[confignum][1]))
+			{
+				fprintf(stderr, "%s: cache test failed\n", argv[argnum]);
+				success = false;
+			}
+	}
+
+	if (success)
+		printf("All tests finished successfully\n");
+	return success ? 0 : 1;
+}
@@ -0,0 +1,372 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    drawgfx core regression test
+
+    Draws random sprites with every pixel op that drawgfx.c pairs with a
+    block skip test, once through the plain DRAWGFX_CORE and once through
+    DRAWGFX_CORE_SKIP, and checks that the destination and priority
+    bitmaps come out identical.
+
+****************************************************************************/
+
+#include "emu.h"
+#include "drawgfxm.h"
+#include <stdio.h>
+#include <string.h>
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// destination bitmap size, and the clip rectangle inside it
+static const int DEST_WIDTH = 64;
+static const int DEST_HEIGHT = 48;
+static const rectangle s_cliprect(3, 59, 2, 44);
+
+// sprites drawn per pixel op
+static const int DRAWS_PER_OP = 4000;
+
+// number of sprites in each test gfx set
+static const int TEST_ELEMENTS = 8;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// stands in for a gfx_element; the core only needs these accessors
+class test_gfx
+{
+public:
+	test_gfx(int width, int height)
+		: m_width(width),
+			m_height(height),
+			m_data(width * height * TEST_ELEMENTS) { }
+
+	int width() const { return m_width; }
+	int height() const { return m_height; }
+	int rowbytes() const { return m_width; }
+	UINT32 elements() const { return TEST_ELEMENTS; }
+	const UINT8 *get_data(UINT32 code) const { return &m_data[code * m_width * m_height]; }
+	UINT8 *raw_data() { return m_data; }
+
+private:
+	int             m_width;
+	int             m_height;
+	dynamic_buffer  m_data;
+};
+
+
+// everything a single draw needs
+struct draw_params
+{
+	bitmap_t *          dest;
+	bitmap_ind8 *       priority;
+	const test_gfx *    gfx;
+	UINT32              code;
+	int                 flipx, flipy;
+	INT32               destx, desty;
+	const pen_t *       paldata;
+	UINT32              transpen;
+	UINT32              transmask;
+	UINT32              color;
+	const UINT8 *       pentable;
+	const pen_t *       shadowtable;
+	UINT32              pmask;
+	UINT8               alpha;
+};
+
+
+typedef void (*draw_func)(draw_params &params);
+
+struct draw_op
+{
+	const char *    name;
+	bool            rgb32;
+	draw_func       old_core;
+	draw_func       new_core;
+};
+
+
+
+//**************************************************************************
+//  CORE INSTANCES
+//**************************************************************************
+
+namespace drawgfx_cores
+{
+
+// the cores start and stop the profiler; this shadows the emulator's
+struct test_profiler
+{
+	void start(profile_type type) { }
+	void stop() { }
+};
+static test_profiler g_profiler;
+
+
+// the locals the core and pixel op macros expect
+#define DRAW_LOCALS                                                                 \
+	bitmap_t &dest = *params.dest;                                                  \
+	bitmap_ind8 &priority = *params.priority;                                       \
+	const rectangle &cliprect = s_cliprect;                                         \
+	const test_gfx *gfx = params.gfx;                                               \
+	UINT32 code = params.code;                                                      \
+	int flipx = params.flipx, flipy = params.flipy;                                 \
+	INT32 destx = params.destx, desty = params.desty;                               \
+	const pen_t *paldata = params.paldata;                                          \
+	UINT32 transpen = params.transpen;                                              \
+	UINT32 transmask = params.transmask;                                            \
+	UINT32 color = params.color;                                                    \
+	const UINT8 *pentable = params.pentable;                                        \
+	const pen_t *shadowtable = params.shadowtable;                                  \
+	UINT32 pmask = params.pmask;                                                    \
+	UINT8 alpha = params.alpha;                                                     \
+	(void)paldata; (void)transpen; (void)transmask; (void)color; (void)pentable;    \
+	(void)shadowtable; (void)pmask; (void)alpha;
+
+// an old and a new instance of one pixel op
+#define DEFINE_CORES(NAME, PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, BLOCK_SKIP)         \
+static void NAME##_old(draw_params &params)                                         \
+{                                                                                   \
+	DRAW_LOCALS;                                                                    \
+	DRAWGFX_CORE(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE);                              \
+}                                                                                   \
+static void NAME##_new(draw_params &params)                                         \
+{                                                                                   \
+	DRAW_LOCALS;                                                                    \
+	DRAWGFX_CORE_SKIP(PIXEL_TYPE, PIXEL_OP, PRIORITY_TYPE, BLOCK_SKIP);             \
+}
+
+// these match the pairings in drawgfx.c
+DEFINE_CORES(transpen16,            UINT16, PIXEL_OP_REMAP_TRANSPEN,                    NO_PRIORITY, BLOCK_SKIP_TRANSPEN)
+DEFINE_CORES(transpen32,            UINT32, PIXEL_OP_REMAP_TRANSPEN,                    NO_PRIORITY, BLOCK_SKIP_TRANSPEN)
+DEFINE_CORES(transpen_raw16,        UINT16, PIXEL_OP_REBASE_TRANSPEN,                   NO_PRIORITY, BLOCK_SKIP_TRANSPEN)
+DEFINE_CORES(transpen_raw32,        UINT32, PIXEL_OP_REBASE_TRANSPEN,                   NO_PRIORITY, BLOCK_SKIP_TRANSPEN)
+DEFINE_CORES(transmask16,           UINT16, PIXEL_OP_REMAP_TRANSMASK,                   NO_PRIORITY, BLOCK_SKIP_TRANSMASK)
+DEFINE_CORES(transmask32,           UINT32, PIXEL_OP_REMAP_TRANSMASK,                   NO_PRIORITY, BLOCK_SKIP_TRANSMASK)
+DEFINE_CORES(transtable16,          UINT16, PIXEL_OP_REMAP_TRANSTABLE16,                NO_PRIORITY, BLOCK_SKIP_TRANSTABLE)
+DEFINE_CORES(transtable32,          UINT32, PIXEL_OP_REMAP_TRANSTABLE32,                NO_PRIORITY, BLOCK_SKIP_TRANSTABLE)
+DEFINE_CORES(alpha32,               UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32,            NO_PRIORITY, BLOCK_SKIP_TRANSPEN)
+DEFINE_CORES(ptranspen16,           UINT16, PIXEL_OP_REMAP_TRANSPEN_PRIORITY,           UINT8,       BLOCK_SKIP_TRANSPEN)
+DEFINE_CORES(ptranspen32,           UINT32, PIXEL_OP_REMAP_TRANSPEN_PRIORITY,           UINT8,       BLOCK_SKIP_TRANSPEN)
+DEFINE_CORES(ptranspen_raw16,       UINT16, PIXEL_OP_REBASE_TRANSPEN_PRIORITY,          UINT8,       BLOCK_SKIP_TRANSPEN)
+DEFINE_CORES(ptranspen_raw32,       UINT32, PIXEL_OP_REBASE_TRANSPEN_PRIORITY,          UINT8,       BLOCK_SKIP_TRANSPEN)
+DEFINE_CORES(ptransmask16,          UINT16, PIXEL_OP_REMAP_TRANSMASK_PRIORITY,          UINT8,       BLOCK_SKIP_TRANSMASK)
+DEFINE_CORES(ptransmask32,          UINT32, PIXEL_OP_REMAP_TRANSMASK_PRIORITY,          UINT8,       BLOCK_SKIP_TRANSMASK)
+DEFINE_CORES(ptranstable16,         UINT16, PIXEL_OP_REMAP_TRANSTABLE16_PRIORITY,       UINT8,       BLOCK_SKIP_TRANSTABLE)
+DEFINE_CORES(ptranstable32,         UINT32, PIXEL_OP_REMAP_TRANSTABLE32_PRIORITY,       UINT8,       BLOCK_SKIP_TRANSTABLE)
+DEFINE_CORES(palpha32,              UINT32, PIXEL_OP_REMAP_TRANSPEN_ALPHA32_PRIORITY,   UINT8,       BLOCK_SKIP_TRANSPEN)
+
+}
+
+#define CORE_ENTRY(NAME, RGB32) { #NAME, RGB32, drawgfx_cores::NAME##_old, drawgfx_cores::NAME##_new }
+
+static const draw_op s_ops[] =
+{
+	CORE_ENTRY(transpen16, false),
+	CORE_ENTRY(transpen32, true),
+	CORE_ENTRY(transpen_raw16, false),
+	CORE_ENTRY(transpen_raw32, true),
+	CORE_ENTRY(transmask16, false),
+	CORE_ENTRY(transmask32, true),
+	CORE_ENTRY(transtable16, false),
+	CORE_ENTRY(transtable32, true),
+	CORE_ENTRY(alpha32, true),
+	CORE_ENTRY(ptranspen16, false),
+	CORE_ENTRY(ptranspen32, true),
+	CORE_ENTRY(ptranspen_raw16, false),
+	CORE_ENTRY(ptranspen_raw32, true),
+	CORE_ENTRY(ptransmask16, false),
+	CORE_ENTRY(ptransmask32, true),
+	CORE_ENTRY(ptranstable16, false),
+	CORE_ENTRY(ptranstable32, true),
+	CORE_ENTRY(palpha32, true),
+};
+
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  random_value - return a pseudo-random 16-bit
+//  value
+//-------------------------------------------------
+
+static UINT32 s_seed = 12345;
+
+static UINT32 random_value()
+{
+	s_seed = s_seed * 1103515245 + 12345;
+	return s_seed >> 16;
+}
+
+
+//-------------------------------------------------
+//  fill_sprites - fill a gfx set with runs of
+//  transparent and opaque pens, so that whole
+//  blocks of 4 get skipped as well as drawn
+//-------------------------------------------------
+
+static void fill_sprites(test_gfx &gfx)
+{
+	UINT8 *data = gfx.raw_data();
+	int total = gfx.width() * gfx.height() * TEST_ELEMENTS;
+
+	for (int pixel = 0; pixel < total; )
+	{
+		UINT32 rnd = random_value();
+		int run = 1 + (rnd & 7);
+		bool clear = (rnd & 0x30) != 0;
+		for ( ; run > 0 && pixel < total; run--, pixel++)
+		{
+			// clear runs use both of the transparent pens; opaque ones any pen
+			UINT32 pen = random_value() & 15;
+			data[pixel] = clear ? ((pen & 1) ? 15 : 0) : pen;
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  fill_bitmap - fill a bitmap with random
+//  contents
+//-------------------------------------------------
+
+template<class _BitmapType>
+static void fill_bitmap(_BitmapType &bitmap, UINT32 mask)
+{
+	for (int y = 0; y < bitmap.height(); y++)
+		for (int x = 0; x < bitmap.width(); x++)
+			bitmap.pix(y, x) = ((random_value() << 16) | random_value()) & mask;
+}
+
+
+//-------------------------------------------------
+//  copy_bitmap - copy one bitmap to another of
+//  the same size
+//-------------------------------------------------
+
+template<class _BitmapType>
+static void copy_bitmap(_BitmapType &dest, _BitmapType &source)
+{
+	for (int y = 0; y < source.height(); y++)
+		memcpy(&dest.pix(y), &source.pix(y), source.width() * source.bpp() / 8);
+}
+
+
+//-------------------------------------------------
+//  bitmaps_equal - compare two bitmaps pixel by
+//  pixel
+//-------------------------------------------------
+
+template<class _BitmapType>
+static bool bitmaps_equal(_BitmapType &bitmap1, _BitmapType &bitmap2)
+{
+	for (int y = 0; y < bitmap1.height(); y++)
+		if (memcmp(&bitmap1.pix(y), &bitmap2.pix(y), bitmap1.width() * bitmap1.bpp() / 8) != 0)
+			return false;
+	return true;
+}
+
+
+//-------------------------------------------------
+//  run_op - draw random sprites through both
+//  cores of one pixel op and compare the results
+//-------------------------------------------------
+
+static bool run_op(const draw_op &op, test_gfx *const *gfxsets, int numsets, const pen_t *paldata, const UINT8 *pentable, const pen_t *shadowtable)
+{
+	bitmap_ind16 dest16_old(DEST_WIDTH, DEST_HEIGHT), dest16_new(DEST_WIDTH, DEST_HEIGHT);
+	bitmap_rgb32 dest32_old(DEST_WIDTH, DEST_HEIGHT), dest32_new(DEST_WIDTH, DEST_HEIGHT);
+	bitmap_ind8 pri_old(DEST_WIDTH, DEST_HEIGHT), pri_new(DEST_WIDTH, DEST_HEIGHT);
+
+	for (int drawnum = 0; drawnum < DRAWS_PER_OP; drawnum++)
+	{
+		// start both sides from the same random contents every so often
+		if (drawnum % 16 == 0)
+		{
+			fill_bitmap(dest16_old, 0xffff);
+			fill_bitmap(dest32_old, 0xffffff);
+			fill_bitmap(pri_old, 0x9f);
+			copy_bitmap(dest16_new, dest16_old);
+			copy_bitmap(dest32_new, dest32_old);
+			copy_bitmap(pri_new, pri_old);
+		}
+
+		// pick a sprite, a position that may be clipped on any side, and the op's parameters
+		draw_params params;
+		params.gfx = gfxsets[random_value() % numsets];
+		params.code = random_value() % TEST_ELEMENTS;
+		params.flipx = random_value() & 1;
+		params.flipy = random_value() & 1;
+		params.destx = INT32(random_value() % (DEST_WIDTH + params.gfx->width())) - params.gfx->width();
+		params.desty = INT32(random_value() % (DEST_HEIGHT + params.gfx->height())) - params.gfx->height();
+		params.paldata = paldata;
+		params.transpen = (random_value() & 1) ? 15 : 0;
+		params.transmask = 0x8001;
+		params.color = (random_value() & 0x3f) << 4;
+		params.pentable = pentable;
+		params.shadowtable = shadowtable;
+		params.pmask = random_value() | (1 << 31);
+		params.alpha = random_value();
+
+		// draw it both ways
+		params.priority = &pri_old;
+		params.dest = op.rgb32 ? static_cast<bitmap_t *>(&dest32_old) : static_cast<bitmap_t *>(&dest16_old);
+		(*op.old_core)(params);
+		params.priority = &pri_new;
+		params.dest = op.rgb32 ? static_cast<bitmap_t *>(&dest32_new) : static_cast<bitmap_t *>(&dest16_new);
+		(*op.new_core)(params);
+
+		// and compare
+		bool same = op.rgb32 ? bitmaps_equal(dest32_old, dest32_new) : bitmaps_equal(dest16_old, dest16_new);
+		if (!same || !bitmaps_equal(pri_old, pri_new))
+		{
+			fprintf(stderr, "%s: %s bitmap differs after drawing %dx%d sprite %d at (%d,%d), flip %d/%d\n", op.name, same ? "priority" : "destination",
+					params.gfx->width(), params.gfx->height(), params.code, params.destx, params.desty, params.flipx, params.flipy);
+			return false;
+		}
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  main - main entry point
+//-------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+	// sprite sets with widths that are and aren't multiples of the block size
+	test_gfx gfx16(16, 16), gfx13(13, 7), gfx32(32, 16), gfx3(3, 5);
+	test_gfx *gfxsets[] = { &gfx16, &gfx13, &gfx32, &gfx3 };
+	for (int setnum = 0; setnum < ARRAY_LENGTH(gfxsets); setnum++)
+		fill_sprites(*gfxsets[setnum]);
+
+	// palette, pen table and shadow table
+	dynamic_array<pen_t> paldata(16);
+	for (int pen = 0; pen < 16; pen++)
+		paldata[pen] = ((random_value() << 16) | random_value()) & 0xffffff;
+	UINT8 pentable[16];
+	for (int pen = 0; pen < 16; pen++)
+		pentable[pen] = (pen == 0 || pen == 15) ? DRAWMODE_NONE : (pen >= 12) ? DRAWMODE_SHADOW : DRAWMODE_SOURCE;
+	dynamic_array<pen_t> shadowtable(65536);
+	for (int index = 0; index < 65536; index++)
+		shadowtable[index] = index ^ 0x5555;
+
+	bool success = true;
+	for (int opnum = 0; opnum < ARRAY_LENGTH(s_ops); opnum++)
+		success &= run_op(s_ops[opnum], gfxsets, ARRAY_LENGTH(gfxsets), paldata, pentable, shadowtable);
+
+	if (success)
+		printf("All tests finished successfully\n");
+	return success ? 0 : 1;
+}
@@ -0,0 +1,317 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    software renderer banding regression test
+
+    Draws random scenes of lines, rectangles and textured quads with the
+    software renderer, once in a single pass and once split into bands
+    on a work queue, and checks that the two targets come out identical.
+    Scenes cover every texture format and blend mode the renderer
+    handles, flipped and swapped texture coordinates, and primitives
+    that straddle band edges or hang off the target. Several pixel
+    formats and target heights are tried, so the bands fall at
+    different rows.
+
+****************************************************************************/
+
+#include "emu.h"
+#include "rendersw.c"
+#include <stdio.h>
+#include <string.h>
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// scenes drawn per target, and primitives in each scene
+static const int SCENES_PER_TARGET = 25;
+static const int PRIMS_PER_SCENE = 40;
+
+// largest texture dimension; textures are random sizes up to this
+static const int MAX_TEXTURE_SIZE = 96;
+
+// greatest stretch of a texture across a quad; beyond this the rounded U/V
+// steps can walk off the edge of the texture, in bands or not
+static const int MAX_MAGNIFICATION = 16;
+
+// how far primitives may hang off the edges of the target
+static const float OVERHANG = 24.0f;
+
+// palette size; big enough for any 16-bit texel or LUT index
+static const int PALETTE_ENTRIES = 65536;
+
+// target sizes; the heights give 2, 3, 7 and 8 bands, evenly and unevenly split
+struct target_size
+{
+	UINT32          width;
+	UINT32          height;
+	UINT32          pitch;
+};
+
+static const target_size s_targets[] =
+{
+	{ 320, 128, 320 },
+	{ 256, 200, 264 },
+	{ 640, 480, 640 },
+	{ 400, 600, 411 },
+	{ 97, 1000, 100 },
+};
+
+// texture format and blend mode combinations the quad rasterizers handle
+static const UINT8 s_quadmodes[][2] =
+{
+	{ TEXFORMAT_PALETTE16,  BLENDMODE_NONE },
+	{ TEXFORMAT_PALETTE16,  BLENDMODE_ALPHA },
+	{ TEXFORMAT_PALETTE16,  BLENDMODE_ADD },
+	{ TEXFORMAT_PALETTEA16, BLENDMODE_ALPHA },
+	{ TEXFORMAT_YUY16,      BLENDMODE_NONE },
+	{ TEXFORMAT_RGB32,      BLENDMODE_NONE },
+	{ TEXFORMAT_RGB32,      BLENDMODE_ALPHA },
+	{ TEXFORMAT_RGB32,      BLENDMODE_ADD },
+	{ TEXFORMAT_ARGB32,     BLENDMODE_NONE },
+	{ TEXFORMAT_ARGB32,     BLENDMODE_ALPHA },
+	{ TEXFORMAT_ARGB32,     BLENDMODE_RGB_MULTIPLY },
+	{ TEXFORMAT_ARGB32,     BLENDMODE_ADD },
+};
+
+
+
+//**************************************************************************
+//  RENDERER INSTANCES
+//**************************************************************************
+
+typedef software_renderer<UINT32, 0,0,0, 16,8,0> renderer_rgb32;
+typedef software_renderer<UINT32, 0,0,0, 16,8,0, true> renderer_rgb32_nodestread;
+typedef software_renderer<UINT32, 0,0,0, 16,8,0, false, true> renderer_rgb32_bilinear;
+typedef software_renderer<UINT16, 3,2,3, 11,5,0> renderer_rgb565;
+
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  random_value - return a pseudo-random 16-bit
+//  value
+//-------------------------------------------------
+
+static UINT32 s_seed = 12345;
+
+static UINT32 random_value()
+{
+	s_seed = s_seed * 1103515245 + 12345;
+	return s_seed >> 16;
+}
+
+
+//-------------------------------------------------
+//  random_float - return a pseudo-random value
+//  between minval and maxval
+//-------------------------------------------------
+
+static float random_float(float minval, float maxval)
+{
+	return minval + (maxval - minval) * float(random_value()) / 65535.0f;
+}
+
+
+//-------------------------------------------------
+//  random_color - pick a primitive color; some
+//  are plain white and opaque, to hit the fast
+//  paths
+//-------------------------------------------------
+
+static void random_color(render_color &color)
+{
+	if (random_value() % 4 == 0)
+		color.a = color.r = color.g = color.b = 1.0f;
+	else
+	{
+		color.a = (random_value() % 3 == 0) ? 1.0f : random_float(0.0f, 1.0f);
+		color.r = random_float(0.0f, 1.0f);
+		color.g = random_float(0.0f, 1.0f);
+		color.b = random_float(0.0f, 1.0f);
+	}
+}
+
+
+//-------------------------------------------------
+//  random_bounds - pick an area at least a pixel
+//  in each direction, possibly hanging off the
+//  target; whole pixel areas keep the texture
+//  lookups of textured quads inside the texture,
+//  as the render core does
+//-------------------------------------------------
+
+static void random_bounds(render_bounds &bounds, const target_size &target, bool whole)
+{
+	bounds.x0 = random_float(-OVERHANG, target.width + OVERHANG);
+	bounds.y0 = random_float(-OVERHANG, target.height + OVERHANG);
+	bounds.x1 = bounds.x0 + random_float(1.0f, target.width / 2);
+	bounds.y1 = bounds.y0 + random_float(1.0f, target.height / 2);
+	if (whole)
+	{
+		bounds.x0 = floor(bounds.x0);
+		bounds.y0 = floor(bounds.y0);
+		bounds.x1 = floor(bounds.x1);
+		bounds.y1 = floor(bounds.y1);
+	}
+}
+
+
+//-------------------------------------------------
+//  build_scene - fill a list with random
+//  primitives, with their textures drawn from
+//  texels
+//-------------------------------------------------
+
+static void build_scene(simple_list<render_primitive> &scene, const target_size &target, UINT32 *texels, const rgb_t *palette)
+{
+	for (int primnum = 0; primnum < PRIMS_PER_SCENE; primnum++)
+	{
+		render_primitive *prim = global_alloc(render_primitive);
+		prim->reset();
+		random_color(prim->color);
+
+		switch (random_value() % 4)
+		{
+			// lines, plain or anti-aliased and at any angle
+			case 0:
+				prim->type = render_primitive::LINE;
+				prim->bounds.x0 = random_float(-OVERHANG, target.width + OVERHANG);
+				prim->bounds.y0 = random_float(-OVERHANG, target.height + OVERHANG);
+				prim->bounds.x1 = random_float(-OVERHANG, target.width + OVERHANG);
+				prim->bounds.y1 = random_float(-OVERHANG, target.height + OVERHANG);
+				prim->width = random_float(1.0f, 4.0f);
+				prim->flags = PRIMFLAG_BLENDMODE(BLENDMODE_ALPHA) | PRIMFLAG_ANTIALIAS(random_value() % 2);
+				break;
+
+			// untextured rectangles
+			case 1:
+				prim->type = render_primitive::QUAD;
+				random_bounds(prim->bounds, target, false);
+				prim->flags = PRIMFLAG_BLENDMODE((random_value() % 2) ? BLENDMODE_ALPHA : BLENDMODE_NONE);
+				break;
+
+			// textured quads
+			default:
+			{
+				const UINT8 *mode = s_quadmodes[random_value() % ARRAY_LENGTH(s_quadmodes)];
+				prim->type = render_primitive::QUAD;
+				random_bounds(prim->bounds, target, true);
+				prim->flags = PRIMFLAG_TEXFORMAT(mode[0]) | PRIMFLAG_BLENDMODE(mode[1]);
+
+				// a random-sized texture over this primitive's share of the texels;
+				// YUY16 pixels come in pairs
+				render_texinfo &texture = prim->texture;
+				UINT32 minsize = UINT32(MAX(prim->bounds.width(), prim->bounds.height())) / MAX_MAGNIFICATION + 1;
+				texture.base = &texels[primnum * MAX_TEXTURE_SIZE * MAX_TEXTURE_SIZE];
+				texture.width = minsize + random_value() % (MAX_TEXTURE_SIZE + 1 - minsize);
+				if (mode[0] == TEXFORMAT_YUY16)
+					texture.width = MIN(texture.width + 1, UINT32(MAX_TEXTURE_SIZE)) & ~1;
+				texture.height = minsize + random_value() % (MAX_TEXTURE_SIZE + 1 - minsize);
+				texture.rowpixels = texture.width + random_value() % (MAX_TEXTURE_SIZE + 1 - texture.width);
+				if (mode[0] == TEXFORMAT_YUY16)
+					texture.rowpixels &= ~1;
+				texture.palette = (mode[0] == TEXFORMAT_PALETTE16 || mode[0] == TEXFORMAT_PALETTEA16 || random_value() % 2) ? palette : NULL;
+
+				// corners of the texture in some orientation
+				bool flipx = random_value() % 2, flipy = random_value() % 2, swapxy = random_value() % 2;
+				render_texuv *corner[4] = { &prim->texcoords.tl, &prim->texcoords.tr, &prim->texcoords.bl, &prim->texcoords.br };
+				for (int cornum = 0; cornum < 4; cornum++)
+				{
+					float u = (cornum & 1) ? 1.0f : 0.0f;
+					float v = (cornum & 2) ? 1.0f : 0.0f;
+					if (swapxy)
+					{
+						float temp = u;
+						u = v;
+						v = temp;
+					}
+					corner[cornum]->u = flipx ? 1.0f - u : u;
+					corner[cornum]->v = flipy ? 1.0f - v : v;
+				}
+				break;
+			}
+		}
+		scene.append(*prim);
+	}
+}
+
+
+//-------------------------------------------------
+//  check_renderer - draw random scenes with one
+//  renderer in a single pass and in bands, and
+//  compare the targets
+//-------------------------------------------------
+
+template<class _Renderer, typename _PixelType>
+static bool check_renderer(const char *name, osd_work_queue *queue, UINT32 *texels, const rgb_t *palette)
+{
+	for (int targnum = 0; targnum < ARRAY_LENGTH(s_targets); targnum++)
+	{
+		const target_size &target = s_targets[targnum];
+		dynamic_array<_PixelType> single(target.pitch * target.height), banded(target.pitch * target.height);
+
+		for (int scenenum = 0; scenenum < SCENES_PER_TARGET; scenenum++)
+		{
+			simple_list<render_primitive> scene;
+			build_scene(scene, target, texels, palette);
+
+			// start both from the same garbage, padding included
+			for (int pixnum = 0; pixnum < single.count(); pixnum++)
+				single[pixnum] = banded[pixnum] = (random_value() << 16) | random_value();
+
+			_Renderer::draw_primitives(scene.first(), single, target.width, target.height, target.pitch, NULL);
+			_Renderer::draw_primitives(scene.first(), banded, target.width, target.height, target.pitch, queue);
+
+			for (int pixnum = 0; pixnum < single.count(); pixnum++)
+				if (single[pixnum] != banded[pixnum])
+				{
+					fprintf(stderr, "%s, %dx%d target, scene %d: pixel (%d,%d) is %08X in bands, %08X in a single pass\n",
+							name, target.width, target.height, scenenum, pixnum % target.pitch, pixnum / target.pitch, UINT32(banded[pixnum]), UINT32(single[pixnum]));
+					return false;
+				}
+		}
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  main - main entry point
+//-------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+	if (queue == NULL)
+	{
+		fprintf(stderr, "Unable to allocate a work queue\n");
+		return 1;
+	}
+
+	// texel and palette values fill every bit, including alpha
+	dynamic_array<UINT32> texels(PRIMS_PER_SCENE * MAX_TEXTURE_SIZE * MAX_TEXTURE_SIZE);
+	for (int texnum = 0; texnum < texels.count(); texnum++)
+		texels[texnum] = (random_value() << 16) | random_value();
+	dynamic_array<rgb_t> palette(PALETTE_ENTRIES);
+	for (int entry = 0; entry < PALETTE_ENTRIES; entry++)
+		palette[entry] = (random_value() << 16) | random_value();
+
+	bool success = true;
+	success &= check_renderer<renderer_rgb32, UINT32>("rgb32", queue, texels, palette);
+	success &= check_renderer<renderer_rgb32_nodestread, UINT32>("rgb32 no dest read", queue, texels, palette);
+	success &= check_renderer<renderer_rgb32_bilinear, UINT32>("rgb32 bilinear", queue, texels, palette);
+	success &= check_renderer<renderer_rgb565, UINT16>("rgb565", queue, texels, palette);
+
+	osd_work_queue_free(queue);
+
+	if (success)
+		printf("All tests finished successfully\n");
+	return success ? 0 : 1;
+}
@@ -0,0 +1,495 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    Sound stream resampler regression test
+
+    Drives sound_stream's resampling kernels directly. The sinc kernel
+    must pass DC with a gain of 1 at every phase, keep a passband tone at
+    its level, and attenuate tones that would otherwise alias into the
+    output band. With -sinc_resample off, streams go through the linear
+    kernel, and that must match the resampler MAME has always had bit for
+    bit; a copy of that original code is kept here as the reference.
+
+****************************************************************************/
+
+#include "emu.h"
+#include <stdio.h>
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// output samples generated per measurement
+static const int OUTPUT_SAMPLES = 4800;
+
+// levels; tones are measured relative to their input amplitude
+static const int DC_LEVEL = 20000;
+static const double TONE_AMPLITUDE = 16000.0;
+
+// limits; rounding to the nearest of 128 phases caps how clean a tone can stay
+static const double MAX_PASSBAND_ERROR_DB = 0.2;
+static const double MIN_PASSBAND_SNR_DB = 50.0;
+static const double MIN_STOPBAND_ATTENUATION_DB = 60.0;
+
+// the linear kernel comparison
+static const int LINEAR_RUNS = 2000;
+static const int LINEAR_MAX_SAMPLES = 1000;
+
+// FRAC_ONE as a double, for working out positions
+static const double FRAC_SCALE = double(sound_stream::FRAC_ONE);
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// an input/output rate pair
+struct rate_pair
+{
+	UINT32          inrate;
+	UINT32          outrate;
+};
+
+
+// a simple linear congruential generator, so runs are repeatable
+class test_random
+{
+public:
+	test_random(UINT32 seed) : m_state(seed) { }
+
+	UINT32 next() { m_state = m_state * 1103515245 + 12345; return m_state >> 8; }
+	UINT32 next(UINT32 limit) { return next() % limit; }
+
+private:
+	UINT32          m_state;
+};
+
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+// rate pairs covering upsampling, downsampling and near-unity ratios
+static const rate_pair s_rates[] =
+{
+	{  8000, 48000 },
+	{ 22050, 48000 },
+	{ 44100, 48000 },
+	{ 48000, 44100 },
+	{ 48000, 22050 },
+	{ 96000, 48000 },
+	{ 48000,  8000 }
+};
+
+
+
+//**************************************************************************
+//  REFERENCE IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  reference_linear - the linear resampler as it
+//  stood in sound_stream::generate_resampled_data
+//  before the sinc resampler was added
+//-------------------------------------------------
+
+static void reference_linear(stream_sample_t *dest, const stream_sample_t *source, UINT32 basefrac, UINT32 step, int gain, UINT32 numsamples)
+{
+	const UINT32 FRAC_BITS = 22;
+	const UINT32 FRAC_ONE = 1 << FRAC_BITS;
+	const UINT32 FRAC_MASK = FRAC_ONE - 1;
+
+	// if we have equal sample rates, we just need to copy
+	if (step == FRAC_ONE)
+	{
+		while (numsamples--)
+		{
+			// compute the sample
+			stream_sample_t sample = *source++;
+			*dest++ = (sample * gain) >> 8;
+		}
+	}
+
+	// input is undersampled: point sample except where our sample period covers a boundary
+	else if (step < FRAC_ONE)
+	{
+		while (numsamples != 0)
+		{
+			// fill in with point samples until we hit a boundary
+			int nextfrac;
+			while ((nextfrac = basefrac + step) < FRAC_ONE && numsamples--)
+			{
+				*dest++ = (source[0] * gain) >> 8;
+				basefrac = nextfrac;
+			}
+
+			// if we're done, we're done
+			if (INT32(numsamples--) < 0)
+				break;
+
+			// compute starting and ending fractional positions
+			int startfrac = basefrac >> (FRAC_BITS - 12);
+			int endfrac = nextfrac >> (FRAC_BITS - 12);
+
+			// blend between the two samples accordingly
+			stream_sample_t sample = (source[0] * (0x1000 - startfrac) + source[1] * (endfrac - 0x1000)) / (endfrac - startfrac);
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac = nextfrac & FRAC_MASK;
+			source++;
+		}
+	}
+
+	// input is oversampled: sum the energy
+	else
+	{
+		// use 8 bits to allow some extra headroom
+		int smallstep = step >> (FRAC_BITS - 8);
+		while (numsamples--)
+		{
+			int remainder = smallstep;
+			int tpos = 0;
+
+			// compute the sample
+			int scale = (FRAC_ONE - basefrac) >> (FRAC_BITS - 8);
+			stream_sample_t sample = source[tpos++] * scale;
+			remainder -= scale;
+			while (remainder > 0x100)
+			{
+				sample += source[tpos++] * 0x100;
+				remainder -= 0x100;
+			}
+			sample += source[tpos] * remainder;
+			sample /= smallstep;
+
+			*dest++ = (sample * gain) >> 8;
+
+			// advance
+			basefrac += step;
+			source += basefrac >> FRAC_BITS;
+			basefrac &= FRAC_MASK;
+		}
+	}
+}
+
+
+
+//**************************************************************************
+//  HELPERS
+//**************************************************************************
+
+//-------------------------------------------------
+//  rate_step - return the stepping fraction for
+//  a rate pair, as sound_stream computes it
+//-------------------------------------------------
+
+static UINT32 rate_step(const rate_pair &rates)
+{
+	return (UINT64(rates.inrate) << sound_stream::FRAC_BITS) / rates.outrate;
+}
+
+
+//-------------------------------------------------
+//  source_length - return how many source
+//  samples a run needs, with room for the filter
+//  either side
+//-------------------------------------------------
+
+static int source_length(const sound_stream::resample_filter &filter, UINT32 basefrac, UINT32 step, int numsamples)
+{
+	return int((basefrac + UINT64(numsamples) * step) >> sound_stream::FRAC_BITS) + filter.m_taps + 2;
+}
+
+
+//-------------------------------------------------
+//  run_sinc - resample a source through the sinc
+//  kernel; the source starts half a filter width
+//  before the first sample used
+//-------------------------------------------------
+
+static void run_sinc(const sound_stream::resample_filter &filter, dynamic_array<stream_sample_t> &dest, const dynamic_array<stream_sample_t> &source, UINT32 basefrac, UINT32 step)
+{
+	dest.resize(OUTPUT_SAMPLES);
+	sound_stream::resample_sinc(filter, dest, &source[filter.m_taps / 2], basefrac, step, 0x100, OUTPUT_SAMPLES);
+}
+
+
+//-------------------------------------------------
+//  to_db - convert an amplitude ratio to decibels
+//-------------------------------------------------
+
+static double to_db(double ratio)
+{
+	return 20.0 * log10(MAX(ratio, 1e-12));
+}
+
+
+//-------------------------------------------------
+//  measure_tone - resample a tone at the given
+//  frequency and fit a sine of that frequency to
+//  the output; returns the gain of the fitted
+//  tone and the level of what is left, both
+//  relative to the input amplitude
+//-------------------------------------------------
+
+static void measure_tone(const rate_pair &rates, double frequency, bool sinc, double &gain, double &residual)
+{
+	sound_stream::resample_filter filter(rates.inrate, rates.outrate);
+	UINT32 step = rate_step(rates);
+	UINT32 basefrac = sound_stream::FRAC_ONE / 3;
+
+	// the source sample at index filter.m_taps / 2 is time zero
+	int length = source_length(filter, basefrac, step, OUTPUT_SAMPLES);
+	dynamic_array<stream_sample_t> source(length);
+	for (int index = 0; index < length; index++)
+		source[index] = stream_sample_t(floor(TONE_AMPLITUDE * sin(2.0 * M_PI * frequency * (index - filter.m_taps / 2) / rates.inrate) + 0.5));
+
+	dynamic_array<stream_sample_t> dest;
+	if (sinc)
+		run_sinc(filter, dest, source, basefrac, step);
+	else
+	{
+		dest.resize(OUTPUT_SAMPLES);
+		sound_stream::resample_linear(dest, &source[filter.m_taps / 2], basefrac, step, 0x100, OUTPUT_SAMPLES);
+	}
+
+	// least-squares fit of a * cos + b * sin at the times each output sample was taken from
+	double cc = 0, cs = 0, ss = 0, yc = 0, ys = 0, yy = 0;
+	for (int index = 0; index < OUTPUT_SAMPLES; index++)
+	{
+		double position = (basefrac + double(index) * step) / FRAC_SCALE;
+		double c = cos(2.0 * M_PI * frequency * position / rates.inrate);
+		double s = sin(2.0 * M_PI * frequency * position / rates.inrate);
+		double y = dest[index];
+		cc += c * c;
+		cs += c * s;
+		ss += s * s;
+		yc += y * c;
+		ys += y * s;
+		yy += y * y;
+	}
+
+	// a tone above the output's Nyquist frequency can't be represented; all of it is leakage
+	double a = 0, b = 0;
+	if (2.0 * frequency < rates.outrate)
+	{
+		double det = cc * ss - cs * cs;
+		a = (yc * ss - ys * cs) / det;
+		b = (ys * cc - yc * cs) / det;
+	}
+
+	double leftover = 0;
+	for (int index = 0; index < OUTPUT_SAMPLES; index++)
+	{
+		double position = (basefrac + double(index) * step) / FRAC_SCALE;
+		double fit = a * cos(2.0 * M_PI * frequency * position / rates.inrate) + b * sin(2.0 * M_PI * frequency * position / rates.inrate);
+		leftover += (dest[index] - fit) * (dest[index] - fit);
+	}
+
+	// compare RMS levels against the input's
+	gain = sqrt(a * a + b * b) / TONE_AMPLITUDE;
+	residual = sqrt(2.0 * leftover / OUTPUT_SAMPLES) / TONE_AMPLITUDE;
+}
+
+
+
+//**************************************************************************
+//  TESTS
+//**************************************************************************
+
+//-------------------------------------------------
+//  test_dc_gain - a constant source must come
+//  through every phase of every filter unchanged
+//-------------------------------------------------
+
+static bool test_dc_gain()
+{
+	bool success = true;
+	for (int ratenum = 0; ratenum < ARRAY_LENGTH(s_rates); ratenum++)
+	{
+		const rate_pair &rates = s_rates[ratenum];
+		sound_stream::resample_filter filter(rates.inrate, rates.outrate);
+
+		// each phase's coefficients should sum to one
+		double worst = 0;
+		for (int phasenum = 0; phasenum <= sound_stream::SINC_PHASES; phasenum++)
+		{
+			const float *coeff = filter.phase(phasenum);
+			double total = 0;
+			for (int tap = 0; tap < filter.m_taps; tap++)
+				total += coeff[tap];
+			worst = MAX(worst, fabs(total - 1.0));
+		}
+
+		// and a DC source should come out at the same level, at every starting phase
+		UINT32 step = rate_step(rates);
+		int errors = 0;
+		for (UINT32 basefrac = 0; basefrac < sound_stream::FRAC_ONE; basefrac += sound_stream::FRAC_ONE / 16 + 1)
+		{
+			int length = source_length(filter, basefrac, step, OUTPUT_SAMPLES);
+			dynamic_array<stream_sample_t> source(length);
+			for (int index = 0; index < length; index++)
+				source[index] = DC_LEVEL;
+
+			dynamic_array<stream_sample_t> dest;
+			run_sinc(filter, dest, source, basefrac, step);
+			for (int index = 0; index < OUTPUT_SAMPLES; index++)
+				if (abs(dest[index] - DC_LEVEL) > 1 && errors++ < 5)
+					fprintf(stderr, "%d -> %d Hz: DC of %d came out as %d at sample %d\n", rates.inrate, rates.outrate, DC_LEVEL, dest[index], index);
+		}
+
+		printf("DC gain %6d -> %5d Hz: %3d taps, worst phase sum error %.2g\n", rates.inrate, rates.outrate, filter.m_taps, worst);
+		if (worst > 1e-5)
+		{
+			fprintf(stderr, "%d -> %d Hz: filter phases don't sum to one\n", rates.inrate, rates.outrate);
+			success = false;
+		}
+		if (errors != 0)
+			success = false;
+	}
+	return success;
+}
+
+
+//-------------------------------------------------
+//  test_passband - a tone well inside both bands
+//  must keep its level and come out clean
+//-------------------------------------------------
+
+static bool test_passband()
+{
+	bool success = true;
+	for (int ratenum = 0; ratenum < ARRAY_LENGTH(s_rates); ratenum++)
+	{
+		const rate_pair &rates = s_rates[ratenum];
+		double frequency = 0.25 * MIN(rates.inrate, rates.outrate) / 2;
+		double gain, residual;
+		measure_tone(rates, frequency, true, gain, residual);
+
+		printf("passband %6d -> %5d Hz: %7.1f Hz tone at %+.3f dB, residual %.1f dB\n", rates.inrate, rates.outrate, frequency, to_db(gain), to_db(residual));
+		if (fabs(to_db(gain)) > MAX_PASSBAND_ERROR_DB || -to_db(residual) < MIN_PASSBAND_SNR_DB)
+		{
+			fprintf(stderr, "%d -> %d Hz: passband tone was not preserved\n", rates.inrate, rates.outrate);
+			success = false;
+		}
+	}
+	return success;
+}
+
+
+//-------------------------------------------------
+//  test_stopband - tones between the output and
+//  input Nyquist frequencies must be attenuated
+//  rather than aliased
+//-------------------------------------------------
+
+static bool test_stopband()
+{
+	bool success = true;
+	for (int ratenum = 0; ratenum < ARRAY_LENGTH(s_rates); ratenum++)
+	{
+		const rate_pair &rates = s_rates[ratenum];
+		if (rates.outrate >= rates.inrate)
+			continue;
+
+		// the Blackman window's transition band is about 4 / taps of the input rate wide;
+		// close to unity there's no stopband left below the input's Nyquist frequency
+		sound_stream::resample_filter filter(rates.inrate, rates.outrate);
+		double cutoff = 0.9 * rates.outrate / 2;
+		double stopband = cutoff + 4.0 * rates.inrate / filter.m_taps;
+		if (stopband >= 0.48 * rates.inrate)
+		{
+			printf("stopband %6d -> %5d Hz: skipped, the transition band reaches the input's Nyquist frequency\n", rates.inrate, rates.outrate);
+			continue;
+		}
+		double worst = 0, worstlinear = 0;
+		for (double frequency = stopband; frequency < 0.48 * rates.inrate; frequency += (0.48 * rates.inrate - stopband) / 8)
+		{
+			double gain, residual;
+			measure_tone(rates, frequency, true, gain, residual);
+			worst = MAX(worst, residual);
+			measure_tone(rates, frequency, false, gain, residual);
+			worstlinear = MAX(worstlinear, residual);
+		}
+
+		printf("stopband %6d -> %5d Hz: above %7.1f Hz, worst leakage %.1f dB (linear %.1f dB)\n", rates.inrate, rates.outrate, stopband, to_db(worst), to_db(worstlinear));
+		if (-to_db(worst) < MIN_STOPBAND_ATTENUATION_DB)
+		{
+			fprintf(stderr, "%d -> %d Hz: stopband attenuation is under %.0f dB\n", rates.inrate, rates.outrate, MIN_STOPBAND_ATTENUATION_DB);
+			success = false;
+		}
+	}
+	return success;
+}
+
+
+//-------------------------------------------------
+//  test_linear - the linear kernel must match the
+//  original code exactly for random data, rates,
+//  phases and gains
+//-------------------------------------------------
+
+static bool test_linear()
+{
+	static const int s_gains[] = { 0x100, 0x80, 0x1c0, 0x33 };
+
+	test_random random(0x5eed5678);
+	dynamic_array<stream_sample_t> source;
+	dynamic_array<stream_sample_t> expected(LINEAR_MAX_SAMPLES);
+	dynamic_array<stream_sample_t> actual(LINEAR_MAX_SAMPLES);
+	int failures = 0;
+
+	for (int runnum = 0; runnum < LINEAR_RUNS; runnum++)
+	{
+		// mix the standard rates with equal ones and arbitrary ones
+		rate_pair rates = s_rates[random.next(ARRAY_LENGTH(s_rates))];
+		if (runnum % 4 == 1)
+			rates.outrate = rates.inrate;
+		else if (runnum % 4 == 2)
+		{
+			rates.inrate = 4000 + random.next(92000);
+			rates.outrate = 4000 + random.next(92000);
+		}
+		UINT32 step = rate_step(rates);
+		UINT32 basefrac = random.next(sound_stream::FRAC_ONE);
+		int gain = s_gains[random.next(ARRAY_LENGTH(s_gains))];
+		int numsamples = 1 + random.next(LINEAR_MAX_SAMPLES);
+
+		// full-scale 16-bit samples, which is what the kernels mostly see
+		int length = int((basefrac + UINT64(numsamples) * step) >> sound_stream::FRAC_BITS) + 2;
+		source.resize(length);
+		for (int index = 0; index < length; index++)
+			source[index] = stream_sample_t(random.next(0x10000)) - 0x8000;
+
+		reference_linear(expected, source, basefrac, step, gain, numsamples);
+		sound_stream::resample_linear(actual, source, basefrac, step, gain, numsamples);
+		if (memcmp(expected, actual, numsamples * sizeof(stream_sample_t)) != 0 && failures++ < 5)
+			fprintf(stderr, "linear %d -> %d Hz, fraction %06X, gain %03X, %d samples: output differs from the original\n", rates.inrate, rates.outrate, basefrac, gain, numsamples);
+	}
+
+	printf("linear: %d runs compared against the original resampler\n", LINEAR_RUNS);
+	return (failures == 0);
+}
+
+
+//-------------------------------------------------
+//  main - run all the tests
+//-------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+	bool success = test_dc_gain();
+	success = test_passband() && success;
+	success = test_stopband() && success;
+	success = test_linear() && success;
+
+	if (success)
+		printf("All tests finished successfully\n");
+	return success ? 0 : 1;
+}
@@ -0,0 +1,336 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    chunked save state regression test
+
+    Writes a set of named entries through chunked_state the way
+    save_manager::write_file does, reads the file back and checks every
+    entry, then damages copies of the file one field at a time and makes
+    sure each is rejected rather than loaded.
+
+****************************************************************************/
+
+#include "emu.h"
+#include "savechunk.h"
+#include <stdio.h>
+#include <string.h>
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// room left in front of the chunked data, as for the save state header
+static const int HEADER_SIZE = 32;
+static const int DIRECTORY_SIZE = 12;
+static const int CHUNK_ENTRY_SIZE = 12;
+
+// the entries, in name order; together they span a few chunks, and the big
+// ones straddle chunk boundaries
+struct test_entry
+{
+	const char *    m_name;
+	UINT32          m_size;
+};
+
+static const test_entry s_entries[] =
+{
+	{ "cpu/maincpu/0/m_a",      1 },
+	{ "cpu/maincpu/0/m_pc",     4 },
+	{ "cpu/maincpu/0/m_ram",    300000 },
+	{ "global/0/m_empty",       0 },
+	{ "memory/0/:bank1",        262144 },
+	{ "screen/0/m_bitmap",      400000 },
+	{ "sound/0/m_regs",         77 }
+};
+static const int ENTRY_COUNT = ARRAY_LENGTH(s_entries);
+
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  fill_entries - lay out the entries end-to-end
+//  and fill them with a mix of repetitive and
+//  random data
+//-------------------------------------------------
+
+static void fill_entries(dynamic_buffer &data, UINT32 *offsets)
+{
+	UINT32 total = 0;
+	for (int entrynum = 0; entrynum < ENTRY_COUNT; entrynum++)
+	{
+		offsets[entrynum] = total;
+		total += s_entries[entrynum].m_size;
+	}
+
+	data.resize(total);
+	UINT32 seed = 0x2468ace1;
+	for (UINT32 byte = 0; byte < total; byte++)
+	{
+		seed = seed * 1103515245 + 12345;
+		data[byte] = ((byte / 1000) & 1) ? (seed >> 16) : (byte >> 6);
+	}
+}
+
+
+//-------------------------------------------------
+//  write_state - write the entries to a file
+//-------------------------------------------------
+
+static bool write_state(const char *filename, const dynamic_buffer &data, const UINT32 *offsets)
+{
+	chunked_state state;
+	if (!state.allocate(data.count()))
+	{
+		fprintf(stderr, "unable to allocate %d bytes\n", data.count());
+		return false;
+	}
+	if (data.count() > 0)
+		memcpy(state.data(0), &data[0], data.count());
+	for (int entrynum = 0; entrynum < ENTRY_COUNT; entrynum++)
+		if (offsets[entrynum] != ~0)
+			state.add_entry(s_entries[entrynum].m_name, offsets[entrynum], s_entries[entrynum].m_size);
+
+	core_file *file;
+	if (core_fopen(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, &file) != FILERR_NONE)
+	{
+		fprintf(stderr, "unable to create %s\n", filename);
+		return false;
+	}
+	UINT8 header[HEADER_SIZE] = { 0 };
+	save_error err = STATERR_WRITE_ERROR;
+	if (core_fwrite(file, header, sizeof(header)) == sizeof(header))
+		err = state.write(*file);
+	core_fclose(file);
+	if (err != STATERR_NONE)
+	{
+		fprintf(stderr, "unable to write %s (error %d)\n", filename, err);
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  load_image - load a file into a buffer; done
+//  here rather than with core_fload so the buffer
+//  comes from the tracked allocator
+//-------------------------------------------------
+
+static bool load_image(const char *filename, dynamic_buffer &image)
+{
+	core_file *file;
+	if (core_fopen(filename, OPEN_FLAG_READ, &file) != FILERR_NONE)
+		return false;
+	image.resize(core_fsize(file));
+	bool success = (core_fread(file, &image[0], image.count()) == image.count());
+	core_fclose(file);
+	return success;
+}
+
+
+//-------------------------------------------------
+//  read_state - read the entries back from a
+//  file image, as save_manager::read_file does
+//-------------------------------------------------
+
+static save_error read_state(const dynamic_buffer &image, dynamic_buffer &data, const UINT32 *offsets)
+{
+	core_file *file;
+	if (core_fopen_ram(&image[0], image.count(), OPEN_FLAG_READ, &file) != FILERR_NONE)
+		return STATERR_READ_ERROR;
+	core_fseek(file, HEADER_SIZE, SEEK_SET);
+
+	chunked_state state;
+	save_error err = state.read_directory(*file);
+	UINT32 found[ENTRY_COUNT];
+	for (int entrynum = 0; entrynum < ENTRY_COUNT && err == STATERR_NONE; entrynum++)
+		if (offsets[entrynum] != ~0 && !state.find_entry(s_entries[entrynum].m_name, s_entries[entrynum].m_size, found[entrynum]))
+			err = STATERR_INVALID_HEADER;
+	if (err == STATERR_NONE)
+		err = state.read_data(*file);
+	core_fclose(file);
+	if (err != STATERR_NONE)
+		return err;
+
+	// put the entries back where we'd expect them
+	data.resize(0);
+	for (int entrynum = 0; entrynum < ENTRY_COUNT; entrynum++)
+		if (offsets[entrynum] != ~0 && s_entries[entrynum].m_size != 0)
+		{
+			data.resize(MAX(data.count(), offsets[entrynum] + s_entries[entrynum].m_size), true);
+			memcpy(&data[offsets[entrynum]], state.data(found[entrynum]), s_entries[entrynum].m_size);
+		}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  test_round_trip - write the entries and make
+//  sure they read back intact
+//-------------------------------------------------
+
+static bool test_round_trip(const char *filename, dynamic_buffer &image, const dynamic_buffer &data, const UINT32 *offsets)
+{
+	if (!write_state(filename, data, offsets) || !load_image(filename, image))
+		return false;
+	UINT32 chunks = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&image[HEADER_SIZE]);
+	printf("round trip: %d bytes in %d chunks compressed to %d bytes\n", data.count(), chunks, image.count());
+
+	dynamic_buffer readback;
+	save_error err = read_state(image, readback, offsets);
+	if (err != STATERR_NONE)
+	{
+		fprintf(stderr, "round trip: read failed with error %d\n", err);
+		return false;
+	}
+	if (chunks != (data.count() + chunked_state::CHUNK_SIZE - 1) / chunked_state::CHUNK_SIZE || readback.count() != data.count() || memcmp(&readback[0], &data[0], data.count()) != 0)
+	{
+		fprintf(stderr, "round trip: data mismatch\n");
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  test_empty - a state with no data at all
+//-------------------------------------------------
+
+static bool test_empty(const char *filename)
+{
+	dynamic_buffer data, image, readback;
+	UINT32 offsets[ENTRY_COUNT];
+	for (int entrynum = 0; entrynum < ENTRY_COUNT; entrynum++)
+		offsets[entrynum] = ~0;
+	if (!write_state(filename, data, offsets) || !load_image(filename, image))
+		return false;
+	save_error err = read_state(image, readback, offsets);
+	if (err != STATERR_NONE || readback.count() != 0 || image.count() != HEADER_SIZE + DIRECTORY_SIZE)
+	{
+		fprintf(stderr, "empty: error %d, %d bytes read back from a %d byte file\n", err, readback.count(), image.count());
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  test_limit - a state needing too many chunks
+//  must be refused up front
+//-------------------------------------------------
+
+static bool test_limit()
+{
+	chunked_state state;
+	if (state.allocate(chunked_state::MAX_CHUNKS * chunked_state::CHUNK_SIZE + 1))
+	{
+		fprintf(stderr, "limit: allocated a state needing %d chunks\n", chunked_state::MAX_CHUNKS + 1);
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  expect_failure - damage a copy of the image
+//  and make sure it doesn't load
+//-------------------------------------------------
+
+static bool expect_failure(const char *name, const dynamic_buffer &image, UINT32 offset, UINT32 newvalue, int bytes, UINT32 truncate, const UINT32 *offsets)
+{
+	dynamic_buffer damaged(image.count());
+	memcpy(&damaged[0], &image[0], image.count());
+	for (int byte = 0; byte < bytes; byte++)
+		damaged[offset + byte] = newvalue >> (8 * byte);
+	if (truncate != 0)
+		damaged.resize(truncate, true);
+
+	dynamic_buffer readback;
+	save_error err = read_state(damaged, readback, offsets);
+	printf("corruption: %-32s error %d\n", name, err);
+	if (err == STATERR_NONE)
+	{
+		fprintf(stderr, "corruption: %s loaded without an error\n", name);
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  test_corruption - damage each part of the file
+//  in turn
+//-------------------------------------------------
+
+static bool test_corruption(const dynamic_buffer &image, const UINT32 *offsets)
+{
+	UINT32 chunks = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&image[HEADER_SIZE]);
+	UINT32 indexsize = LITTLE_ENDIANIZE_INT32(*(UINT32 *)&image[HEADER_SIZE + 8]);
+	UINT32 table = HEADER_SIZE + DIRECTORY_SIZE;
+	UINT32 index = table + chunks * CHUNK_ENTRY_SIZE;
+	UINT32 chunkdata = index + indexsize;
+
+	// the index records for the first two entries
+	UINT32 first = index;
+	UINT32 second = first + 8 + strlen(s_entries[0].m_name) + 1;
+
+	bool success = true;
+	success = expect_failure("too many chunks", image, HEADER_SIZE + 0, chunked_state::MAX_CHUNKS + 1, 4, 0, offsets) && success;
+	success = expect_failure("more chunks than the file holds", image, HEADER_SIZE + 0, chunks + 100, 4, 0, offsets) && success;
+	success = expect_failure("huge index", image, HEADER_SIZE + 8, 0xffffff00, 4, 0, offsets) && success;
+	success = expect_failure("index too short", image, HEADER_SIZE + 8, indexsize / 2, 4, 0, offsets) && success;
+	success = expect_failure("no index records", image, HEADER_SIZE + 4, 0, 4, 0, offsets) && success;
+	success = expect_failure("compressed length past the end", image, table + 0, 0x7fffffff, 4, 0, offsets) && success;
+	success = expect_failure("compressed length too short", image, table + 0, 16, 4, 0, offsets) && success;
+	success = expect_failure("short chunk before the last", image, table + 4, chunked_state::CHUNK_SIZE - 1, 4, 0, offsets) && success;
+	success = expect_failure("oversized last chunk", image, table + (chunks - 1) * CHUNK_ENTRY_SIZE + 4, chunked_state::CHUNK_SIZE + 1, 4, 0, offsets) && success;
+	success = expect_failure("empty last chunk", image, table + (chunks - 1) * CHUNK_ENTRY_SIZE + 4, 0, 4, 0, offsets) && success;
+	success = expect_failure("bad CRC", image, table + CHUNK_ENTRY_SIZE + 8, ~LITTLE_ENDIANIZE_INT32(*(UINT32 *)&image[table + CHUNK_ENTRY_SIZE + 8]), 4, 0, offsets) && success;
+	success = expect_failure("entry past the data", image, second + 0, 0x7ffffff0, 4, 0, offsets) && success;
+	success = expect_failure("entry length changed", image, first + 4, 2, 4, 0, offsets) && success;
+	success = expect_failure("entry renamed", image, first + 8, 'd', 1, 0, offsets) && success;
+	success = expect_failure("index names run off the end", image, index + indexsize - 1, 'x', 1, 0, offsets) && success;
+	success = expect_failure("chunk data damaged", image, chunkdata + 100, image[chunkdata + 100] ^ 0x55, 1, 0, offsets) && success;
+	success = expect_failure("last chunk damaged", image, image.count() - 64, image[image.count() - 64] ^ 0x55, 1, 0, offsets) && success;
+	success = expect_failure("truncated chunk data", image, 0, 0, 0, image.count() - 1, offsets) && success;
+	success = expect_failure("truncated index", image, 0, 0, 0, index + 3, offsets) && success;
+	success = expect_failure("truncated directory", image, 0, 0, 0, HEADER_SIZE + 5, offsets) && success;
+	return success;
+}
+
+
+//-------------------------------------------------
+//  main - run all the tests
+//-------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: savechunk <outputdir>\n");
+		return 1;
+	}
+	char filename[1024];
+	snprintf(filename, sizeof(filename), "%s" PATH_SEPARATOR "savechunk.sta", argv[1]);
+
+	UINT32 offsets[ENTRY_COUNT];
+	dynamic_buffer data, image;
+	fill_entries(data, offsets);
+
+	bool success = test_round_trip(filename, image, data, offsets);
+	if (success)
+		success = test_corruption(image, offsets);
+	success = test_empty(filename) && success;
+	success = test_limit() && success;
+	osd_rmfile(filename);
+
+	if (success)
+		printf("All tests finished successfully\n");
+	return success ? 0 : 1;
+}
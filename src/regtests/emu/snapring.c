@@ -0,0 +1,266 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    snapshot ring regression test
+
+    Lays out a handful of live state blocks the way save_manager does,
+    snapshots them while making small random changes, then rewinds to
+    each earlier snapshot and checks that copying the state back out
+    reproduces exactly what was live at the time. A second pass uses a
+    ring too small to hold every frame, so the oldest fall off.
+
+****************************************************************************/
+
+#include "emu.h"
+#include <stdio.h>
+#include <string.h>
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// sizes of the live blocks; the big one spans several pages and ends mid-page
+static const UINT32 s_block_sizes[] = { 16, 0, 3000, 4096, 40000, 1 };
+static const int BLOCK_COUNT = ARRAY_LENGTH(s_block_sizes);
+
+// snapshots taken per pass, and bytes changed between snapshots
+static const int SNAPSHOTS = 64;
+static const int CHANGES_PER_SNAPSHOT = 3;
+
+// ring sizes for the roomy and the cramped passes
+static const UINT32 ROOMY_RING = 1024 * 1024;
+static const UINT32 CRAMPED_RING = 16 * 4096;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// the live state: blocks laid out end-to-end in a flat image
+class test_state
+{
+public:
+	test_state()
+		: m_seed(0x12345678)
+	{
+		UINT32 offset = 0;
+		for (int blocknum = 0; blocknum < BLOCK_COUNT; blocknum++)
+		{
+			m_offset[blocknum] = offset;
+			offset += s_block_sizes[blocknum];
+			m_block[blocknum].resize(s_block_sizes[blocknum]);
+			for (UINT32 byte = 0; byte < s_block_sizes[blocknum]; byte++)
+				m_block[blocknum][byte] = random();
+		}
+		m_size = offset;
+	}
+
+	UINT32 size() const { return m_size; }
+
+	// change a few random bytes
+	void mutate()
+	{
+		for (int change = 0; change < CHANGES_PER_SNAPSHOT; change++)
+		{
+			int blocknum = random() % BLOCK_COUNT;
+			if (s_block_sizes[blocknum] != 0)
+				m_block[blocknum][random() % s_block_sizes[blocknum]] ^= 1 + random() % 255;
+		}
+	}
+
+	// hand every block to the ring, as save_manager::snapshot_save does
+	void save(snapshot_ring &ring)
+	{
+		ring.begin();
+		for (int blocknum = 0; blocknum < BLOCK_COUNT; blocknum++)
+			ring.capture(m_offset[blocknum], (s_block_sizes[blocknum] != 0) ? &m_block[blocknum][0] : NULL, s_block_sizes[blocknum]);
+		ring.end();
+	}
+
+	// copy every block back out, as save_manager::snapshot_load does
+	void load(const snapshot_ring &ring)
+	{
+		for (int blocknum = 0; blocknum < BLOCK_COUNT; blocknum++)
+			if (s_block_sizes[blocknum] != 0)
+				memcpy(&m_block[blocknum][0], ring.state(m_offset[blocknum]), s_block_sizes[blocknum]);
+	}
+
+	// flatten the blocks for comparison
+	void flatten(dynamic_array<UINT8> &dest) const
+	{
+		dest.resize(m_size);
+		for (int blocknum = 0; blocknum < BLOCK_COUNT; blocknum++)
+			if (s_block_sizes[blocknum] != 0)
+				memcpy(&dest[m_offset[blocknum]], &m_block[blocknum][0], s_block_sizes[blocknum]);
+	}
+
+private:
+	UINT32 random()
+	{
+		m_seed = m_seed * 1103515245 + 12345;
+		return m_seed >> 8;
+	}
+
+	UINT32                  m_seed;
+	UINT32                  m_size;
+	UINT32                  m_offset[BLOCK_COUNT];
+	dynamic_array<UINT8>    m_block[BLOCK_COUNT];
+};
+
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  matches - compare the live state with one
+//  taken earlier
+//-------------------------------------------------
+
+static bool matches(const test_state &state, const dynamic_array<UINT8> &expected)
+{
+	dynamic_array<UINT8> live;
+	state.flatten(live);
+	return memcmp(&live[0], &expected[0], expected.count()) == 0;
+}
+
+
+//-------------------------------------------------
+//  run_pass - snapshot while mutating, then rewind
+//  step by step and compare each snapshot
+//-------------------------------------------------
+
+static bool run_pass(const char *name, UINT32 ringsize)
+{
+	test_state state;
+	snapshot_ring ring;
+	ring.allocate(state.size(), ringsize);
+	bool success = true;
+
+	// keep a full copy of every snapshot as we go
+	dynamic_array<UINT8> expected[SNAPSHOTS];
+	for (int snapnum = 0; snapnum < SNAPSHOTS; snapnum++)
+	{
+		if (snapnum != 0)
+			state.mutate();
+		state.flatten(expected[snapnum]);
+		state.save(ring);
+	}
+
+	// a cramped ring must have lost some, a roomy one none
+	int count = ring.count();
+	printf("%s: %d of %d snapshots reachable, %d bytes of frames for %d bytes of state\n", name, count, SNAPSHOTS, ring.frame_bytes(), state.size());
+	if (count < 2 || count > SNAPSHOTS || (ringsize >= ROOMY_RING && count != SNAPSHOTS) || (ringsize < ROOMY_RING && count == SNAPSHOTS))
+	{
+		fprintf(stderr, "%s: unexpected snapshot count %d\n", name, count);
+		success = false;
+	}
+	if (ring.frame_bytes() > ringsize)
+	{
+		fprintf(stderr, "%s: frames overflow the ring\n", name);
+		success = false;
+	}
+
+	// the frames should only hold the pages that changed
+	if (ringsize >= ROOMY_RING && ring.frame_bytes() > (SNAPSHOTS - 1) * CHANGES_PER_SNAPSHOT * (4096 + 12))
+	{
+		fprintf(stderr, "%s: frames hold more than the changed pages\n", name);
+		success = false;
+	}
+
+	// mess up the live state, then rewind to the newest snapshot
+	state.mutate();
+	if (!ring.rewind(0))
+	{
+		fprintf(stderr, "%s: unable to restore the newest snapshot\n", name);
+		return false;
+	}
+	state.load(ring);
+	if (!matches(state, expected[SNAPSHOTS - 1]))
+	{
+		fprintf(stderr, "%s: newest snapshot does not match\n", name);
+		success = false;
+	}
+
+	// going back further than we have must fail and leave things alone
+	if (ring.rewind(count) || ring.rewind(-1) || ring.count() != count)
+	{
+		fprintf(stderr, "%s: rewinding out of range did not fail cleanly\n", name);
+		success = false;
+	}
+
+	// step back through the middle third one at a time
+	int snapnum = SNAPSHOTS - 1;
+	int stop = SNAPSHOTS - count + count / 3;
+	while (snapnum > stop)
+	{
+		state.mutate();
+		if (!ring.rewind(1))
+		{
+			fprintf(stderr, "%s: unable to step back to snapshot %d\n", name, snapnum - 1);
+			return false;
+		}
+		state.load(ring);
+		if (!matches(state, expected[--snapnum]))
+		{
+			fprintf(stderr, "%s: snapshot %d does not match\n", name, snapnum);
+			success = false;
+		}
+	}
+
+	// branch off from there; the new snapshots must rewind to the branch point
+	dynamic_array<UINT8> branch;
+	state.flatten(branch);
+	for (int newsnap = 0; newsnap < 4; newsnap++)
+	{
+		state.mutate();
+		state.save(ring);
+	}
+	if (!ring.rewind(4))
+	{
+		fprintf(stderr, "%s: unable to rewind to the branch point\n", name);
+		return false;
+	}
+	state.load(ring);
+	if (!matches(state, branch))
+	{
+		fprintf(stderr, "%s: branch point does not match\n", name);
+		success = false;
+	}
+
+	// finally jump straight back to the oldest snapshot still reachable; the
+	// branch may have pushed a few more out of a cramped ring
+	int oldest = snapnum - (ring.count() - 1);
+	if (oldest < SNAPSHOTS - count || !ring.rewind(ring.count() - 1))
+	{
+		fprintf(stderr, "%s: unable to rewind to the oldest snapshot\n", name);
+		return false;
+	}
+	state.load(ring);
+	if (!matches(state, expected[oldest]))
+	{
+		fprintf(stderr, "%s: oldest snapshot does not match\n", name);
+		success = false;
+	}
+	return success;
+}
+
+
+//-------------------------------------------------
+//  main - run both passes
+//-------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+	bool success = run_pass("roomy", ROOMY_RING);
+	success = run_pass("cramped", CRAMPED_RING) && success;
+
+	if (success)
+		printf("All tests finished successfully\n");
+	return success ? 0 : 1;
+}
@@ -0,0 +1,311 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    tilemap scanline rasterizer regression test
+
+    Draws random runs with every tilemap scanline rasterizer, once through
+    the SSE2 loops and once through the scalar loops alone, and checks
+    that the destination and priority rows come out identical. Runs cover
+    opaque and masked drawing, with and without a priority code, palette
+    offsets and alpha, at every alignment and at widths on either side of
+    each vector step. Pixels either side of a run must be left alone.
+
+****************************************************************************/
+
+#include "emu.h"
+#include "tilerast.h"
+#include <stdio.h>
+#include <string.h>
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// row size; runs start within the first ALIGNMENTS pixels and are at most
+// MAX_COUNT long, leaving untouched pixels at the end
+static const int ROW_PIXELS = 128;
+static const int ALIGNMENTS = 16;
+static const int MAX_COUNT = 96;
+
+// runs drawn per rasterizer
+static const int RUNS_PER_OP = 20000;
+
+// palette size; sources index the first half, palette offsets reach the second
+static const int PALETTE_PENS = 2048;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// one row's worth of each destination
+struct scanline_rows
+{
+	UINT16              dest16[ROW_PIXELS];
+	UINT32              dest32[ROW_PIXELS];
+	UINT8               pri[ROW_PIXELS];
+};
+
+
+// everything a single run needs
+struct run_params
+{
+	const UINT16 *      source;
+	const UINT8 *       maskptr;
+	const pen_t *       pens;
+	int                 offset;
+	int                 count;
+	int                 mask;
+	int                 value;
+	UINT32              pcode;
+	UINT8               alpha;
+};
+
+
+typedef void (*run_func)(scanline_rows &rows, const run_params &params);
+
+struct scanline_op
+{
+	const char *    name;
+	run_func        sse2;
+	run_func        scalar;
+};
+
+
+
+//**************************************************************************
+//  RASTERIZER INSTANCES
+//**************************************************************************
+
+namespace tilerast_runs
+{
+
+template<bool _UseSSE2>
+static void opaque_null(scanline_rows &rows, const run_params &params)
+{
+	tilemap_scanline<_UseSSE2>::draw_opaque_null(params.count, &rows.pri[params.offset], params.pcode);
+}
+
+template<bool _UseSSE2>
+static void masked_null(scanline_rows &rows, const run_params &params)
+{
+	tilemap_scanline<_UseSSE2>::draw_masked_null(&params.maskptr[params.offset], params.mask, params.value, params.count, &rows.pri[params.offset], params.pcode);
+}
+
+template<bool _UseSSE2>
+static void opaque_ind16(scanline_rows &rows, const run_params &params)
+{
+	tilemap_scanline<_UseSSE2>::draw_opaque_ind16(&rows.dest16[params.offset], &params.source[params.offset], params.count, &rows.pri[params.offset], params.pcode);
+}
+
+template<bool _UseSSE2>
+static void masked_ind16(scanline_rows &rows, const run_params &params)
+{
+	tilemap_scanline<_UseSSE2>::draw_masked_ind16(&rows.dest16[params.offset], &params.source[params.offset], &params.maskptr[params.offset], params.mask, params.value, params.count, &rows.pri[params.offset], params.pcode);
+}
+
+template<bool _UseSSE2>
+static void opaque_rgb32(scanline_rows &rows, const run_params &params)
+{
+	tilemap_scanline<_UseSSE2>::draw_opaque_rgb32(&rows.dest32[params.offset], &params.source[params.offset], params.count, params.pens, &rows.pri[params.offset], params.pcode);
+}
+
+template<bool _UseSSE2>
+static void masked_rgb32(scanline_rows &rows, const run_params &params)
+{
+	tilemap_scanline<_UseSSE2>::draw_masked_rgb32(&rows.dest32[params.offset], &params.source[params.offset], &params.maskptr[params.offset], params.mask, params.value, params.count, params.pens, &rows.pri[params.offset], params.pcode);
+}
+
+template<bool _UseSSE2>
+static void opaque_rgb32_alpha(scanline_rows &rows, const run_params &params)
+{
+	tilemap_scanline<_UseSSE2>::draw_opaque_rgb32_alpha(&rows.dest32[params.offset], &params.source[params.offset], params.count, params.pens, &rows.pri[params.offset], params.pcode, params.alpha);
+}
+
+template<bool _UseSSE2>
+static void masked_rgb32_alpha(scanline_rows &rows, const run_params &params)
+{
+	tilemap_scanline<_UseSSE2>::draw_masked_rgb32_alpha(&rows.dest32[params.offset], &params.source[params.offset], &params.maskptr[params.offset], params.mask, params.value, params.count, params.pens, &rows.pri[params.offset], params.pcode, params.alpha);
+}
+
+}
+
+#define SCANLINE_ENTRY(NAME) { #NAME, tilerast_runs::NAME<true>, tilerast_runs::NAME<false> }
+
+static const scanline_op s_ops[] =
+{
+	SCANLINE_ENTRY(opaque_null),
+	SCANLINE_ENTRY(masked_null),
+	SCANLINE_ENTRY(opaque_ind16),
+	SCANLINE_ENTRY(masked_ind16),
+	SCANLINE_ENTRY(opaque_rgb32),
+	SCANLINE_ENTRY(masked_rgb32),
+	SCANLINE_ENTRY(opaque_rgb32_alpha),
+	SCANLINE_ENTRY(masked_rgb32_alpha),
+};
+
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  random_value - return a pseudo-random 16-bit
+//  value
+//-------------------------------------------------
+
+static UINT32 s_seed = 12345;
+
+static UINT32 random_value()
+{
+	s_seed = s_seed * 1103515245 + 12345;
+	return s_seed >> 16;
+}
+
+
+//-------------------------------------------------
+//  random_params - pick the parameters for a run,
+//  filling in the flags row to suit
+//-------------------------------------------------
+
+static void random_params(run_params &params, UINT8 *maskrow)
+{
+	static const int s_masks[] = { 0x10, 0x30, 0x0f, 0xff };
+
+	params.offset = random_value() % ALIGNMENTS;
+
+	// widths either side of the 4, 8 and 16 pixel steps, and anything else
+	static const int s_counts[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33 };
+	if (random_value() % 2)
+		params.count = s_counts[random_value() % ARRAY_LENGTH(s_counts)];
+	else
+		params.count = random_value() % (MAX_COUNT + 1);
+
+	// no palette offset takes a different path in the ind16 rasterizer
+	UINT32 pal = (random_value() % 4 == 0) ? 0 : random_value() % (PALETTE_PENS / 2);
+
+	// a third of the runs don't touch priority at all
+	UINT32 primask = (random_value() % 3 == 0) ? 0xff00 : random_value() & 0xffff;
+	params.pcode = (pal << 16) | primask;
+
+	// flags rows are all transparent, all opaque, or a mix
+	params.mask = s_masks[random_value() % ARRAY_LENGTH(s_masks)];
+	params.value = random_value() & params.mask;
+	int density = random_value() % 3;
+	for (int x = 0; x < ROW_PIXELS; x++)
+	{
+		bool opaque = (density == 0) ? false : (density == 1) ? true : (random_value() % 2 != 0);
+		UINT8 flags = random_value();
+		if (opaque)
+			flags = (flags & ~params.mask) | params.value;
+		else if ((flags & params.mask) == params.value)
+			flags ^= params.mask & -params.mask;
+		maskrow[x] = flags;
+	}
+
+	params.alpha = random_value();
+}
+
+
+//-------------------------------------------------
+//  first_difference - return the first pixel at
+//  which two rows differ, or -1
+//-------------------------------------------------
+
+template<typename _PixelType>
+static int first_difference(const _PixelType *row1, const _PixelType *row2)
+{
+	for (int x = 0; x < ROW_PIXELS; x++)
+		if (row1[x] != row2[x])
+			return x;
+	return -1;
+}
+
+
+//-------------------------------------------------
+//  run_op - draw random runs with one rasterizer
+//  both ways and compare the rows
+//-------------------------------------------------
+
+static bool run_op(const scanline_op &op, const UINT16 *source, const pen_t *pens)
+{
+	UINT8 maskrow[ROW_PIXELS];
+	scanline_rows before, sse2, scalar;
+
+	for (int runnum = 0; runnum < RUNS_PER_OP; runnum++)
+	{
+		run_params params;
+		params.source = source;
+		params.maskptr = maskrow;
+		params.pens = pens;
+		random_params(params, maskrow);
+
+		// fill the rows with garbage, then draw over copies of them
+		for (int x = 0; x < ROW_PIXELS; x++)
+		{
+			before.dest16[x] = random_value();
+			before.dest32[x] = (random_value() << 16) | random_value();
+			before.pri[x] = random_value();
+		}
+		sse2 = before;
+		scalar = before;
+		(*op.sse2)(sse2, params);
+		(*op.scalar)(scalar, params);
+
+		// check both ways agree, and neither touched anything outside the run
+		int diff16 = first_difference(sse2.dest16, scalar.dest16);
+		int diff32 = first_difference(sse2.dest32, scalar.dest32);
+		int diffpri = first_difference(sse2.pri, scalar.pri);
+		if (diff16 != -1 || diff32 != -1 || diffpri != -1)
+		{
+			const char *which = (diffpri != -1) ? "priority" : "destination";
+			int x = (diffpri != -1) ? diffpri : (diff16 != -1) ? diff16 : diff32;
+			fprintf(stderr, "%s: %s differs at pixel %d of a %d pixel run at %d, pcode %08X, mask %02X/%02X, alpha %02X\n",
+					op.name, which, x - params.offset, params.count, params.offset, params.pcode, params.mask, params.value, params.alpha);
+			return false;
+		}
+		for (int x = 0; x < ROW_PIXELS; x++)
+			if ((x < params.offset || x >= params.offset + params.count) &&
+				(scalar.dest16[x] != before.dest16[x] || scalar.dest32[x] != before.dest32[x] || scalar.pri[x] != before.pri[x]))
+			{
+				fprintf(stderr, "%s: pixel %d was changed outside a %d pixel run at %d\n", op.name, x, params.count, params.offset);
+				return false;
+			}
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  main - main entry point
+//-------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+#ifndef __SSE2__
+	printf("SSE2 is not enabled in this build; both ways run the scalar loops\n");
+#endif
+
+	// source pixels index the first half of the palette
+	UINT16 source[ROW_PIXELS];
+	for (int x = 0; x < ROW_PIXELS; x++)
+		source[x] = random_value() % (PALETTE_PENS / 2);
+
+	// pens with junk in the top byte, which the alpha blend must drop
+	dynamic_array<pen_t> pens(PALETTE_PENS);
+	for (int pen = 0; pen < PALETTE_PENS; pen++)
+		pens[pen] = (random_value() << 16) | random_value();
+
+	bool success = true;
+	for (int opnum = 0; opnum < ARRAY_LENGTH(s_ops); opnum++)
+		success &= run_op(s_ops[opnum], source, pens);
+
+	if (success)
+		printf("All tests finished successfully\n");
+	return success ? 0 : 1;
+}
@@ -0,0 +1,918 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    UML block optimizer regression test
+
+    Runs UML instruction sequences through a small reference interpreter
+    twice: once as written, with every instruction producing all of its
+    flags, and once after drcuml_optimizer's passes have trimmed flags,
+    propagated constants and cached loads, and removed dead stores and
+    register writes. The registers and memory the sequence works on must
+    come out the same. Flags an instruction was told not to produce are
+    scrambled by the interpreter, so a flag trimmed too eagerly shows up
+    as a mismatch too.
+
+    A handful of hand-written sequences cover the cases each pass has to
+    get right; the rest are generated at random.
+
+****************************************************************************/
+
+#include "emu.h"
+#include "cpu/drcuml.h"
+#include <stdio.h>
+
+using namespace uml;
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// sequence limits
+static const int MAX_INSTRUCTIONS = 128;
+static const int MAX_STEPS = 10000;
+
+// the generated sequences
+static const int RANDOM_SEQUENCES = 4000;
+static const int RANDOM_LENGTH = 40;
+static const int STATES_PER_SEQUENCE = 3;
+
+// the loop counter register, which generated code doesn't otherwise touch
+static const int LOOP_REGISTER = 4;
+static const int TEST_REGISTERS = 5;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// the memory the sequences work on, standing in for a CPU core's state;
+// the low half of q[0] is also used as a 32-bit value, and a-d as a table
+struct test_core
+{
+	UINT32          a, b, c, d;
+	UINT64          q[2];
+};
+
+
+// everything a sequence can change
+struct test_state
+{
+	UINT64          reg[TEST_REGISTERS];
+	test_core       core;
+};
+
+
+// a simple random number generator, so runs are repeatable
+class test_random
+{
+public:
+	test_random(UINT32 seed) : m_seed(seed) { }
+
+	UINT32 next() { m_seed = m_seed * 1103515245 + 12345; return m_seed >> 8; }
+	UINT32 below(UINT32 limit) { return next() % limit; }
+	UINT64 next64() { UINT64 result = next(); return (result << 40) ^ (UINT64(next()) << 16) ^ next(); }
+
+private:
+	UINT32          m_seed;
+};
+
+
+// a sequence of instructions under construction
+class test_sequence
+{
+public:
+	test_sequence() : m_count(0), m_defined(0) { }
+
+	// getters
+	int count() const { return m_count; }
+	instruction *inst() { return m_inst; }
+	UINT8 defined_flags() const { return m_defined; }
+
+	// add an instruction, unless it takes an operand it can't or reads
+	// flags that haven't been set
+	bool add(const instruction &inst)
+	{
+		for (int pnum = 0; pnum < inst.numparams(); pnum++)
+			if (!inst.param_accepts(pnum, inst.param(pnum).type()))
+				return false;
+		if ((inst.input_flags() & ~m_defined) != 0 || m_count >= MAX_INSTRUCTIONS)
+			return false;
+		m_inst[m_count++] = inst;
+
+		// anything can jump to a label, so we know nothing about the flags there
+		if (inst.opcode() == OP_LABEL)
+			m_defined = 0;
+		else
+			m_defined = (m_defined & ~inst.modified_flags()) | inst.output_flags();
+		return true;
+	}
+
+private:
+	instruction     m_inst[MAX_INSTRUCTIONS];
+	int             m_count;
+	UINT8           m_defined;
+};
+
+
+// a reference interpreter for the integer subset of UML the sequences use
+class test_interpreter
+{
+public:
+	test_interpreter(UINT32 seed) : m_random(seed), m_flags(0) { }
+
+	bool run(const instruction *inst, int count, test_state &state);
+
+private:
+	UINT64 get(const instruction &inst, int pnum);
+	void set(const instruction &inst, int pnum, UINT64 value);
+	bool condition_true(condition_t condition);
+	void *indexed(const instruction &inst);
+
+	test_random     m_random;
+	UINT64          m_reg[TEST_REGISTERS];
+	UINT8           m_flags;
+};
+
+
+
+//**************************************************************************
+//  GLOBAL VARIABLES
+//**************************************************************************
+
+// the memory the sequences refer to
+static test_core s_core;
+
+
+
+//**************************************************************************
+//  INLINE FUNCTIONS
+//**************************************************************************
+
+//-------------------------------------------------
+//  size_mask - return a mask covering an operand
+//  of the given number of bytes
+//-------------------------------------------------
+
+inline UINT64 size_mask(UINT8 size)
+{
+	return (size >= 8) ? U64(0xffffffffffffffff) : ((U64(1) << (8 * size)) - 1);
+}
+
+
+//-------------------------------------------------
+//  sign_bit - return the sign bit of a value of
+//  the given number of bytes
+//-------------------------------------------------
+
+inline UINT64 sign_bit(UINT8 size)
+{
+	return U64(1) << (8 * size - 1);
+}
+
+
+//-------------------------------------------------
+//  flags_sz - compute the sign and zero flags of
+//  a result
+//-------------------------------------------------
+
+inline UINT8 flags_sz(UINT64 result, UINT8 size)
+{
+	result &= size_mask(size);
+	return ((result & sign_bit(size)) ? FLAG_S : 0) | ((result == 0) ? FLAG_Z : 0);
+}
+
+
+
+//**************************************************************************
+//  REFERENCE INTERPRETER
+//**************************************************************************
+
+//-------------------------------------------------
+//  get - fetch the value of a parameter
+//-------------------------------------------------
+
+UINT64 test_interpreter::get(const instruction &inst, int pnum)
+{
+	const parameter &param = inst.param(pnum);
+	UINT8 size = inst.param_size(pnum);
+	if (param.is_immediate())
+		return param.immediate() & size_mask(size);
+	if (param.is_int_register())
+		return m_reg[param.ireg() - REG_I0] & size_mask(size);
+	if (param.is_memory())
+		return (size == 8) ? *(UINT64 *)param.memory() : *(UINT32 *)param.memory();
+	return 0;
+}
+
+
+//-------------------------------------------------
+//  set - store the value of a parameter; 32-bit
+//  writes leave the top of a register alone, as
+//  the C back-end does
+//-------------------------------------------------
+
+void test_interpreter::set(const instruction &inst, int pnum, UINT64 value)
+{
+	const parameter &param = inst.param(pnum);
+	UINT8 size = inst.param_size(pnum);
+	if (param.is_int_register())
+	{
+		UINT64 &reg = m_reg[param.ireg() - REG_I0];
+		reg = (reg & ~size_mask(size)) | (value & size_mask(size));
+	}
+	else if (size == 8)
+		*(UINT64 *)param.memory() = value;
+	else
+		*(UINT32 *)param.memory() = value;
+}
+
+
+//-------------------------------------------------
+//  condition_true - evaluate a condition against
+//  the current flags
+//-------------------------------------------------
+
+bool test_interpreter::condition_true(condition_t condition)
+{
+	bool c = (m_flags & FLAG_C) != 0;
+	bool v = (m_flags & FLAG_V) != 0;
+	bool z = (m_flags & FLAG_Z) != 0;
+	bool s = (m_flags & FLAG_S) != 0;
+	bool u = (m_flags & FLAG_U) != 0;
+	switch (condition)
+	{
+		case COND_ALWAYS:   return true;
+		case COND_Z:        return z;
+		case COND_NZ:       return !z;
+		case COND_S:        return s;
+		case COND_NS:       return !s;
+		case COND_C:        return c;
+		case COND_NC:       return !c;
+		case COND_V:        return v;
+		case COND_NV:       return !v;
+		case COND_U:        return u;
+		case COND_NU:       return !u;
+		case COND_A:        return !c && !z;
+		case COND_BE:       return c || z;
+		case COND_G:        return !z && s == v;
+		case COND_LE:       return z || s != v;
+		case COND_L:        return s != v;
+		case COND_GE:       return s == v;
+		default:            return false;
+	}
+}
+
+
+//-------------------------------------------------
+//  indexed - compute the address a LOAD or STORE
+//  refers to
+//-------------------------------------------------
+
+void *test_interpreter::indexed(const instruction &inst)
+{
+	bool load = (inst.opcode() == OP_LOAD);
+	UINT8 *base = (UINT8 *)inst.param(load ? 1 : 0).memory();
+	UINT32 index = get(inst, load ? 2 : 1);
+	return base + index * (1 << inst.param(3).scale());
+}
+
+
+//-------------------------------------------------
+//  run - run a sequence from the given state,
+//  updating it
+//-------------------------------------------------
+
+bool test_interpreter::run(const instruction *inst, int count, test_state &state)
+{
+	memcpy(m_reg, state.reg, sizeof(m_reg));
+	s_core = state.core;
+	m_flags = 0;
+
+	int steps = 0;
+	for (int pc = 0; pc < count; pc++)
+	{
+		if (++steps > MAX_STEPS)
+		{
+			fprintf(stderr, "sequence did not finish\n");
+			return false;
+		}
+
+		const instruction &cur = inst[pc];
+		UINT8 size = cur.size();
+		UINT64 mask = size_mask(size);
+		UINT8 flags = 0;
+		if (cur.opcode() != OP_SET && !condition_true(cur.condition()))
+			continue;
+
+		switch (cur.opcode())
+		{
+			case OP_NOP:
+			case OP_COMMENT:
+			case OP_LABEL:
+				break;
+
+			case OP_JMP:
+				for (int target = 0; target < count; target++)
+					if (inst[target].opcode() == OP_LABEL && inst[target].param(0).label() == cur.param(0).label())
+						pc = target;
+				break;
+
+			case OP_MOV:
+				set(cur, 0, get(cur, 1));
+				break;
+
+			case OP_SET:
+				set(cur, 0, condition_true(cur.condition()) ? 1 : 0);
+				break;
+
+			case OP_LOAD:
+				set(cur, 0, (cur.param(3).size() == SIZE_QWORD) ? *(UINT64 *)indexed(cur) : *(UINT32 *)indexed(cur));
+				break;
+
+			case OP_STORE:
+				if (cur.param(3).size() == SIZE_QWORD)
+					*(UINT64 *)indexed(cur) = get(cur, 2);
+				else
+					*(UINT32 *)indexed(cur) = get(cur, 2);
+				break;
+
+			case OP_CARRY:
+				flags = ((get(cur, 0) >> (get(cur, 1) & (8 * size - 1))) & 1) ? FLAG_C : 0;
+				break;
+
+			case OP_SEXT:
+			{
+				int bits = 8 << cur.param(2).size();
+				UINT64 value = get(cur, 1);
+				if (bits < 64 && (value & (U64(1) << (bits - 1))))
+					value |= ~((U64(1) << bits) - 1);
+				set(cur, 0, value);
+				flags = flags_sz(value, size);
+				break;
+			}
+
+			case OP_ROLAND:
+			{
+				int shift = get(cur, 2) & (8 * size - 1);
+				UINT64 value = get(cur, 1);
+				if (shift != 0)
+					value = ((value << shift) | (value >> (8 * size - shift))) & mask;
+				value &= get(cur, 3);
+				set(cur, 0, value);
+				flags = flags_sz(value, size);
+				break;
+			}
+
+			case OP_ADD:
+			case OP_ADDC:
+			case OP_SUB:
+			case OP_SUBB:
+			case OP_CMP:
+			{
+				bool cmp = (cur.opcode() == OP_CMP);
+				bool add = (cur.opcode() == OP_ADD || cur.opcode() == OP_ADDC);
+				UINT64 a = get(cur, cmp ? 0 : 1);
+				UINT64 b = get(cur, cmp ? 1 : 2);
+				UINT64 carry = (cur.opcode() == OP_ADDC || cur.opcode() == OP_SUBB) ? (m_flags & FLAG_C) : 0;
+				UINT64 result = (add ? (a + b + carry) : (a - b - carry)) & mask;
+				bool c = add ? (result < a || (carry && result == a)) : (b > a || (carry && b == a));
+				bool v = ((add ? ~(a ^ b) : (a ^ b)) & (a ^ result) & sign_bit(size)) != 0;
+				flags = flags_sz(result, size) | (c ? FLAG_C : 0) | (v ? FLAG_V : 0);
+				if (!cmp)
+					set(cur, 0, result);
+				break;
+			}
+
+			case OP_AND:
+			case OP_OR:
+			case OP_XOR:
+			case OP_TEST:
+			{
+				bool test = (cur.opcode() == OP_TEST);
+				UINT64 a = get(cur, test ? 0 : 1);
+				UINT64 b = get(cur, test ? 1 : 2);
+				UINT64 result = (cur.opcode() == OP_OR) ? (a | b) : (cur.opcode() == OP_XOR) ? (a ^ b) : (a & b);
+				flags = flags_sz(result, size);
+				if (!test)
+					set(cur, 0, result);
+				break;
+			}
+
+			case OP_SHL:
+			case OP_SHR:
+			case OP_SAR:
+			case OP_ROL:
+			case OP_ROR:
+			{
+				int bits = 8 * size;
+				int shift = get(cur, 2) & (bits - 1);
+				UINT64 value = get(cur, 1);
+				UINT64 result = value;
+				bool c = false;
+				if (shift != 0)
+					switch (cur.opcode())
+					{
+						case OP_SHL:
+							result = (value << shift) & mask;
+							c = (value >> (bits - shift)) & 1;
+							break;
+
+						case OP_SHR:
+							result = value >> shift;
+							c = (value >> (shift - 1)) & 1;
+							break;
+
+						case OP_SAR:
+							result = value >> shift;
+							if (value & sign_bit(size))
+								result |= mask & ~(mask >> shift);
+							c = (value >> (shift - 1)) & 1;
+							break;
+
+						case OP_ROL:
+							result = ((value << shift) | (value >> (bits - shift))) & mask;
+							c = result & 1;
+							break;
+
+						default:
+							result = ((value >> shift) | (value << (bits - shift))) & mask;
+							c = (result & sign_bit(size)) != 0;
+							break;
+					}
+				flags = flags_sz(result, size) | (c ? FLAG_C : 0);
+				set(cur, 0, result);
+				break;
+			}
+
+			default:
+			{
+				astring dasm;
+				fprintf(stderr, "interpreter can't run '%s'\n", cur.disasm(dasm));
+				return false;
+			}
+		}
+
+		// keep the flags the instruction was asked for, and scramble the rest
+		// of what it may modify
+		UINT8 modified = cur.modified_flags();
+		if (modified != 0)
+			m_flags = (m_flags & ~modified) | (flags & cur.flags()) | (m_random.next() & modified & ~cur.flags());
+	}
+
+	memcpy(state.reg, m_reg, sizeof(m_reg));
+	state.core = s_core;
+	return true;
+}
+
+
+
+//**************************************************************************
+//  SEQUENCE GENERATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  random_source - pick a register, memory or
+//  immediate operand of the given size
+//-------------------------------------------------
+
+static parameter random_source(test_random &random, UINT8 size)
+{
+	static const UINT64 s_immediates[] = { 0, 1, 2, 31, 32, 0x80000000, 0xffffffff, U64(0xffffffffffffffff), U64(0x8000000000000000) };
+	switch (random.below(3))
+	{
+		case 0:
+			return ireg(random.below(4));
+
+		case 1:
+			if (random.below(4) == 0)
+				return random.next64() & size_mask(size);
+			return s_immediates[random.below(ARRAY_LENGTH(s_immediates))] & size_mask(size);
+
+		default:
+			if (size == 8)
+				return mem(&s_core.q[random.below(2)]);
+			switch (random.below(5))
+			{
+				case 0:     return mem(&s_core.a);
+				case 1:     return mem(&s_core.b);
+				case 2:     return mem(&s_core.c);
+				case 3:     return mem(&s_core.d);
+				default:    return mem(&s_core.q[0]);
+			}
+	}
+}
+
+
+//-------------------------------------------------
+//  random_dest - pick a register or memory
+//  operand of the given size
+//-------------------------------------------------
+
+static parameter random_dest(test_random &random, UINT8 size)
+{
+	parameter result;
+	do
+		result = random_source(random, size);
+	while (result.is_immediate());
+	return result;
+}
+
+
+//-------------------------------------------------
+//  random_condition - pick a condition that the
+//  defined flags can answer, or COND_ALWAYS
+//-------------------------------------------------
+
+static condition_t random_condition(test_random &random, UINT8 defined)
+{
+	static const condition_t s_conditions[] =
+	{
+		COND_Z, COND_NZ, COND_S, COND_NS, COND_C, COND_NC, COND_V, COND_NV,
+		COND_A, COND_BE, COND_G, COND_LE, COND_L, COND_GE
+	};
+	for (int tries = 0; tries < 8; tries++)
+	{
+		instruction probe;
+		probe.jmp(s_conditions[random.below(ARRAY_LENGTH(s_conditions))], code_label(1));
+		if ((probe.input_flags() & ~defined) == 0)
+			return probe.condition();
+	}
+	return COND_ALWAYS;
+}
+
+
+//-------------------------------------------------
+//  random_instruction - generate one random
+//  integer instruction
+//-------------------------------------------------
+
+static void random_instruction(test_random &random, test_sequence &seq)
+{
+	for (int tries = 0; tries < 16; tries++)
+	{
+		bool q = (random.below(3) == 0);
+		UINT8 size = q ? 8 : 4;
+		parameter dst = random_dest(random, size);
+		parameter src1 = random_source(random, size);
+		parameter src2 = random_source(random, size);
+		condition_t cond = random_condition(random, seq.defined_flags());
+		instruction inst;
+		switch (random.below(20))
+		{
+			case 0:
+			case 1:
+			case 2:     q ? inst.dmov(dst, src1) : inst.mov(dst, src1); break;
+			case 3:     q ? inst.dmov(cond, dst, src1) : inst.mov(cond, dst, src1); break;
+			case 4:     q ? inst.dset(cond, dst) : inst.set(cond, dst); break;
+			case 5:     q ? inst.dadd(dst, src1, src2) : inst.add(dst, src1, src2); break;
+			case 6:     q ? inst.daddc(dst, src1, src2) : inst.addc(dst, src1, src2); break;
+			case 7:     q ? inst.dsub(dst, src1, src2) : inst.sub(dst, src1, src2); break;
+			case 8:     q ? inst.dsubb(dst, src1, src2) : inst.subb(dst, src1, src2); break;
+			case 9:     q ? inst.dcmp(src1, src2) : inst.cmp(src1, src2); break;
+			case 10:    q ? inst.dand(dst, src1, src2) : inst._and(dst, src1, src2); break;
+			case 11:    q ? inst.dor(dst, src1, src2) : inst._or(dst, src1, src2); break;
+			case 12:    q ? inst.dxor(dst, src1, src2) : inst._xor(dst, src1, src2); break;
+			case 13:    q ? inst.dtest(src1, src2) : inst.test(src1, src2); break;
+			case 14:    q ? inst.dshl(dst, src1, src2) : inst.shl(dst, src1, src2); break;
+			case 15:    q ? inst.dshr(dst, src1, src2) : inst.shr(dst, src1, src2); break;
+			case 16:    q ? inst.dsar(dst, src1, src2) : inst.sar(dst, src1, src2); break;
+			case 17:    q ? inst.drol(dst, src1, src2) : inst.ror(dst, src1, src2); break;
+			case 18:    q ? inst.dcarry(src1, src2) : inst.carry(src1, src2); break;
+
+			// indexed accesses to a-d, which the optimizer can't see through
+			default:
+				if (q)
+					inst.store(&s_core.a, random.below(4), random_source(random, 4), SIZE_DWORD, SCALE_x4);
+				else
+					inst.load(dst, &s_core.a, random.below(4), SIZE_DWORD, SCALE_x4);
+				break;
+		}
+		if (seq.add(inst))
+			return;
+	}
+}
+
+
+//-------------------------------------------------
+//  random_sequence - generate a random sequence,
+//  with forward branches and sometimes a loop
+//-------------------------------------------------
+
+static void random_sequence(test_random &random, test_sequence &seq)
+{
+	// loop a few times around the body, counting down in a register the body leaves alone
+	bool loop = (random.below(3) == 0);
+	if (loop)
+	{
+		instruction inst;
+		inst.mov(ireg(LOOP_REGISTER), 1 + random.below(4));
+		seq.add(inst);
+		inst.label(code_label(1));
+		seq.add(inst);
+	}
+
+	// fill in the body, branching forward now and again
+	UINT32 nextlabel = 2;
+	int pending = 0;
+	for (int instnum = 0; instnum < RANDOM_LENGTH; instnum++)
+	{
+		instruction inst;
+		if (pending != 0 && random.below(4) == 0)
+		{
+			inst.label(code_label(nextlabel++));
+			seq.add(inst);
+			pending = 0;
+		}
+		else if (pending == 0 && random.below(8) == 0)
+		{
+			inst.jmp(random_condition(random, seq.defined_flags()), code_label(nextlabel));
+			pending = seq.add(inst);
+		}
+		else
+			random_instruction(random, seq);
+	}
+	if (pending != 0)
+	{
+		instruction inst;
+		inst.label(code_label(nextlabel++));
+		seq.add(inst);
+	}
+
+	// close the loop
+	if (loop)
+	{
+		instruction inst;
+		inst.sub(ireg(LOOP_REGISTER), ireg(LOOP_REGISTER), 1);
+		seq.add(inst);
+		inst.jmp(COND_NZ, code_label(1));
+		seq.add(inst);
+	}
+}
+
+
+
+//**************************************************************************
+//  HAND-WRITTEN SEQUENCES
+//**************************************************************************
+
+//-------------------------------------------------
+//  build_partial_overwrite - an 8-byte store that
+//  a later 4-byte store only partly replaces
+//  must stay
+//-------------------------------------------------
+
+static void build_partial_overwrite(test_sequence &seq)
+{
+	instruction inst;
+	inst.dmov(mem(&s_core.q[0]), I0);                   seq.add(inst);
+	inst.mov(mem(&s_core.q[0]), I1);                    seq.add(inst);
+}
+
+
+//-------------------------------------------------
+//  build_high_half_live - a 32-bit write doesn't
+//  end the life of the top of a 64-bit value
+//-------------------------------------------------
+
+static void build_high_half_live(test_sequence &seq)
+{
+	instruction inst;
+	inst.dmov(I0, I1);                                  seq.add(inst);
+	inst.mov(I0, 5);                                    seq.add(inst);
+}
+
+
+//-------------------------------------------------
+//  build_indexed_store - an indexed store must
+//  invalidate a register's cached copy of the
+//  memory it hits
+//-------------------------------------------------
+
+static void build_indexed_store(test_sequence &seq)
+{
+	instruction inst;
+	inst.mov(I0, mem(&s_core.b));                       seq.add(inst);
+	inst.store(&s_core.a, 1, I2, SIZE_DWORD, SCALE_x4); seq.add(inst);
+	inst.add(I1, mem(&s_core.b), 3);                    seq.add(inst);
+}
+
+
+//-------------------------------------------------
+//  build_aliased_store - a store to one half of a
+//  64-bit value must invalidate a cached copy of
+//  the whole
+//-------------------------------------------------
+
+static void build_aliased_store(test_sequence &seq)
+{
+	instruction inst;
+	inst.dmov(I0, mem(&s_core.q[0]));                   seq.add(inst);
+	inst.mov(mem(&s_core.q[0]), I1);                    seq.add(inst);
+	inst.dadd(I2, mem(&s_core.q[0]), 1);                seq.add(inst);
+}
+
+
+//-------------------------------------------------
+//  build_conditional_write - a conditional move
+//  doesn't end the life of what it may replace
+//-------------------------------------------------
+
+static void build_conditional_write(test_sequence &seq)
+{
+	instruction inst;
+	inst.mov(I0, 1);                                    seq.add(inst);
+	inst.cmp(I1, I2);                                   seq.add(inst);
+	inst.mov(COND_Z, I0, 2);                            seq.add(inst);
+	inst.mov(COND_NZ, mem(&s_core.c), 9);               seq.add(inst);
+	inst.mov(mem(&s_core.c), I0);                       seq.add(inst);
+}
+
+
+//-------------------------------------------------
+//  build_flags_across - flags must survive the
+//  instructions between their producer and
+//  consumer, and a loop must see its own flags
+//-------------------------------------------------
+
+static void build_flags_across(test_sequence &seq)
+{
+	instruction inst;
+	inst.mov(I0, 3);                                    seq.add(inst);
+	inst.label(code_label(1));                          seq.add(inst);
+	inst.add(I1, I1, I0);                               seq.add(inst);
+	inst.cmp(I1, mem(&s_core.a));                       seq.add(inst);
+	inst.mov(I2, 7);                                    seq.add(inst);
+	inst.set(COND_A, I3);                               seq.add(inst);
+	inst.sub(I0, I0, 1);                                seq.add(inst);
+	inst.jmp(COND_NZ, code_label(1));                   seq.add(inst);
+	inst.add(I2, I2, I0);                               seq.add(inst);
+}
+
+
+//-------------------------------------------------
+//  build_constant_fold - constants and cached
+//  loads folded through a chain of operations
+//-------------------------------------------------
+
+static void build_constant_fold(test_sequence &seq)
+{
+	instruction inst;
+	inst.mov(I0, 0x1234);                               seq.add(inst);
+	inst.shl(I1, I0, 4);                                seq.add(inst);
+	inst.mov(mem(&s_core.d), I1);                       seq.add(inst);
+	inst.add(I2, mem(&s_core.d), I0);                   seq.add(inst);
+	inst.mov(I0, I2);                                   seq.add(inst);
+	inst.dsext(I3, I2, SIZE_WORD);                      seq.add(inst);
+}
+
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  random_state - fill in a random starting state
+//-------------------------------------------------
+
+static void random_state(test_random &random, test_state &state)
+{
+	for (int regnum = 0; regnum < TEST_REGISTERS; regnum++)
+		state.reg[regnum] = random.next64();
+	state.core.a = random.next();
+	state.core.b = random.next();
+	state.core.c = random.next();
+	state.core.d = random.next();
+	state.core.q[0] = random.next64();
+	state.core.q[1] = random.next64();
+}
+
+
+//-------------------------------------------------
+//  compare_sequence - run a sequence as written
+//  and optimized from several states, and check
+//  they agree
+//-------------------------------------------------
+
+static bool compare_sequence(const char *name, test_sequence &seq, test_random &random, drcuml_optimizer_stats &totals)
+{
+	// as written, every instruction produces all its flags
+	instruction original[MAX_INSTRUCTIONS];
+	for (int instnum = 0; instnum < seq.count(); instnum++)
+	{
+		original[instnum] = seq.inst()[instnum];
+		original[instnum].set_flags(original[instnum].output_flags());
+	}
+
+	instruction optimized[MAX_INSTRUCTIONS];
+	memcpy(optimized, seq.inst(), sizeof(optimized[0]) * seq.count());
+	drcuml_optimizer optimizer(optimized, seq.count());
+	int optcount = optimizer.optimize();
+	const drcuml_optimizer_stats &stats = optimizer.stats();
+	totals.blocks++;
+	totals.instructions_in += stats.instructions_in;
+	totals.instructions_out += stats.instructions_out;
+	totals.flags += stats.flags;
+	totals.constants += stats.constants;
+	totals.loads += stats.loads;
+	totals.stores += stats.stores;
+	totals.writes += stats.writes;
+
+	for (int statenum = 0; statenum < STATES_PER_SEQUENCE; statenum++)
+	{
+		test_state start, expected, actual;
+		random_state(random, start);
+		expected = actual = start;
+
+		// scramble the unrequested flags differently on each side
+		test_interpreter reference(random.next()), candidate(random.next());
+		if (!reference.run(original, seq.count(), expected) || !candidate.run(optimized, optcount, actual))
+			return false;
+		if (memcmp(&expected, &actual, sizeof(expected)) == 0)
+			continue;
+
+		// show what went wrong
+		fprintf(stderr, "%s: optimized code gave different results\n", name);
+		for (int regnum = 0; regnum < TEST_REGISTERS; regnum++)
+			if (expected.reg[regnum] != actual.reg[regnum])
+				fprintf(stderr, "  i%d: expected %08X%08X, got %08X%08X\n", regnum,
+						UINT32(expected.reg[regnum] >> 32), UINT32(expected.reg[regnum]), UINT32(actual.reg[regnum] >> 32), UINT32(actual.reg[regnum]));
+		if (memcmp(&expected.core, &actual.core, sizeof(expected.core)) != 0)
+			fprintf(stderr, "  memory differs\n");
+		astring dasm;
+		fprintf(stderr, "  as written:\n");
+		for (int instnum = 0; instnum < seq.count(); instnum++)
+			fprintf(stderr, "    %s\n", original[instnum].disasm(dasm));
+		fprintf(stderr, "  optimized:\n");
+		for (int instnum = 0; instnum < optcount; instnum++)
+			fprintf(stderr, "    %s\n", optimized[instnum].disasm(dasm));
+		return false;
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  main - run the hand-written sequences, then
+//  the random ones
+//-------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+	static const struct
+	{
+		const char *name;
+		void (*build)(test_sequence &seq);
+	} s_handwritten[] =
+	{
+		{ "partial overwrite",  build_partial_overwrite },
+		{ "high half live",     build_high_half_live },
+		{ "indexed store",      build_indexed_store },
+		{ "aliased store",      build_aliased_store },
+		{ "conditional write",  build_conditional_write },
+		{ "flags across",       build_flags_across },
+		{ "constant fold",      build_constant_fold }
+	};
+
+	drcuml_optimizer_stats totals;
+	memset(&totals, 0, sizeof(totals));
+	test_random random(0x5eed1234);
+	bool success = true;
+
+	for (int testnum = 0; testnum < ARRAY_LENGTH(s_handwritten); testnum++)
+	{
+		test_sequence seq;
+		(*s_handwritten[testnum].build)(seq);
+		success = compare_sequence(s_handwritten[testnum].name, seq, random, totals) && success;
+	}
+
+	int failures = 0;
+	for (int seqnum = 0; seqnum < RANDOM_SEQUENCES && failures < 5; seqnum++)
+	{
+		test_sequence seq;
+		random_sequence(random, seq);
+		char name[32];
+		sprintf(name, "random sequence %d", seqnum);
+		if (!compare_sequence(name, seq, random, totals))
+			failures++;
+	}
+	success = success && failures == 0;
+
+	printf("%d sequences: %d -> %d instructions; %d flags trimmed, %d constants, %d loads, %d stores, %d writes removed\n",
+			totals.blocks, totals.instructions_in, totals.instructions_out, totals.flags, totals.constants, totals.loads, totals.stores, totals.writes);
+
+	// make sure every pass actually had something to do
+	if (totals.flags == 0 || totals.constants == 0 || totals.loads == 0 || totals.stores == 0 || totals.writes == 0)
+	{
+		fprintf(stderr, "some optimizer passes never did anything\n");
+		success = false;
+	}
+
+	if (success)
+		printf("All tests finished successfully\n");
+	return success ? 0 : 1;
+}
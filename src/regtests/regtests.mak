@@ -38,6 +38,25 @@
 ###########################################################################
 
 
+REGTESTSSRC = $(SRC)/regtests
+REGTESTSOBJ = $(OBJ)/regtests
+
+OBJDIRS += \
+	$(REGTESTSOBJ)/chdman \
+	$(REGTESTSOBJ)/emu \
+	$(REGTESTSOBJ)/util \
+
+# the DRC objects include the x86 disassembler, which only CPUS += I86 otherwise builds
+OBJDIRS += \
+	$(CPUOBJ)/i386 \
+
+ifeq ($(OSD),sdl)
+OBJDIRS += \
+	$(REGTESTSOBJ)/sdl \
+
+endif
+
+
 #-------------------------------------------------
 # set of regression test targets
 #-------------------------------------------------
@@ -45,7 +64,21 @@
 REGTESTS += \
 	jedutiltest \
 	chdmantest \
+	chdcachetest \
+	pixconvtest \
+	drawgfxtest \
+	tilerasttest \
+	snapringtest \
+	savechunktest \
+	umlopttest \
+	resampletest \
+	rendbandtest \
 
+ifeq ($(OSD),sdl)
+REGTESTS += \
+	sdlaudiotest \
+
+endif
 
 
 #-------------------------------------------------
@@ -65,3 +98,182 @@ jedutiltest:
 chdmantest:
 	@echo Running chdman unittest
 	$(PYTHON) $(SRC)/regtests/chdman/chdtest.py
+
+
+
+#-------------------------------------------------
+# chd hunk cache
+#-------------------------------------------------
+
+CHDCACHEOBJS = \
+	$(REGTESTSOBJ)/chdman/chdcache.o \
+
+$(REGTESTSOBJ)/chdman/chdcache$(EXE): $(CHDCACHEOBJS) $(LIBUTIL) $(ZLIB) $(EXPAT) $(FLAC_LIB) $(7Z_LIB) $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) $(FLAC_LIB) -o $@
+
+chdcachetest: maketree $(REGTESTSOBJ)/chdman/chdcache$(EXE)
+	@echo Running chd cache unittest
+	$(REGTESTSOBJ)/chdman/chdcache$(EXE) $(REGTESTSSRC)/chdman/output/copy_hd_1/out.chd $(REGTESTSSRC)/chdman/output/createcd_cue_audio_silence_wav_20_tracks/out.chd
+
+
+
+#-------------------------------------------------
+# png/avi pixel conversion
+#-------------------------------------------------
+
+PIXCONVOBJS = \
+	$(REGTESTSOBJ)/util/pixconv.o \
+
+$(REGTESTSOBJ)/util/pixconv$(EXE): $(PIXCONVOBJS) $(LIBUTIL) $(ZLIB) $(EXPAT) $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+pixconvtest: maketree $(REGTESTSOBJ)/util/pixconv$(EXE)
+	@echo Running png/avi pixel conversion unittest
+	$(REGTESTSOBJ)/util/pixconv$(EXE) $(REGTESTSOBJ)/util
+
+pixconvbench: maketree $(REGTESTSOBJ)/util/pixconv$(EXE)
+	@echo Timing png/avi row kernels
+	$(REGTESTSOBJ)/util/pixconv$(EXE) $(REGTESTSOBJ)/util -bench
+
+
+
+#-------------------------------------------------
+# drawgfx core
+#-------------------------------------------------
+
+DRAWGFXOBJS = \
+	$(REGTESTSOBJ)/emu/drawgfx.o \
+
+$(REGTESTSOBJ)/emu/drawgfx$(EXE): $(DRAWGFXOBJS) $(EMUOBJ)/emualloc.o $(LIBUTIL) $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+drawgfxtest: maketree $(REGTESTSOBJ)/emu/drawgfx$(EXE)
+	@echo Running drawgfx core unittest
+	$(REGTESTSOBJ)/emu/drawgfx$(EXE)
+
+
+
+#-------------------------------------------------
+# tilemap scanline rasterizers
+#-------------------------------------------------
+
+TILERASTOBJS = \
+	$(REGTESTSOBJ)/emu/tilerast.o \
+
+$(REGTESTSOBJ)/emu/tilerast$(EXE): $(TILERASTOBJS) $(EMUOBJ)/emualloc.o $(LIBUTIL) $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+tilerasttest: maketree $(REGTESTSOBJ)/emu/tilerast$(EXE)
+	@echo Running tilemap scanline rasterizer unittest
+	$(REGTESTSOBJ)/emu/tilerast$(EXE)
+
+
+
+#-------------------------------------------------
+# rewind snapshot ring
+#-------------------------------------------------
+
+SNAPRINGOBJS = \
+	$(REGTESTSOBJ)/emu/snapring.o \
+
+$(REGTESTSOBJ)/emu/snapring$(EXE): $(SNAPRINGOBJS) $(EMUOBJ)/snapring.o $(EMUOBJ)/emualloc.o $(LIBUTIL) $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+snapringtest: maketree $(REGTESTSOBJ)/emu/snapring$(EXE)
+	@echo Running rewind snapshot ring unittest
+	$(REGTESTSOBJ)/emu/snapring$(EXE)
+
+
+
+#-------------------------------------------------
+# chunked save states
+#-------------------------------------------------
+
+SAVECHUNKOBJS = \
+	$(REGTESTSOBJ)/emu/savechunk.o \
+
+$(REGTESTSOBJ)/emu/savechunk$(EXE): $(SAVECHUNKOBJS) $(EMUOBJ)/savechunk.o $(EMUOBJ)/emualloc.o $(LIBUTIL) $(ZLIB) $(LIBOCORE)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+savechunktest: maketree $(REGTESTSOBJ)/emu/savechunk$(EXE)
+	@echo Running chunked save state unittest
+	$(REGTESTSOBJ)/emu/savechunk$(EXE) $(REGTESTSOBJ)/emu
+
+
+
+#-------------------------------------------------
+# UML block optimizer
+#-------------------------------------------------
+
+UMLOPTOBJS = \
+	$(REGTESTSOBJ)/emu/umlopt.o \
+
+# the optimizer's home in drcuml.o brings in the rest of the emulator
+$(REGTESTSOBJ)/emu/umlopt$(EXE): $(UMLOPTOBJS) $(DRCOBJ) $(VERSIONOBJ) $(EMUINFOOBJ) $(DRIVLISTOBJ) $(DRVLIBS) $(LIBOSD) $(LIBOPTIONAL) $(LIBEMU) $(LIBDASM) $(LIBUTIL) $(EXPAT) $(SOFTFLOAT) $(JPEG_LIB) $(FLAC_LIB) $(7Z_LIB) $(FORMATS_LIB) $(LUA_LIB) $(WEB_LIB) $(ZLIB) $(LIBOCORE) $(MIDI_LIB)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $(LDFLAGSEMULATOR) $^ $(LIBS) -o $@
+
+umlopttest: maketree $(REGTESTSOBJ)/emu/umlopt$(EXE)
+	@echo Running UML block optimizer unittest
+	$(REGTESTSOBJ)/emu/umlopt$(EXE)
+
+
+
+#-------------------------------------------------
+# sound stream resampler
+#-------------------------------------------------
+
+RESAMPLEOBJS = \
+	$(REGTESTSOBJ)/emu/resample.o \
+
+# the kernels live in sound.o, which brings in the rest of the emulator
+$(REGTESTSOBJ)/emu/resample$(EXE): $(RESAMPLEOBJS) $(VERSIONOBJ) $(EMUINFOOBJ) $(DRIVLISTOBJ) $(DRVLIBS) $(LIBOSD) $(LIBOPTIONAL) $(LIBEMU) $(LIBDASM) $(LIBUTIL) $(EXPAT) $(SOFTFLOAT) $(JPEG_LIB) $(FLAC_LIB) $(7Z_LIB) $(FORMATS_LIB) $(LUA_LIB) $(WEB_LIB) $(ZLIB) $(LIBOCORE) $(MIDI_LIB)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $(LDFLAGSEMULATOR) $^ $(LIBS) -o $@
+
+resampletest: maketree $(REGTESTSOBJ)/emu/resample$(EXE)
+	@echo Running sound stream resampler unittest
+	$(REGTESTSOBJ)/emu/resample$(EXE)
+
+
+
+#-------------------------------------------------
+# software renderer bands
+#-------------------------------------------------
+
+RENDBANDOBJS = \
+	$(REGTESTSOBJ)/emu/rendband.o \
+
+# primitives are reset by render.o, which brings in the rest of the emulator
+$(REGTESTSOBJ)/emu/rendband$(EXE): $(RENDBANDOBJS) $(VERSIONOBJ) $(EMUINFOOBJ) $(DRIVLISTOBJ) $(DRVLIBS) $(LIBOSD) $(LIBOPTIONAL) $(LIBEMU) $(LIBDASM) $(LIBUTIL) $(EXPAT) $(SOFTFLOAT) $(JPEG_LIB) $(FLAC_LIB) $(7Z_LIB) $(FORMATS_LIB) $(LUA_LIB) $(WEB_LIB) $(ZLIB) $(LIBOCORE) $(MIDI_LIB)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $(LDFLAGSEMULATOR) $^ $(LIBS) -o $@
+
+rendbandtest: maketree $(REGTESTSOBJ)/emu/rendband$(EXE)
+	@echo Running software renderer banding unittest
+	$(REGTESTSOBJ)/emu/rendband$(EXE)
+
+
+
+#-------------------------------------------------
+# sdl audio ring
+#-------------------------------------------------
+
+ifeq ($(OSD),sdl)
+SDLAUDIOOBJS = \
+	$(REGTESTSOBJ)/sdl/audio.o \
+
+$(REGTESTSOBJ)/sdl/audio$(EXE): $(SDLAUDIOOBJS) $(SDLOBJ)/sdlaudio.o $(EMUOBJ)/emualloc.o $(LIBUTIL) $(LIBOCORE) $(SDLUTILMAIN)
+	@echo Linking $@...
+	$(LD) $(LDFLAGS) $^ $(LIBS) -o $@
+
+sdlaudiotest: maketree $(REGTESTSOBJ)/sdl/audio$(EXE)
+	@echo Running sdl audio ring unittest
+	$(REGTESTSOBJ)/sdl/audio$(EXE)
+endif
@@ -0,0 +1,326 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    SDL audio ring regression test
+
+    Pushes a triangle wave through the SDL audio ring and its rate-steering
+    resampler, and checks that it comes out without the duplicated or
+    dropped frames a phase reset at each block boundary would produce.
+    The first pass drains the ring by hand with a slightly slow consumer;
+    the second plays it through SDL's dummy audio driver.
+
+****************************************************************************/
+
+#include "sdlinc.h"
+
+#include "emu.h"
+#include "sdlaudio.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// stream parameters; 800 frames is one 60Hz update at 48kHz
+static const int SAMPLE_RATE = 48000;
+static const int XFER_SAMPLES = 512;
+static const int AUDIO_LATENCY = 2;
+static const int BLOCK_FRAMES = 800;
+
+// the triangle rises or falls by this much per input frame, turning at +/-TRIANGLE_PEAK
+static const int TRIANGLE_SLOPE = 64;
+static const int TRIANGLE_PEAK = 32000;
+
+// steady output steps stay within this much of the slope once resampled and rounded
+static const int SLOPE_TOLERANCE = 4;
+
+// the hand-drained pass consumes this many frames for each block it writes
+static const int DRAIN_FRAMES = 798;
+static const int DRAIN_BLOCKS = 5000;
+
+// the dummy driver pass runs this many blocks in real time
+static const int PLAY_BLOCKS = 120;
+static const int CAPTURE_FRAMES = SAMPLE_RATE * 3;
+static const int MAX_BREAKS = 1024;
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// generates the triangle wave, left channel rising where right falls
+class triangle_source
+{
+public:
+	triangle_source() : m_value(0), m_slope(TRIANGLE_SLOPE) { }
+
+	void generate(INT16 *dest, int frames)
+	{
+		for (int frame = 0; frame < frames; frame++)
+		{
+			*dest++ = m_value;
+			*dest++ = -m_value;
+			if (m_value + m_slope > TRIANGLE_PEAK || m_value + m_slope < -TRIANGLE_PEAK)
+				m_slope = -m_slope;
+			m_value += m_slope;
+		}
+	}
+
+private:
+	int m_value;
+	int m_slope;
+};
+
+
+// checks one channel for steps that are neither on the slope nor at a turn
+class continuity_checker
+{
+public:
+	continuity_checker(const char *name)
+		: m_name(name),
+			m_count(0),
+			m_checked(0),
+			m_errors(0)
+	{
+		memset(m_history, 0, sizeof(m_history));
+	}
+
+	void add(INT16 sample)
+	{
+		m_history[0] = m_history[1];
+		m_history[1] = m_history[2];
+		m_history[2] = m_history[3];
+		m_history[3] = sample;
+		if (++m_count < 4)
+			return;
+
+		// look at the middle step, with one step either side of it
+		int before = m_history[1] - m_history[0];
+		int step = m_history[2] - m_history[1];
+		int after = m_history[3] - m_history[2];
+		m_checked++;
+		if (abs(abs(step) - TRIANGLE_SLOPE) <= SLOPE_TOLERANCE)
+			return;
+
+		// near a turn the steps shrink and change sign; anything else is a glitch
+		if ((before > 0 && after < 0) || (before < 0 && after > 0) || (step > 0 && before < 0) || (step < 0 && before > 0) || (step > 0 && after < 0) || (step < 0 && after > 0))
+			return;
+		if (m_errors++ < 10)
+			fprintf(stderr, "%s: step of %d between steps of %d and %d at sample %d\n", m_name, step, before, after, m_count - 2);
+	}
+
+	void restart() { m_count = 0; }
+	int checked() const { return m_checked; }
+	int errors() const { return m_errors; }
+
+private:
+	const char *    m_name;
+	INT16           m_history[4];
+	int             m_count;
+	int             m_checked;
+	int             m_errors;
+};
+
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  check_frames - run captured frames through a
+//  pair of checkers
+//-------------------------------------------------
+
+static void check_frames(continuity_checker &left, continuity_checker &right, const INT16 *data, int frames)
+{
+	for (int frame = 0; frame < frames; frame++)
+	{
+		left.add(data[frame * 2 + 0]);
+		right.add(data[frame * 2 + 1]);
+	}
+}
+
+
+//-------------------------------------------------
+//  test_drained - feed the ring and drain it by
+//  hand a little slower than it is fed, so the
+//  controller has to squeeze every block
+//-------------------------------------------------
+
+static bool test_drained()
+{
+	sdl_audio_ring ring;
+	ring.allocate(SAMPLE_RATE, XFER_SAMPLES, AUDIO_LATENCY);
+
+	triangle_source source;
+	continuity_checker left("drained left"), right("drained right");
+	dynamic_array<INT16> block(BLOCK_FRAMES * 2);
+	dynamic_array<INT16> output(DRAIN_FRAMES * 2);
+
+	for (int blocknum = 0; blocknum < DRAIN_BLOCKS; blocknum++)
+	{
+		source.generate(block, BLOCK_FRAMES);
+		ring.write(block, BLOCK_FRAMES, 0);
+		if (!ring.started())
+			continue;
+
+		ring.read((UINT8 *)&output[0], DRAIN_FRAMES * sdl_audio_ring::FRAME_BYTES, true);
+		check_frames(left, right, output, DRAIN_FRAMES);
+	}
+
+	// by now the controller should have the depth close to its target
+	int fill = ring.fill();
+	int target = ring.target();
+	printf("drained: %d steps checked, fill %d bytes against a target of %d, %d overflows, %d underflows\n",
+			left.checked(), fill, target, ring.overflows(), ring.underflows());
+
+	bool success = (left.errors() == 0 && right.errors() == 0);
+	if (ring.overflows() != 0 || ring.underflows() != 0)
+	{
+		fprintf(stderr, "drained: expected no overflows or underflows\n");
+		success = false;
+	}
+	if (abs(fill - target) > XFER_SAMPLES * sdl_audio_ring::FRAME_BYTES)
+	{
+		fprintf(stderr, "drained: fill did not settle near the target\n");
+		success = false;
+	}
+	return success;
+}
+
+
+//-------------------------------------------------
+//  audio_callback - play from the ring and keep
+//  a copy of every chunk that was not cut short
+//-------------------------------------------------
+
+static sdl_audio_ring s_ring;
+static INT16 s_capture[CAPTURE_FRAMES * 2];
+static int s_captured;
+static int s_breaks[MAX_BREAKS];
+static int s_break_count;
+static int s_callbacks;
+
+static void SDLCALL audio_callback(void *userdata, Uint8 *stream, int len)
+{
+	int underflows = s_ring.underflows();
+	s_ring.read(stream, len, true);
+	s_callbacks++;
+
+	// an underflow pads the chunk with silence, so drop it and note the break
+	int frames = len / sdl_audio_ring::FRAME_BYTES;
+	if (s_ring.underflows() != underflows || s_captured + frames > CAPTURE_FRAMES)
+	{
+		if (s_break_count < MAX_BREAKS)
+			s_breaks[s_break_count++] = s_captured;
+		return;
+	}
+	memcpy(&s_capture[s_captured * 2], stream, frames * sdl_audio_ring::FRAME_BYTES);
+	s_captured += frames;
+}
+
+
+//-------------------------------------------------
+//  test_dummy_driver - play the ring in real time
+//  through the dummy SDL audio driver
+//-------------------------------------------------
+
+static bool test_dummy_driver()
+{
+	putenv((char *)"SDL_AUDIODRIVER=dummy");
+	if (SDL_Init(SDL_INIT_AUDIO | SDL_INIT_TIMER) < 0)
+	{
+		printf("dummy driver: skipped, unable to initialize SDL audio: %s\n", SDL_GetError());
+		return true;
+	}
+
+	SDL_AudioSpec aspec, obtained;
+	aspec.freq = SAMPLE_RATE;
+	aspec.format = AUDIO_S16SYS;
+	aspec.channels = 2;
+	aspec.samples = XFER_SAMPLES;
+	aspec.callback = audio_callback;
+	aspec.userdata = 0;
+	if (SDL_OpenAudio(&aspec, &obtained) < 0)
+	{
+		printf("dummy driver: skipped, unable to open audio: %s\n", SDL_GetError());
+		SDL_Quit();
+		return true;
+	}
+	s_ring.allocate(obtained.freq, obtained.samples, AUDIO_LATENCY);
+
+	// say which driver we got, in case SDL_AUDIODRIVER was overridden
+	char audio_driver[16] = "";
+#if (SDLMAME_SDL2)
+	strncpy(audio_driver, SDL_GetCurrentAudioDriver(), sizeof(audio_driver) - 1);
+#else
+	SDL_AudioDriverName(audio_driver, sizeof(audio_driver));
+#endif
+	printf("dummy driver: playing through '%s' at %d Hz, %d samples per callback\n", audio_driver, obtained.freq, obtained.samples);
+
+	// write one block per 60Hz frame, starting playback when the ring says so
+	triangle_source source;
+	dynamic_array<INT16> block(BLOCK_FRAMES * 2);
+	UINT32 start = SDL_GetTicks();
+	for (int blocknum = 0; blocknum < PLAY_BLOCKS; blocknum++)
+	{
+		while (SDL_GetTicks() - start < UINT32(blocknum * 1000 / 60))
+			SDL_Delay(1);
+		source.generate(block, BLOCK_FRAMES);
+		if (s_ring.write(block, BLOCK_FRAMES, 0))
+			SDL_PauseAudio(0);
+	}
+
+	// closing waits for the audio thread, after which the capture is ours
+	SDL_CloseAudio();
+	SDL_Quit();
+
+	continuity_checker left("dummy left"), right("dummy right");
+	int breaknum = 0;
+	for (int frame = 0; frame < s_captured; frame++)
+	{
+		for ( ; breaknum < s_break_count && s_breaks[breaknum] == frame; breaknum++)
+		{
+			left.restart();
+			right.restart();
+		}
+		check_frames(left, right, &s_capture[frame * 2], 1);
+	}
+
+	printf("dummy driver: %d callbacks, %d frames captured, %d steps checked, %d overflows, %d underflows\n",
+			s_callbacks, s_captured, left.checked(), s_ring.overflows(), s_ring.underflows());
+	s_ring.release();
+
+	if (s_callbacks == 0)
+	{
+		fprintf(stderr, "dummy driver: the audio callback never ran\n");
+		return false;
+	}
+	return left.errors() == 0 && right.errors() == 0;
+}
+
+
+//-------------------------------------------------
+//  main - run both passes
+//-------------------------------------------------
+
+#ifdef SDLMAME_WIN32
+int utf8_main(int argc, char *argv[])
+#else
+int main(int argc, char *argv[])
+#endif
+{
+	bool success = test_drained();
+	success = test_dummy_driver() && success;
+
+	if (success)
+		printf("All tests finished successfully\n");
+	return success ? 0 : 1;
+}
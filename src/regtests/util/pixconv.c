@@ -0,0 +1,616 @@
+// license:BSD-3-Clause
+// copyright-holders:Aaron Giles
+/***************************************************************************
+
+    PNG and AVI pixel conversion regression test
+
+    Runs the vectorized PNG unfilters and the AVI/PNG pixel packers over
+    random images of awkward widths, and checks the results against
+    straightforward byte-at-a-time versions of the same operations.
+    The SSE2 and plain forms of the shared row kernels must also agree.
+
+    With -bench, also times the SSE2 form of each row kernel against the
+    plain form and prints the throughput of both.
+
+****************************************************************************/
+
+#include "osdcore.h"
+#include "corefile.h"
+#include "bitmap.h"
+#include "png.h"
+#include "aviio.h"
+#include "pixrow.h"
+#include <zlib.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// image widths to try; chosen to land on either side of the 4-pixel and
+// 16-byte blocks the fast paths work in
+static const UINT32 s_widths[] = { 1, 2, 3, 4, 5, 7, 8, 15, 16, 17, 31, 33, 100, 641 };
+
+// PNG pixel layouts to try, as (color type, bit depth) pairs: gray, gray
+// with alpha, RGB, RGBA and 16-bit RGB give 1, 2, 3, 4 and 6 byte pixels
+static const UINT8 s_pngformats[][2] =
+{
+	{ 0, 8 },
+	{ 4, 8 },
+	{ 2, 8 },
+	{ 6, 8 },
+	{ 2, 16 },
+};
+
+// rows per test image; enough for every filter type to follow every other
+static const UINT32 IMAGE_HEIGHT = 26;
+
+// row kernel benchmark: row width in pixels, and bytes run through each form
+static const int BENCH_WIDTH = 640;
+static const UINT32 BENCH_BYTES = 64 * 1024 * 1024;
+
+// PNG filter types
+enum
+{
+	FILTER_NONE = 0,
+	FILTER_SUB,
+	FILTER_UP,
+	FILTER_AVERAGE,
+	FILTER_PAETH,
+	FILTER_COUNT
+};
+
+
+
+//**************************************************************************
+//  ROW KERNELS
+//**************************************************************************
+
+// a row kernel taking a source row and the row above, and writing dest
+typedef void (*row_func)(UINT8 *dest, const UINT8 *source, const UINT8 *above, int width);
+
+struct row_kernel
+{
+	const char *    name;
+	int             bpp;
+	row_func        sse2;
+	row_func        plain;
+};
+
+
+namespace pixrow_kernels
+{
+
+template<bool _UseSSE2>
+static void unfilter_up(UINT8 *dest, const UINT8 *source, const UINT8 *above, int width)
+{
+	pixel_row<_UseSSE2>::unfilter_up(source, dest, above, width);
+}
+
+template<bool _UseSSE2>
+static void unfilter_paeth3(UINT8 *dest, const UINT8 *source, const UINT8 *above, int width)
+{
+	pixel_row<_UseSSE2>::unfilter_paeth(source, dest, above, 3, width * 3);
+}
+
+template<bool _UseSSE2>
+static void unfilter_paeth4(UINT8 *dest, const UINT8 *source, const UINT8 *above, int width)
+{
+	pixel_row<_UseSSE2>::unfilter_paeth(source, dest, above, 4, width * 4);
+}
+
+template<bool _UseSSE2>
+static void swap_yuy16(UINT8 *dest, const UINT8 *source, const UINT8 *above, int width)
+{
+	pixel_row<_UseSSE2>::swap_yuy16(reinterpret_cast<UINT16 *>(dest), reinterpret_cast<const UINT16 *>(source), width);
+}
+
+template<bool _UseSSE2>
+static void add_yuy16(UINT8 *dest, const UINT8 *source, const UINT8 *above, int width)
+{
+	memcpy(dest, source, width * 2);
+	pixel_row<_UseSSE2>::add_yuy16(reinterpret_cast<UINT16 *>(dest), reinterpret_cast<const UINT16 *>(above), width);
+}
+
+}
+
+#define ROW_KERNEL(NAME, BPP) { #NAME, BPP, pixrow_kernels::NAME<true>, pixrow_kernels::NAME<false> }
+
+static const row_kernel s_kernels[] =
+{
+	ROW_KERNEL(unfilter_up, 1),
+	ROW_KERNEL(unfilter_paeth3, 3),
+	ROW_KERNEL(unfilter_paeth4, 4),
+	ROW_KERNEL(swap_yuy16, 2),
+	ROW_KERNEL(add_yuy16, 2),
+};
+
+
+
+//**************************************************************************
+//  IMPLEMENTATION
+//**************************************************************************
+
+//-------------------------------------------------
+//  random_byte - return a pseudo-random byte;
+//  every fourth row sticks to a handful of values
+//  so that Paeth hits its ties and wraparounds
+//-------------------------------------------------
+
+static UINT32 s_seed = 12345;
+
+static UINT8 random_byte(bool extremes)
+{
+	static const UINT8 s_extremes[] = { 0x00, 0x01, 0x7f, 0x80, 0xfe, 0xff };
+
+	s_seed = s_seed * 1103515245 + 12345;
+	UINT8 result = s_seed >> 16;
+	return extremes ? s_extremes[result % ARRAY_LENGTH(s_extremes)] : result;
+}
+
+
+//-------------------------------------------------
+//  paeth_predict - the Paeth predictor as written
+//  in the PNG specification
+//-------------------------------------------------
+
+static UINT8 paeth_predict(int a, int b, int c)
+{
+	int p = a + b - c;
+	int pa = abs(p - a);
+	int pb = abs(p - b);
+	int pc = abs(p - c);
+	if (pa <= pb && pa <= pc)
+		return a;
+	if (pb <= pc)
+		return b;
+	return c;
+}
+
+
+//-------------------------------------------------
+//  filter_row - apply a PNG filter to one row,
+//  writing the filter type byte followed by the
+//  filtered data
+//-------------------------------------------------
+
+static void filter_row(int type, const UINT8 *row, const UINT8 *prev, int bpp, int rowbytes, UINT8 *dest)
+{
+	*dest++ = type;
+	for (int x = 0; x < rowbytes; x++)
+	{
+		int a = (x >= bpp) ? row[x - bpp] : 0;
+		int b = (prev != NULL) ? prev[x] : 0;
+		int c = (prev != NULL && x >= bpp) ? prev[x - bpp] : 0;
+		int pred = 0;
+
+		switch (type)
+		{
+			case FILTER_SUB:        pred = a;                       break;
+			case FILTER_UP:         pred = b;                       break;
+			case FILTER_AVERAGE:    pred = (a + b) / 2;             break;
+			case FILTER_PAETH:      pred = paeth_predict(a, b, c);  break;
+		}
+		*dest++ = row[x] - pred;
+	}
+}
+
+
+//-------------------------------------------------
+//  append_bytes - append raw bytes to a buffer
+//-------------------------------------------------
+
+static void append_bytes(dynamic_buffer &buffer, const void *data, UINT32 length)
+{
+	int offset = buffer.count();
+	buffer.resize(offset + length, true);
+	if (length != 0)
+		memcpy(&buffer[offset], data, length);
+}
+
+
+//-------------------------------------------------
+//  put_chunk - append a PNG chunk to a buffer
+//-------------------------------------------------
+
+static void put_chunk(dynamic_buffer &file, const char *type, const UINT8 *data, UINT32 length)
+{
+	UINT8 header[8] = { UINT8(length >> 24), UINT8(length >> 16), UINT8(length >> 8), UINT8(length), UINT8(type[0]), UINT8(type[1]), UINT8(type[2]), UINT8(type[3]) };
+	UINT32 crc = crc32(crc32(0, &header[4], 4), data, length);
+	UINT8 trailer[4] = { UINT8(crc >> 24), UINT8(crc >> 16), UINT8(crc >> 8), UINT8(crc) };
+
+	append_bytes(file, header, 8);
+	append_bytes(file, data, length);
+	append_bytes(file, trailer, 4);
+}
+
+
+//-------------------------------------------------
+//  check_png_unfilter - build a PNG whose rows use
+//  every filter type, then make sure it decodes
+//  back to the original pixels
+//-------------------------------------------------
+
+static bool check_png_unfilter(UINT32 width, UINT8 colortype, UINT8 bitdepth)
+{
+	static const UINT8 s_signature[8] = { 0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a };
+	static const int s_samples[] = { 1, 0, 3, 1, 2, 0, 4 };
+
+	int bpp = s_samples[colortype] * bitdepth / 8;
+	int rowbytes = width * bpp;
+
+	// random source image, and its filtered form with the filter cycling
+	// at a rate that does not divide the height, so each type follows each
+	dynamic_buffer image(IMAGE_HEIGHT * rowbytes);
+	dynamic_buffer filtered(IMAGE_HEIGHT * (rowbytes + 1));
+	for (UINT32 y = 0; y < IMAGE_HEIGHT; y++)
+	{
+		for (int x = 0; x < rowbytes; x++)
+			image[y * rowbytes + x] = random_byte(y % 4 == 3);
+		filter_row((y + y / FILTER_COUNT) % FILTER_COUNT, &image[y * rowbytes], (y == 0) ? NULL : &image[(y - 1) * rowbytes], bpp, rowbytes, &filtered[y * (rowbytes + 1)]);
+	}
+
+	// compress it and wrap it in a minimal PNG
+	uLongf complength = compressBound(filtered.count());
+	dynamic_buffer compressed(complength);
+	if (compress(compressed, &complength, filtered, filtered.count()) != Z_OK)
+	{
+		fprintf(stderr, "unable to compress %d byte image\n", filtered.count());
+		return false;
+	}
+	UINT8 ihdr[13] = { UINT8(width >> 24), UINT8(width >> 16), UINT8(width >> 8), UINT8(width), 0, 0, 0, UINT8(IMAGE_HEIGHT), bitdepth, colortype, 0, 0, 0 };
+	dynamic_buffer file;
+	append_bytes(file, s_signature, 8);
+	put_chunk(file, "IHDR", ihdr, sizeof(ihdr));
+	put_chunk(file, "IDAT", compressed, complength);
+	put_chunk(file, "IEND", NULL, 0);
+
+	// decode it
+	core_file *fp;
+	if (core_fopen_ram(file, file.count(), OPEN_FLAG_READ, &fp) != FILERR_NONE)
+		return false;
+	png_info pnginfo;
+	png_error pngerr = png_read_file(fp, &pnginfo);
+	core_fclose(fp);
+	if (pngerr != PNGERR_NONE)
+	{
+		fprintf(stderr, "width %d, color type %d, depth %d: unable to decode PNG (error %d)\n", width, colortype, bitdepth, pngerr);
+		return false;
+	}
+
+	// the unfiltered rows are packed together at the start of the image
+	bool success = true;
+	for (UINT32 y = 0; y < IMAGE_HEIGHT; y++)
+		if (memcmp(&pnginfo.image[y * rowbytes], &image[y * rowbytes], rowbytes) != 0)
+		{
+			fprintf(stderr, "width %d, color type %d, depth %d: row %d (filter %d) mismatch\n", width, colortype, bitdepth, y, (y + y / FILTER_COUNT) % FILTER_COUNT);
+			success = false;
+		}
+	png_free(&pnginfo);
+	return success;
+}
+
+
+//-------------------------------------------------
+//  check_png_rgb32 - write an RGB32 bitmap out as
+//  a PNG and make sure it reads back the same
+//-------------------------------------------------
+
+static bool check_png_rgb32(UINT32 width, const char *filename)
+{
+	bitmap_rgb32 bitmap(width, IMAGE_HEIGHT);
+	for (UINT32 y = 0; y < IMAGE_HEIGHT; y++)
+		for (UINT32 x = 0; x < width; x++)
+			bitmap.pix32(y, x) = (random_byte(false) << 24) | (random_byte(false) << 16) | (random_byte(false) << 8) | random_byte(false);
+
+	// write it
+	core_file *fp;
+	if (core_fopen(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, &fp) != FILERR_NONE)
+	{
+		fprintf(stderr, "unable to create %s\n", filename);
+		return false;
+	}
+	png_info pnginfo = { 0 };
+	png_error pngerr = png_write_bitmap(fp, &pnginfo, bitmap, 0, NULL);
+	core_fclose(fp);
+	png_free(&pnginfo);
+	if (pngerr != PNGERR_NONE)
+	{
+		fprintf(stderr, "width %d: unable to write PNG (error %d)\n", width, pngerr);
+		return false;
+	}
+
+	// read it back
+	bitmap_argb32 readback;
+	if (core_fopen(filename, OPEN_FLAG_READ, &fp) != FILERR_NONE)
+		return false;
+	pngerr = png_read_bitmap(fp, readback);
+	core_fclose(fp);
+	if (pngerr != PNGERR_NONE)
+	{
+		fprintf(stderr, "width %d: unable to read PNG back (error %d)\n", width, pngerr);
+		return false;
+	}
+
+	// the alpha channel is dropped on the way out
+	for (UINT32 y = 0; y < IMAGE_HEIGHT; y++)
+		for (UINT32 x = 0; x < width; x++)
+			if ((readback.pix32(y, x) & 0xffffff) != (bitmap.pix32(y, x) & 0xffffff))
+			{
+				fprintf(stderr, "width %d: PNG pixel (%d,%d) is %06X, expected %06X\n", width, x, y, readback.pix32(y, x) & 0xffffff, bitmap.pix32(y, x) & 0xffffff);
+				return false;
+			}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  find_avi_frame - locate the first video frame
+//  in an AVI file by its chunk ID and length
+//-------------------------------------------------
+
+static const UINT8 *find_avi_frame(const dynamic_buffer &file, const char *chunkid, UINT32 length)
+{
+	for (UINT32 offs = 0; offs + 8 + length <= file.count(); offs++)
+		if (memcmp(&file[offs], chunkid, 4) == 0 && (file[offs + 4] | (file[offs + 5] << 8) | (file[offs + 6] << 16) | (file[offs + 7] << 24)) == length)
+			return &file[offs + 8];
+	return NULL;
+}
+
+
+//-------------------------------------------------
+//  write_avi_frame - write a one-frame AVI and
+//  load it back in
+//-------------------------------------------------
+
+template<class _BitmapType>
+static bool write_avi_frame(const char *filename, UINT32 format, UINT32 depth, _BitmapType &bitmap, dynamic_buffer &file)
+{
+	avi_movie_info info = { 0 };
+	info.video_format = format;
+	info.video_timescale = 60;
+	info.video_sampletime = 1;
+	info.video_width = bitmap.width();
+	info.video_height = bitmap.height();
+	info.video_depth = depth;
+	info.audio_samplebits = 16;
+
+	avi_file *avi;
+	avi_error avierr = avi_create(filename, &info, &avi);
+	if (avierr == AVIERR_NONE)
+	{
+		avierr = avi_append_video_frame(avi, bitmap);
+		avi_close(avi);
+	}
+	if (avierr != AVIERR_NONE)
+	{
+		fprintf(stderr, "width %d: unable to write AVI: %s\n", bitmap.width(), avi_error_string(avierr));
+		return false;
+	}
+	return core_fload(filename, file) == FILERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  check_avi_rgb32 - make sure an RGB32 frame is
+//  stored as bottom-up BGR triplets
+//-------------------------------------------------
+
+static bool check_avi_rgb32(UINT32 width, const char *filename)
+{
+	bitmap_rgb32 bitmap(width, IMAGE_HEIGHT);
+	for (UINT32 y = 0; y < IMAGE_HEIGHT; y++)
+		for (UINT32 x = 0; x < width; x++)
+			bitmap.pix32(y, x) = (random_byte(false) << 24) | (random_byte(false) << 16) | (random_byte(false) << 8) | random_byte(false);
+
+	dynamic_buffer file;
+	if (!write_avi_frame(filename, 0, 24, bitmap, file))
+		return false;
+	const UINT8 *frame = find_avi_frame(file, "00db", width * IMAGE_HEIGHT * 3);
+	if (frame == NULL)
+	{
+		fprintf(stderr, "width %d: no RGB frame found in AVI\n", width);
+		return false;
+	}
+
+	for (UINT32 y = 0; y < IMAGE_HEIGHT; y++)
+	{
+		const UINT8 *row = &frame[(IMAGE_HEIGHT - 1 - y) * width * 3];
+		for (UINT32 x = 0; x < width; x++)
+		{
+			UINT32 pix = bitmap.pix32(y, x);
+			if (row[x * 3 + 0] != RGB_BLUE(pix) || row[x * 3 + 1] != RGB_GREEN(pix) || row[x * 3 + 2] != RGB_RED(pix))
+			{
+				fprintf(stderr, "width %d: AVI pixel (%d,%d) is %02X%02X%02X, expected %06X\n", width, x, y, row[x * 3 + 2], row[x * 3 + 1], row[x * 3 + 0], pix & 0xffffff);
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  check_avi_yuy2 - make sure a YUY16 frame is
+//  byte swapped into a YUY2 AVI, and swapped back
+//  when read
+//-------------------------------------------------
+
+static bool check_avi_yuy2(UINT32 width, const char *filename)
+{
+	bitmap_yuy16 bitmap(width, IMAGE_HEIGHT);
+	for (UINT32 y = 0; y < IMAGE_HEIGHT; y++)
+		for (UINT32 x = 0; x < width; x++)
+			bitmap.pix16(y, x) = (random_byte(false) << 8) | random_byte(false);
+
+	dynamic_buffer file;
+	if (!write_avi_frame(filename, FORMAT_YUY2, 16, bitmap, file))
+		return false;
+	const UINT8 *frame = find_avi_frame(file, "00dc", width * IMAGE_HEIGHT * 2);
+	if (frame == NULL)
+	{
+		fprintf(stderr, "width %d: no YUY2 frame found in AVI\n", width);
+		return false;
+	}
+
+	// stored form
+	for (UINT32 y = 0; y < IMAGE_HEIGHT; y++)
+		for (UINT32 x = 0; x < width; x++)
+		{
+			UINT16 pix = bitmap.pix16(y, x);
+			UINT16 expected = (pix >> 8) | (pix << 8);
+			UINT16 stored;
+			memcpy(&stored, &frame[(y * width + x) * 2], 2);
+			if (stored != expected)
+			{
+				fprintf(stderr, "width %d: stored YUY2 pixel (%d,%d) is %04X, expected %04X\n", width, x, y, stored, expected);
+				return false;
+			}
+		}
+
+	// and read back
+	avi_file *avi;
+	avi_error avierr = avi_open(filename, &avi);
+	if (avierr != AVIERR_NONE)
+	{
+		fprintf(stderr, "width %d: unable to reopen AVI: %s\n", width, avi_error_string(avierr));
+		return false;
+	}
+	bitmap_yuy16 readback(width, IMAGE_HEIGHT);
+	avierr = avi_read_video_frame(avi, 0, readback);
+	avi_close(avi);
+	if (avierr != AVIERR_NONE)
+	{
+		fprintf(stderr, "width %d: unable to read AVI frame: %s\n", width, avi_error_string(avierr));
+		return false;
+	}
+	for (UINT32 y = 0; y < IMAGE_HEIGHT; y++)
+		for (UINT32 x = 0; x < width; x++)
+			if (readback.pix16(y, x) != bitmap.pix16(y, x))
+			{
+				fprintf(stderr, "width %d: YUY2 pixel (%d,%d) read back as %04X, expected %04X\n", width, x, y, readback.pix16(y, x), bitmap.pix16(y, x));
+				return false;
+			}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  check_row_kernel - make sure the SSE2 and plain
+//  forms of a row kernel agree, and neither writes
+//  past the end of the row
+//-------------------------------------------------
+
+static bool check_row_kernel(const row_kernel &kernel, UINT32 width)
+{
+	int rowbytes = width * kernel.bpp;
+	dynamic_buffer source(rowbytes), above(rowbytes), sse2(rowbytes + 16), plain(rowbytes + 16);
+	for (int x = 0; x < rowbytes; x++)
+	{
+		source[x] = random_byte(x % 7 == 0);
+		above[x] = random_byte(x % 5 == 0);
+	}
+	for (int x = 0; x < rowbytes + 16; x++)
+		sse2[x] = plain[x] = random_byte(false);
+
+	(*kernel.sse2)(sse2, source, above, width);
+	(*kernel.plain)(plain, source, above, width);
+	for (int x = 0; x < rowbytes + 16; x++)
+		if (sse2[x] != plain[x])
+		{
+			fprintf(stderr, "%s, width %d: byte %d is %02X with SSE2, %02X without\n", kernel.name, width, x, sse2[x], plain[x]);
+			return false;
+		}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  time_row_func - return how many seconds one
+//  form of a row kernel takes to get through
+//  BENCH_BYTES
+//-------------------------------------------------
+
+static double time_row_func(row_func func, int bpp, UINT8 *dest, const UINT8 *source, const UINT8 *above)
+{
+	int iterations = BENCH_BYTES / (BENCH_WIDTH * bpp);
+	osd_ticks_t start = osd_ticks();
+	for (int iter = 0; iter < iterations; iter++)
+		(*func)(dest, source, above, BENCH_WIDTH);
+	return double(osd_ticks() - start) / double(osd_ticks_per_second());
+}
+
+
+//-------------------------------------------------
+//  bench_row_kernels - time each row kernel's SSE2
+//  form against its plain form
+//-------------------------------------------------
+
+static void bench_row_kernels()
+{
+#ifndef __SSE2__
+	printf("SSE2 is not enabled in this build; both forms run the plain loops\n");
+#endif
+
+	dynamic_buffer source(BENCH_WIDTH * 4), above(BENCH_WIDTH * 4), dest(BENCH_WIDTH * 4);
+	for (int x = 0; x < BENCH_WIDTH * 4; x++)
+	{
+		source[x] = random_byte(false);
+		above[x] = random_byte(false);
+	}
+
+	printf("%-16s %10s %10s %8s\n", "kernel", "SSE2 MB/s", "plain MB/s", "speedup");
+	for (int kernnum = 0; kernnum < ARRAY_LENGTH(s_kernels); kernnum++)
+	{
+		const row_kernel &kernel = s_kernels[kernnum];
+		double sse2 = time_row_func(kernel.sse2, kernel.bpp, dest, source, above);
+		double plain = time_row_func(kernel.plain, kernel.bpp, dest, source, above);
+		double megabytes = double(BENCH_BYTES) / (1024.0 * 1024.0);
+		printf("%-16s %10.0f %10.0f %7.2fx\n", kernel.name,
+				(sse2 > 0) ? megabytes / sse2 : 0.0, (plain > 0) ? megabytes / plain : 0.0, (sse2 > 0) ? plain / sse2 : 0.0);
+	}
+}
+
+
+//-------------------------------------------------
+//  main - main entry point
+//-------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: pixconv <scratch directory> [-bench]\n");
+		return 1;
+	}
+
+	astring pngname(argv[1], PATH_SEPARATOR "pixconv.png");
+	astring aviname(argv[1], PATH_SEPARATOR "pixconv.avi");
+	bool success = true;
+
+	for (int widthnum = 0; widthnum < ARRAY_LENGTH(s_widths); widthnum++)
+	{
+		UINT32 width = s_widths[widthnum];
+		for (int formatnum = 0; formatnum < ARRAY_LENGTH(s_pngformats); formatnum++)
+			success &= check_png_unfilter(width, s_pngformats[formatnum][0], s_pngformats[formatnum][1]);
+		success &= check_png_rgb32(width, pngname);
+		success &= check_avi_rgb32(width, aviname);
+		success &= check_avi_yuy2(width, aviname);
+		for (int kernnum = 0; kernnum < ARRAY_LENGTH(s_kernels); kernnum++)
+			success &= check_row_kernel(s_kernels[kernnum], width);
+	}
+
+	osd_rmfile(pngname);
+	osd_rmfile(aviname);
+
+	if (argc > 2 && strcmp(argv[2], "-bench") == 0)
+		bench_row_kernels();
+
+	if (success)
+		printf("All tests finished successfully\n");
+	return success ? 0 : 1;
+}
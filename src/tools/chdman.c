@@ -177,6 +177,209 @@ private:
 };
 
 
+// ======================> chd_parallel_reader
+
+// reads a CHD sequentially while decompressing the hunks ahead of the
+// reader across all processors; chd_file isn't thread-safe, so each
+// worker thread opens its own copy of the CHD and its parent
+class chd_parallel_reader
+{
+	// a hunk being decompressed or waiting to be consumed
+	struct hunk_slot
+	{
+		chd_parallel_reader *m_reader;          // pointer back to the reader
+		osd_work_item *     m_osd;              // OSD work item decompressing this hunk
+		UINT32              m_hunknum;          // number of the hunk in this slot
+		UINT8 *             m_data;             // decompressed data
+		chd_error           m_err;              // result of the decompression
+	};
+
+	// a private copy of the CHD for one thread
+	struct instance
+	{
+		instance() : m_opened(false), m_err(CHDERR_NONE), m_bytes(0), m_ticks(0) { }
+
+		chd_file            m_chd;              // our copy of the CHD
+		chd_file            m_parent;           // our copy of its parent
+		bool                m_opened;           // have we tried to open it yet?
+		chd_error           m_err;              // result of opening it
+		UINT64              m_bytes;            // bytes decompressed
+		osd_ticks_t         m_ticks;            // time spent decompressing
+	};
+
+	// worker thread IDs run from 0 to WORK_MAX_THREADS inclusive (the last being
+	// a waiting thread helping out), so inline work uses the instance after that
+	static const int SPARE_INSTANCE = WORK_MAX_THREADS + 1;
+
+public:
+	// construction/destruction
+	chd_parallel_reader(chd_file &chd, const parameters_t &params)
+		: m_chd(chd),
+			m_filename(*params.find(OPTION_INPUT)),
+			m_parentname((params.find(OPTION_INPUT_PARENT) != NULL) ? params.find(OPTION_INPUT_PARENT)->cstr() : ""),
+			m_slots(MAX(TEMP_BUFFER_SIZE / chd.hunk_bytes(), 4)),
+			m_buffer(m_slots * chd.hunk_bytes()),
+			m_slot_array(m_slots),
+			m_first(0),
+			m_next(0),
+			m_queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI))
+	{
+		for (int slotnum = 0; slotnum < m_slots; slotnum++)
+		{
+			hunk_slot &slot = m_slot_array[slotnum];
+			slot.m_reader = this;
+			slot.m_osd = NULL;
+			slot.m_data = m_buffer + slotnum * chd.hunk_bytes();
+			slot.m_err = CHDERR_NONE;
+		}
+	}
+
+	~chd_parallel_reader()
+	{
+		flush();
+		if (m_queue != NULL)
+			osd_work_queue_free(m_queue);
+	}
+
+	// getters
+	chd_file &chd() const { return m_chd; }
+	UINT64 bytes() const
+	{
+		UINT64 total = 0;
+		for (int index = 0; index < ARRAY_LENGTH(m_instance); index++)
+			total += m_instance[index].m_bytes;
+		return total;
+	}
+	osd_ticks_t ticks() const
+	{
+		osd_ticks_t total = 0;
+		for (int index = 0; index < ARRAY_LENGTH(m_instance); index++)
+			total += m_instance[index].m_ticks;
+		return total;
+	}
+
+	// read interface; same semantics as chd_file::read_bytes
+	chd_error read_bytes(UINT64 offset, void *buffer, UINT32 bytes)
+	{
+		UINT8 *dest = reinterpret_cast<UINT8 *>(buffer);
+		UINT32 hunkbytes = m_chd.hunk_bytes();
+		while (bytes > 0)
+		{
+			// wait for the hunk containing this offset
+			hunk_slot &slot = wait_hunk(offset / hunkbytes);
+			if (slot.m_err != CHDERR_NONE)
+				return slot.m_err;
+
+			// copy out what we can
+			UINT32 hunkoffs = offset % hunkbytes;
+			UINT32 chunk = MIN(bytes, hunkbytes - hunkoffs);
+			memcpy(dest, slot.m_data + hunkoffs, chunk);
+			offset += chunk;
+			dest += chunk;
+			bytes -= chunk;
+		}
+		return CHDERR_NONE;
+	}
+
+private:
+	// return the slot for a hunk, waiting for it to finish decompressing
+	hunk_slot &wait_hunk(UINT32 hunknum)
+	{
+		// if it isn't in flight or already done, start over from there
+		if (hunknum < m_first || hunknum >= m_next)
+		{
+			flush();
+			m_first = m_next = hunknum;
+		}
+
+		// retire anything the caller has moved past
+		while (m_first < hunknum)
+			retire(m_slot_array[m_first++ % m_slots]);
+
+		// keep the pipeline full
+		while (m_next < m_chd.hunk_count() && m_next < m_first + m_slots)
+		{
+			hunk_slot &slot = m_slot_array[m_next % m_slots];
+			slot.m_hunknum = m_next++;
+			slot.m_err = CHDERR_NONE;
+			slot.m_osd = osd_work_item_queue(m_queue, decompress_static, &slot, 0);
+
+			// if the OSD couldn't queue it, do it ourselves on the spare instance
+			if (slot.m_osd == NULL)
+				decompress(slot, SPARE_INSTANCE);
+		}
+
+		// wait for this one
+		hunk_slot &slot = m_slot_array[hunknum % m_slots];
+		retire(slot);
+		return slot;
+	}
+
+	// wait for a slot's work item and release it
+	void retire(hunk_slot &slot)
+	{
+		if (slot.m_osd != NULL)
+		{
+			osd_work_item_wait(slot.m_osd, 100 * osd_ticks_per_second());
+			osd_work_item_release(slot.m_osd);
+			slot.m_osd = NULL;
+		}
+	}
+
+	// wait for everything in flight
+	void flush()
+	{
+		for ( ; m_first < m_next; m_first++)
+			retire(m_slot_array[m_first % m_slots]);
+	}
+
+	// decompress a single hunk; runs on a worker thread
+	static void *decompress_static(void *param, int threadid)
+	{
+		hunk_slot &slot = *reinterpret_cast<hunk_slot *>(param);
+		slot.m_reader->decompress(slot, threadid);
+		return NULL;
+	}
+
+	void decompress(hunk_slot &slot, int threadid)
+	{
+		// open our thread's copy of the CHD the first time through
+		assert(threadid < ARRAY_LENGTH(m_instance));
+		instance &inst = m_instance[threadid];
+		if (!inst.m_opened)
+		{
+			inst.m_opened = true;
+			if (m_parentname)
+				inst.m_err = inst.m_parent.open(m_parentname);
+			if (inst.m_err == CHDERR_NONE)
+				inst.m_err = inst.m_chd.open(m_filename, false, inst.m_parent.opened() ? &inst.m_parent : NULL);
+		}
+		if (inst.m_err != CHDERR_NONE)
+		{
+			slot.m_err = inst.m_err;
+			return;
+		}
+
+		osd_ticks_t start = osd_ticks();
+		slot.m_err = inst.m_chd.read_hunk(slot.m_hunknum, slot.m_data);
+		inst.m_ticks += osd_ticks() - start;
+		inst.m_bytes += m_chd.hunk_bytes();
+	}
+
+	// internal state
+	chd_file &          m_chd;
+	astring             m_filename;
+	astring             m_parentname;
+	int                 m_slots;
+	dynamic_buffer      m_buffer;
+	dynamic_array<hunk_slot> m_slot_array;
+	UINT32              m_first;
+	UINT32              m_next;
+	osd_work_queue *    m_queue;
+	instance            m_instance[SPARE_INSTANCE + 1];
+};
+
+
 // ======================> chd_rawfile_compressor
 
 class chd_rawfile_compressor : public chd_file_compressor
@@ -214,10 +417,10 @@ class chd_chdfile_compressor : public chd_file_compressor
 {
 public:
 	// construction/destruction
-	chd_chdfile_compressor(chd_file &file, UINT64 offset = 0, UINT64 maxoffset = ~0)
+	chd_chdfile_compressor(chd_parallel_reader &file, UINT64 offset = 0, UINT64 maxoffset = ~0)
 		: m_file(file),
 			m_offset(offset),
-			m_maxoffset(MIN(maxoffset, file.logical_bytes())) { }
+			m_maxoffset(MIN(maxoffset, file.chd().logical_bytes())) { }
 
 	// read interface
 	virtual UINT32 read_data(void *dest, UINT64 offset, UINT32 length)
@@ -235,7 +438,7 @@ public:
 
 private:
 	// internal state
-	chd_file &      m_file;
+	chd_parallel_reader &m_file;
 	UINT64          m_offset;
 	UINT64          m_maxoffset;
 };
@@ -490,7 +693,7 @@ static const option_description s_options[] =
 	{ OPTION_INDEX,                 "ix",   true, " <index>: indexed instance of this metadata tag" },
 	{ OPTION_VALUE_TEXT,            "vt",   true, " <text>: text for the metadata" },
 	{ OPTION_VALUE_FILE,            "vf",   true, " <file>: file containing data to add" },
-	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression" },
+	{ OPTION_NUMPROCESSORS,         "np",   true, " <processors>: limit the number of processors to use during compression and extraction" },
 	{ OPTION_NO_CHECKSUM,           "nocs", false, ": do not include this metadata information in the overall SHA-1" },
 	{ OPTION_FIX,                   "f",    false, ": fix the SHA-1 if it is incorrect" },
 	{ OPTION_VERBOSE,               "v",    false, ": output additional information" },
@@ -510,7 +713,8 @@ static const command_description s_commands[] =
 	{ COMMAND_VERIFY, do_verify, ": verifies a CHD's integrity",
 		{
 			REQUIRED OPTION_INPUT,
-			OPTION_INPUT_PARENT
+			OPTION_INPUT_PARENT,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -585,7 +789,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -598,7 +803,8 @@ static const command_description s_commands[] =
 			OPTION_INPUT_START_BYTE,
 			OPTION_INPUT_START_HUNK,
 			OPTION_INPUT_LENGTH_BYTES,
-			OPTION_INPUT_LENGTH_HUNKS
+			OPTION_INPUT_LENGTH_HUNKS,
+			OPTION_NUMPROCESSORS
 		}
 	},
 
@@ -1112,6 +1318,19 @@ static const char *compression_string(astring &string, chd_codec_type compressio
 }
 
 
+//-------------------------------------------------
+//  report_throughput - output the throughput of
+//  one stage of a pipeline
+//-------------------------------------------------
+
+static void report_throughput(const char *stage, UINT64 bytes, osd_ticks_t ticks)
+{
+	double seconds = double(ticks) / double(osd_ticks_per_second());
+	if (seconds > 0)
+		printf("  %-24s %9.1f MB/s (%.2f s)\n", stage, double(bytes) / (1024.0 * 1024.0) / seconds, seconds);
+}
+
+
 //-------------------------------------------------
 //  compress_common - standard compression loop
 //-------------------------------------------------
@@ -1119,6 +1338,7 @@ static const char *compression_string(astring &string, chd_codec_type compressio
 static void compress_common(chd_file_compressor &chd)
 {
 	// begin compressing
+	osd_ticks_t start = osd_ticks();
 	chd.compress_begin();
 
 	// loop until done
@@ -1136,6 +1356,14 @@ static void compress_common(chd_file_compressor &chd)
 
 	// final progress update
 	progress(true, "Compression complete ... final ratio = %.1f%%            \n", 100.0 * ratio);
+
+	// report how each stage of the pipeline fared
+	printf("Throughput:\n");
+	report_throughput("Read", chd.total_in(), chd.read_ticks());
+	report_throughput("Hash", chd.total_in(), chd.hash_ticks());
+	report_throughput("Compress (per thread)", chd.total_in(), chd.codec_ticks());
+	report_throughput("Write", chd.total_out(), chd.write_ticks());
+	report_throughput("Overall", chd.total_in(), osd_ticks() - start);
 }
 
 
@@ -1456,27 +1684,41 @@ static void do_verify(parameters_t &params)
 	if (raw_sha1 == sha1_t::null)
 		report_error(0, "No verification to be done; CHD has no checksum");
 
+	// process numprocessors
+	parse_numprocessors(params);
+
 	// create an array to read into
 	dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
 
 	// read all the data and build up an SHA-1
+	chd_parallel_reader reader(input_chd, params);
 	sha1_creator rawsha1;
+	osd_ticks_t start = osd_ticks();
+	osd_ticks_t hash_ticks = 0;
 	for (UINT64 offset = 0; offset < input_chd.logical_bytes(); )
 	{
 		progress(false, "Verifying, %.1f%% complete... \r", 100.0 * double(offset) / double(input_chd.logical_bytes()));
 
 		// determine how much to read
 		UINT32 bytes_to_read = MIN((UINT32)buffer.count(), input_chd.logical_bytes() - offset);
-		chd_error err = input_chd.read_bytes(offset, buffer, bytes_to_read);
+		chd_error err = reader.read_bytes(offset, buffer, bytes_to_read);
 		if (err != CHDERR_NONE)
 			report_error(1, "Error reading CHD file (%s): %s", params.find(OPTION_INPUT)->cstr(), chd_file::error_string(err));
 
 		// add to the checksum
+		osd_ticks_t hash_start = osd_ticks();
 		rawsha1.append(buffer, bytes_to_read);
+		hash_ticks += osd_ticks() - hash_start;
 		offset += bytes_to_read;
 	}
 	sha1_t computed_sha1 = rawsha1.finish();
 
+	// report how each stage of the pipeline fared
+	printf("Throughput:\n");
+	report_throughput("Decompress (per thread)", reader.bytes(), reader.ticks());
+	report_throughput("Hash", input_chd.logical_bytes(), hash_ticks);
+	report_throughput("Overall", input_chd.logical_bytes(), osd_ticks() - start);
+
 	// finish up
 	if (raw_sha1 != computed_sha1)
 	{
@@ -2072,11 +2314,12 @@ static void do_copy(parameters_t &params)
 	printf("Logical size: %s\n", big_int_string(tempstr, input_end - input_start));
 
 	// catch errors so we can close & delete the output file
+	chd_parallel_reader reader(input_chd, params);
 	chd_chdfile_compressor *chd = NULL;
 	try
 	{
 		// create the new CHD
-		chd = new chd_chdfile_compressor(input_chd, input_start, input_end);
+		chd = new chd_chdfile_compressor(reader, input_start, input_end);
 		chd_error err;
 		if (output_parent.opened())
 			err = chd->create(*output_chd_str, input_end - input_start, hunk_size, compression, output_parent);
@@ -2156,6 +2399,9 @@ static void do_extract_raw(parameters_t &params)
 	if (output_file_str != NULL)
 		check_existing_output_file(params, *output_file_str);
 
+	// process numprocessors
+	parse_numprocessors(params);
+
 	// print some info
 	astring tempstr;
 	printf("Output File:  %s\n", output_file_str->cstr());
@@ -2175,20 +2421,25 @@ static void do_extract_raw(parameters_t &params)
 		if (filerr != FILERR_NONE)
 			report_error(1, "Unable to open file (%s)", output_file_str->cstr());
 
-		// copy all data
+		// copy all data; hunks are decompressed ahead of us while we write
+		chd_parallel_reader reader(input_chd, params);
 		dynamic_buffer buffer((TEMP_BUFFER_SIZE / input_chd.hunk_bytes()) * input_chd.hunk_bytes());
+		osd_ticks_t start = osd_ticks();
+		osd_ticks_t write_ticks = 0;
 		for (UINT64 offset = input_start; offset < input_end; )
 		{
 			progress(false, "Extracting, %.1f%% complete... \r", 100.0 * double(offset - input_start) / double(input_end - input_start));
 
 			// determine how much to read
 			UINT32 bytes_to_read = MIN((UINT32)buffer.count(), input_end - offset);
-			chd_error err = input_chd.read_bytes(offset, buffer, bytes_to_read);
+			chd_error err = reader.read_bytes(offset, buffer, bytes_to_read);
 			if (err != CHDERR_NONE)
 				report_error(1, "Error reading CHD file (%s): %s", params.find(OPTION_INPUT)->cstr(), chd_file::error_string(err));
 
 			// write to the output
+			osd_ticks_t write_start = osd_ticks();
 			UINT32 count = core_fwrite(output_file, buffer, bytes_to_read);
+			write_ticks += osd_ticks() - write_start;
 			if (count != bytes_to_read)
 				report_error(1, "Error writing to file; check disk space (%s)", output_file_str->cstr());
 
@@ -2199,6 +2450,12 @@ static void do_extract_raw(parameters_t &params)
 		// finish up
 		core_fclose(output_file);
 		printf("Extraction complete                                    \n");
+
+		// report how each stage of the pipeline fared
+		printf("Throughput:\n");
+		report_throughput("Decompress (per thread)", reader.bytes(), reader.ticks());
+		report_throughput("Write", input_end - input_start, write_ticks);
+		report_throughput("Overall", input_end - input_start, osd_ticks() - start);
 	}
 	catch (...)
 	{